@@ -74,6 +74,12 @@ def define_options(parser):
     parser.add_option("--garnet-deadlock-threshold", action="store",
                       type="int", default=50000,
                       help="network-level deadlock threshold.")
+    parser.add_option("--garnet-partitions", action="store", type="int",
+                      default=1,
+                      help="""split the garnet routers into this many
+                            partitions, each simulated by its own thread
+                            (event queue). The rest of the system stays
+                            on event queue 0.""")
 
 
 def create_network(options, ruby):
@@ -112,6 +118,11 @@ def init_network(options, network, InterfaceClass):
     if options.network == "simple":
         network.setup_buffers()
 
+    if options.garnet_partitions > 1:
+        if options.network != "garnet2.0":
+            fatal("--garnet-partitions requires the garnet2.0 network")
+        partition_network(network, options.garnet_partitions)
+
     if InterfaceClass != None:
         netifs = [InterfaceClass(id=i) \
                   for (i,n) in enumerate(network.ext_links)]
@@ -121,3 +132,40 @@ def init_network(options, network, InterfaceClass):
         assert(options.network == "garnet2.0")
         network.enable_fault_model = True
         network.fault_model = FaultModel()
+
+def partition_network(network, num_partitions):
+    """Spread the routers of a garnet network over event queues
+
+    Routers are split into blocks of consecutive ids, which for a mesh
+    are bands of rows, and partition i runs on event queue i + 1. Each
+    link goes on the queue of the router (or network interface, which
+    stays on queue 0) that sends over it. The links crossing partitions
+    declare their latency, which the simulation uses as the quantum
+    unless Root.sim_quantum is set.
+    """
+
+    routers = network.routers
+    if num_partitions > len(routers):
+        fatal("Can't split %d routers into %d partitions" %
+              (len(routers), num_partitions))
+
+    def eventq(router):
+        return 1 + router.router_id * num_partitions // len(routers)
+
+    for router in routers:
+        router.eventq_index = eventq(router)
+
+    for link in network.int_links:
+        link.network_link.eventq_index = eventq(link.src_node)
+        link.credit_link.eventq_index = eventq(link.dst_node)
+
+    for link in network.ext_links:
+        router_eventq = eventq(link.int_node)
+        # Into the network: flits from the interface, credits from the
+        # router
+        link.network_links[0].eventq_index = 0
+        link.credit_links[0].eventq_index = router_eventq
+        # Out of the network: flits from the router, credits from the
+        # interface
+        link.network_links[1].eventq_index = router_eventq
+        link.credit_links[1].eventq_index = 0
@@ -94,6 +94,9 @@ class Decoder
     void consumeBytes(int numBytes);
 
   public: // Decoder API
+    /// Hits and misses of the decode caches, counted by decode()
+    DecodeCache::CacheStats cacheStats;
+
     Decoder(ISA* isa = nullptr);
 
     /** Reset the decoders internal state. */
@@ -194,6 +197,19 @@ class Decoder
      */
     void takeOverFrom(Decoder *old) {}
 
+    /**
+     * Identify the state of the decoder that the decoding of
+     * instructions depends on, besides the PC state, for caches of
+     * decoded instructions.
+     */
+    uint64_t
+    decodeContext() const
+    {
+        return (uint64_t)(uint32_t)fpscrLen |
+            (uint64_t)(uint32_t)fpscrStride << 16 |
+            (uint64_t)(uint32_t)sveLen << 32;
+    }
+
 
   public: // ARM-specific decoder state manipulation
     void setContext(FPSCR fpscr)
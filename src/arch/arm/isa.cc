@@ -1750,7 +1750,7 @@ ISA::setMiscReg(int misc_reg, RegVal val, ThreadContext *tc)
               warn("Translating via %s in functional mode! Fix Me!\n",
                    miscRegName[misc_reg]);
 
-              auto req = std::make_shared<Request>(
+              auto req = Request::create(
                   val, 0, flags,  Request::funcMasterId,
                   tc->pcState().pc(), tc->contextId());
 
@@ -1943,7 +1943,7 @@ ISA::setMiscReg(int misc_reg, RegVal val, ThreadContext *tc)
           case MISCREG_AT_S1E3R_Xt:
           case MISCREG_AT_S1E3W_Xt:
             {
-                RequestPtr req = std::make_shared<Request>();
+                RequestPtr req = Request::create();
                 Request::Flags flags = 0;
                 BaseTLB::Mode mode = BaseTLB::Read;
                 TLB::ArmTranslationType tranType = TLB::NormalTran;
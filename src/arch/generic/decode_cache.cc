@@ -41,15 +41,18 @@ BasicDecodeCache::decode(TheISA::Decoder *decoder,
         TheISA::ExtMachInst mach_inst, Addr addr)
 {
     StaticInstPtr &si = decodePages.lookup(addr);
-    if (si && (si->machInst == mach_inst))
+    if (si && (si->machInst == mach_inst)) {
+        decoder->cacheStats.hits++;
         return si;
+    }
 
-    auto iter = instMap.find(mach_inst);
-    if (iter != instMap.end()) {
-        si = iter->second;
+    if (const StaticInstPtr *cached = instMap.find(mach_inst)) {
+        decoder->cacheStats.hits++;
+        si = *cached;
         return si;
     }
 
+    decoder->cacheStats.misses++;
     si = decoder->decodeInst(mach_inst);
     instMap[mach_inst] = si;
     return si;
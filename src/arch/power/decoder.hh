@@ -45,6 +45,9 @@ class Decoder
     bool instDone;
 
   public:
+    /// Hits and misses of the decode caches, counted by decode()
+    DecodeCache::CacheStats cacheStats;
+
     Decoder(ISA* isa = nullptr) : instDone(false)
     {
     }
@@ -91,6 +94,9 @@ class Decoder
 
     void takeOverFrom(Decoder *old) {}
 
+    /** The decoding of instructions only depends on their bytes. */
+    uint64_t decodeContext() const { return 0; }
+
   protected:
     /// A cache of decoded instruction objects.
     static GenericISA::BasicDecodeCache defaultCache;
@@ -56,6 +56,9 @@ class Decoder
     bool instDone;
 
   public:
+    /// Hits and misses of the decode caches, counted by decode()
+    DecodeCache::CacheStats cacheStats;
+
     Decoder(ISA* isa=nullptr) { reset(); }
 
     void process() {}
@@ -71,6 +74,9 @@ class Decoder
     bool instReady() { return instDone; }
     void takeOverFrom(Decoder *old) {}
 
+    /** The decoding of instructions only depends on their bytes. */
+    uint64_t decodeContext() const { return 0; }
+
     StaticInstPtr decodeInst(ExtMachInst mach_inst);
 
     /// Decode a machine instruction.
@@ -47,6 +47,9 @@ class Decoder
     RegVal asi;
 
   public:
+    /// Hits and misses of the decode caches, counted by decode()
+    DecodeCache::CacheStats cacheStats;
+
     Decoder(ISA* isa = nullptr) : instDone(false), asi(0)
     {}
 
@@ -98,6 +101,12 @@ class Decoder
 
     void takeOverFrom(Decoder *old) {}
 
+    /**
+     * Identify the state of the decoder that the decoding of
+     * instructions depends on, for caches of decoded instructions.
+     */
+    uint64_t decodeContext() const { return asi; }
+
   protected:
     /// A cache of decoded instruction objects.
     static GenericISA::BasicDecodeCache defaultCache;
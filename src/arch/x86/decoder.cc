@@ -679,10 +679,12 @@ Decoder::InstCacheMap Decoder::instCacheMap;
 StaticInstPtr
 Decoder::decode(ExtMachInst mach_inst, Addr addr)
 {
-    auto iter = instMap->find(mach_inst);
-    if (iter != instMap->end())
-        return iter->second;
+    if (const StaticInstPtr *cached = instMap->find(mach_inst)) {
+        cacheStats.hits++;
+        return *cached;
+    }
 
+    cacheStats.misses++;
     StaticInstPtr si = decodeInst(mach_inst);
     (*instMap)[mach_inst] = si;
     return si;
@@ -697,8 +699,10 @@ Decoder::decode(PCState &nextPC)
     updateNPC(nextPC);
 
     StaticInstPtr &si = instBytes->si;
-    if (si)
+    if (si) {
+        cacheStats.hits++;
         return si;
+    }
 
     // We didn't match in the AddrMap, but we still populated an entry. Fix
     // up its byte masks.
@@ -233,6 +233,9 @@ class Decoder
     static InstCacheMap instCacheMap;
 
   public:
+    /// Hits and misses of the decode caches, counted by decode()
+    DecodeCache::CacheStats cacheStats;
+
     Decoder(ISA* isa = nullptr) : basePC(0), origPC(0), offset(0),
         outOfBytes(true), instDone(false),
         state(ResetState)
@@ -281,6 +284,19 @@ class Decoder
         }
     }
 
+    /**
+     * Identify the state of the decoder that the decoding of
+     * instructions depends on, for caches of decoded instructions.
+     */
+    uint64_t
+    decodeContext() const
+    {
+        return (uint64_t)mode | (uint64_t)submode << 8 |
+            (uint64_t)altOp << 16 | (uint64_t)defOp << 24 |
+            (uint64_t)altAddr << 32 | (uint64_t)defAddr << 40 |
+            (uint64_t)stack << 48;
+    }
+
     void takeOverFrom(Decoder *old)
     {
         mode = old->mode;
@@ -43,9 +43,9 @@
 
 #include <cstddef>
 #include <functional>
-#include <list>
 #include <map>
 #include <utility>
+#include <vector>
 
 #include "base/addr_range.hh"
 #include "base/types.hh"
@@ -54,8 +54,15 @@
  * The AddrRangeMap uses an STL map to implement an interval tree for
  * address decoding. The value stored is a template type and can be
  * e.g. a port identifier, or a pointer.
+ *
+ * The map owns the entries, and iterators to them stay valid across
+ * inserts and erases. Lookups don't walk the tree though, they use a
+ * flat index of the entries, sorted like the map, that is searched
+ * with a branch-free binary search. The index is rebuilt whenever the
+ * map changes, which is rare as the maps are mostly set up once, so
+ * lookups never write and are safe to do from several threads.
  */
-template <typename V, int max_cache_size=0>
+template <typename V>
 class AddrRangeMap
 {
   private:
@@ -65,6 +72,22 @@ class AddrRangeMap
     typedef typename RangeMap::iterator iterator;
     typedef typename RangeMap::const_iterator const_iterator;
 
+    AddrRangeMap() = default;
+
+    AddrRangeMap(const AddrRangeMap &other)
+        : tree(other.tree)
+    {
+        rebuildIndex();
+    }
+
+    AddrRangeMap &
+    operator=(const AddrRangeMap &other)
+    {
+        tree = other.tree;
+        rebuildIndex();
+        return *this;
+    }
+
     /**
      * Find entry that contains the given address range
      *
@@ -78,12 +101,12 @@ class AddrRangeMap
     const_iterator
     contains(const AddrRange &r) const
     {
-        return find(r, [r](const AddrRange r1) { return r.isSubset(r1); });
+        return find(r, [&r](const AddrRange &r1) { return r.isSubset(r1); });
     }
     iterator
     contains(const AddrRange &r)
     {
-        return find(r, [r](const AddrRange r1) { return r.isSubset(r1); });
+        return find(r, [&r](const AddrRange &r1) { return r.isSubset(r1); });
     }
 
     /**
@@ -99,12 +122,14 @@ class AddrRangeMap
     const_iterator
     contains(Addr r) const
     {
-        return contains(RangeSize(r, 1));
+        return find(RangeSize(r, 1),
+                    [r](const AddrRange &r1) { return r1.contains(r); });
     }
     iterator
     contains(Addr r)
     {
-        return contains(RangeSize(r, 1));
+        return find(RangeSize(r, 1),
+                    [r](const AddrRange &r1) { return r1.contains(r); });
     }
 
     /**
@@ -120,12 +145,12 @@ class AddrRangeMap
     const_iterator
     intersects(const AddrRange &r) const
     {
-        return find(r, [r](const AddrRange r1) { return r.intersects(r1); });
+        return find(r, [&r](const AddrRange &r1) { return r.intersects(r1); });
     }
     iterator
     intersects(const AddrRange &r)
     {
-        return find(r, [r](const AddrRange r1) { return r.intersects(r1); });
+        return find(r, [&r](const AddrRange &r1) { return r.intersects(r1); });
     }
 
     iterator
@@ -134,30 +159,30 @@ class AddrRangeMap
         if (intersects(r) != end())
             return tree.end();
 
-        return tree.insert(std::make_pair(r, d)).first;
+        iterator it = tree.insert(std::make_pair(r, d)).first;
+        rebuildIndex();
+        return it;
     }
 
     void
     erase(iterator p)
     {
-        cache.remove(p);
         tree.erase(p);
+        rebuildIndex();
     }
 
     void
     erase(iterator p, iterator q)
     {
-        for (auto it = p; it != q; it++) {
-            cache.remove(p);
-        }
         tree.erase(p,q);
+        rebuildIndex();
     }
 
     void
     clear()
     {
-        cache.erase(cache.begin(), cache.end());
         tree.erase(tree.begin(), tree.end());
+        rebuildIndex();
     }
 
     const_iterator
@@ -198,93 +223,109 @@ class AddrRangeMap
 
   private:
     /**
-     * Add an address range map entry to the cache.
-     *
-     * @param it Iterator to the entry in the address range map
+     * Rebuild the lookup index from the map.
      */
     void
-    addNewEntryToCache(iterator it) const
+    rebuildIndex()
     {
-        if (max_cache_size != 0) {
-            // If there's a cache, add this element to it.
-            if (cache.size() >= max_cache_size) {
-                // If the cache is full, move the last element to the
-                // front and overwrite it with the new value. This
-                // avoids creating or destroying elements of the list.
-                auto last = cache.end();
-                last--;
-                *last = it;
-                if (max_cache_size > 1)
-                    cache.splice(cache.begin(), cache, last);
-            } else {
-                cache.push_front(it);
-            }
+        starts.clear();
+        entries.clear();
+        starts.reserve(tree.size());
+        entries.reserve(tree.size());
+        for (auto it = tree.begin(); it != tree.end(); ++it) {
+            starts.push_back(it->first.start());
+            entries.push_back(it);
         }
     }
 
+    /**
+     * Find the number of entries that start at or below an address,
+     * i.e., the index of the first entry that starts above it.
+     *
+     * The loop has a fixed trip count for a given index size and the
+     * comparison is turned into a conditional move, so there are no
+     * hard to predict branches on the address.
+     *
+     * @param a An input address
+     * @return The index of the first entry that starts above a
+     */
+    std::size_t
+    upperBound(Addr a) const
+    {
+        std::size_t len = starts.size();
+        if (len == 0)
+            return 0;
+
+        const Addr *base = starts.data();
+        while (len > 1) {
+            const std::size_t half = len / 2;
+            base = base[half] <= a ? base + half : base;
+            len -= half;
+        }
+        return (base - starts.data()) + (*base <= a);
+    }
+
     /**
      * Find entry that satisfies a condition on an address range
      *
-     * Searches through the ranges in the address map and returns an
-     * iterator to the entry that satisfies the input conidition on
-     * the input address range. Returns end() if none found.
+     * Searches through the ranges in the address map and returns the
+     * index of the entry that satisfies the input conidition on the
+     * input address range. Returns the number of entries if none
+     * found.
      *
      * @param r An input address range
      * @param f A condition on an address range
-     * @return An iterator that contains the input address range
+     * @return The index of the entry that contains the input address range
      */
-    iterator
-    find(const AddrRange &r, std::function<bool(const AddrRange)> cond)
+    template <typename Cond>
+    std::size_t
+    findIndex(const AddrRange &r, Cond cond) const
     {
-        // Check the cache first
-        for (auto c = cache.begin(); c != cache.end(); c++) {
-            auto it = *c;
-            if (cond(it->first)) {
-                // If this entry matches, promote it to the front
-                // of the cache and return it.
-                cache.splice(cache.begin(), cache, c);
-                return it;
-            }
-        }
-
-        iterator next = tree.upper_bound(r);
-        if (next != end() && cond(next->first)) {
-            addNewEntryToCache(next);
+        std::size_t next = upperBound(r.start());
+        if (next != entries.size() && cond(entries[next]->first))
             return next;
-        }
-        if (next == begin())
-            return end();
+        if (next == 0)
+            return entries.size();
         next--;
 
-        iterator i;
+        std::size_t i;
         do {
             i = next;
-            if (cond(i->first)) {
-                addNewEntryToCache(i);
+            if (cond(entries[i]->first))
                 return i;
-            }
-            // Keep looking if the next range merges with the current one.
-        } while (next != begin() &&
-                 (--next)->first.mergesWith(i->first));
+            // Keep looking if the next range merges with the current one,
+            // i.e., for the other parts of an interleaved range.
+        } while (next != 0 &&
+                 entries[--next]->first.mergesWith(entries[i]->first));
 
-        return end();
+        return entries.size();
+    }
+
+    template <typename Cond>
+    iterator
+    find(const AddrRange &r, Cond cond)
+    {
+        std::size_t i = findIndex(r, cond);
+        return i != entries.size() ? entries[i] : end();
     }
 
+    template <typename Cond>
     const_iterator
-    find(const AddrRange &r, std::function<bool(const AddrRange)> cond) const
+    find(const AddrRange &r, Cond cond) const
     {
-        return const_cast<AddrRangeMap *>(this)->find(r, cond);
+        std::size_t i = findIndex(r, cond);
+        return i != entries.size() ? const_iterator(entries[i]) : end();
     }
 
     RangeMap tree;
 
     /**
-     * A list of iterator that correspond to the max_cache_size most
-     * recently used entries in the address range map. This mainly
-     * used to optimize lookups. The elements in the list should
-     * always be valid iterators of the tree.
+     * The lookup index: the start address of every entry in the map,
+     * in map order, and the matching iterators. The starts are kept on
+     * their own so the binary search only touches a dense array.
      */
-    mutable std::list<iterator> cache;
+    std::vector<Addr> starts;
+    std::vector<iterator> entries;
 };
 
 #endif //__BASE_ADDR_RANGE_MAP_HH__
@@ -40,6 +40,11 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "base/addr_range_map.hh"
 
 // Converted from legacy unit test framework
@@ -66,3 +71,162 @@ TEST(AddrRangeMapTest, LegacyTests)
 
     EXPECT_NE(r.contains(RangeIn(20, 30)), r.end());
 }
+
+TEST(AddrRangeMapTest, ManyRanges)
+{
+    AddrRangeMap<int> r;
+
+    // Insert out of order, with gaps between the ranges
+    for (int i = 0; i < 64; i++) {
+        const int n = (i * 37) % 64;
+        ASSERT_NE(r.insert(RangeSize(n * 0x1000, 0x800), n), r.end());
+    }
+    ASSERT_EQ(r.size(), 64);
+
+    for (int n = 0; n < 64; n++) {
+        auto i = r.contains(n * 0x1000);
+        ASSERT_NE(i, r.end());
+        EXPECT_EQ(i->second, n);
+        EXPECT_EQ(r.contains(n * 0x1000 + 0x7ff)->second, n);
+        EXPECT_EQ(r.contains(n * 0x1000 + 0x800), r.end());
+        EXPECT_EQ(r.contains(RangeSize(n * 0x1000 + 0x100, 0x100))->second,
+                  n);
+        EXPECT_EQ(r.contains(RangeSize(n * 0x1000 + 0x700, 0x200)),
+                  r.end());
+        if (n > 0) {
+            EXPECT_EQ(r.intersects(RangeSize(n * 0x1000 - 0x100, 0x200))
+                      ->second, n);
+        }
+    }
+    EXPECT_EQ(r.contains(64 * 0x1000), r.end());
+}
+
+TEST(AddrRangeMapTest, EraseAndInsert)
+{
+    AddrRangeMap<int> r;
+
+    for (int n = 0; n < 8; n++)
+        r.insert(RangeSize(n * 0x100, 0x100), n);
+
+    r.erase(r.contains(0x300));
+    EXPECT_EQ(r.contains(0x300), r.end());
+    EXPECT_EQ(r.contains(0x400)->second, 4);
+
+    ASSERT_NE(r.insert(RangeSize(0x300, 0x80), 9), r.end());
+    EXPECT_EQ(r.contains(0x300)->second, 9);
+    EXPECT_EQ(r.contains(0x380), r.end());
+
+    r.clear();
+    EXPECT_TRUE(r.empty());
+    EXPECT_EQ(r.contains(0x0), r.end());
+}
+
+TEST(AddrRangeMapTest, InterleavedRanges)
+{
+    AddrRangeMap<int> r;
+
+    // Four ways interleaved on bits 7:6, and a plain range after them
+    for (int match = 0; match < 4; match++)
+        ASSERT_NE(r.insert(AddrRange(0x0, 0x10000, 7, 0, 2, match), match),
+                  r.end());
+    ASSERT_NE(r.insert(RangeSize(0x10000, 0x1000), 4), r.end());
+
+    // The same chunk can't be added twice
+    EXPECT_EQ(r.insert(AddrRange(0x0, 0x10000, 7, 0, 2, 2), 5), r.end());
+
+    for (Addr a = 0; a < 0x10000; a += 0x20)
+        EXPECT_EQ(r.contains(a)->second, (a >> 6) & 0x3);
+    EXPECT_EQ(r.contains(RangeSize(0x1c0, 0x40))->second, 3);
+    EXPECT_EQ(r.contains(RangeSize(0x1c0, 0x80)), r.end());
+    EXPECT_EQ(r.contains(0x10000)->second, 4);
+}
+
+TEST(AddrRangeMapTest, CopyHasItsOwnIndex)
+{
+    AddrRangeMap<int> r;
+    for (int n = 0; n < 8; n++)
+        ASSERT_NE(r.insert(RangeSize(Addr(n) << 12, 0x1000), n), r.end());
+
+    AddrRangeMap<int> copy(r);
+    r.erase(r.contains(0x3000));
+    r.insert(RangeSize(0x3000, 0x800), 10);
+
+    ASSERT_EQ(copy.size(), 8);
+    for (int n = 0; n < 8; n++) {
+        auto it = copy.contains(Addr(n) << 12);
+        ASSERT_NE(it, copy.end());
+        EXPECT_EQ(it->second, n);
+        EXPECT_EQ(it->first, RangeSize(Addr(n) << 12, 0x1000));
+    }
+    EXPECT_EQ(r.contains(0x3000)->second, 10);
+    EXPECT_EQ(r.contains(0x3800), r.end());
+
+    copy = r;
+    EXPECT_EQ(copy.contains(0x3000)->second, 10);
+    EXPECT_EQ(copy.contains(0x3800), copy.end());
+}
+
+TEST(AddrRangeMapTest, ConstLookupsFromThreads)
+{
+    AddrRangeMap<int> r;
+    for (int n = 0; n < 64; n++)
+        r.insert(RangeSize(Addr(n) << 12, 0x800), n);
+    const AddrRangeMap<int> &cr = r;
+
+    const int num_threads = 4;
+    std::vector<int> mismatches(num_threads, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&cr, &mismatches, t]() {
+            for (Addr a = 0; a < (Addr(64) << 12); a += 0x100) {
+                auto it = cr.contains(a);
+                bool expect_hit = (a & 0x800) == 0;
+                if ((it != cr.end()) != expect_hit ||
+                    (expect_hit && it->second != int(a >> 12))) {
+                    mismatches[t]++;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    for (int m : mismatches)
+        EXPECT_EQ(m, 0);
+}
+
+/**
+ * Not a pass/fail test: time lookups of random addresses in maps of
+ * 8 to 256 ranges and record the lookup rate as a test property.
+ */
+TEST(AddrRangeMapTest, LookupThroughput)
+{
+    const int lookups = 1 << 20;
+
+    for (int ranges = 8; ranges <= 256; ranges *= 2) {
+        AddrRangeMap<int> r;
+        for (int n = 0; n < ranges; n++)
+            r.insert(RangeSize(Addr(n) << 20, 1 << 19), n);
+
+        std::vector<Addr> addrs(1024);
+        uint64_t x = 88172645463325252ULL;
+        for (auto &a : addrs) {
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            a = x % (Addr(ranges) << 20);
+        }
+
+        int found = 0;
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < lookups; i++)
+            found += r.contains(addrs[i % addrs.size()]) != r.end();
+        auto end = std::chrono::steady_clock::now();
+
+        double secs = std::chrono::duration<double>(end - begin).count();
+        RecordProperty("lookups_per_us_" + std::to_string(ranges),
+                       std::to_string(int(lookups / secs / 1e6)));
+
+        // About half the addresses fall in a range
+        EXPECT_GT(found, lookups / 4);
+        EXPECT_LT(found, lookups * 3 / 4);
+    }
+}
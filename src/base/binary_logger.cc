@@ -0,0 +1,244 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/binary_logger.hh"
+
+#include <algorithm>
+#include <chrono>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "debug/FmtFlag.hh"
+#include "debug/FmtStackTrace.hh"
+#include "debug/FmtTicksOff.hh"
+#include "sim/backtrace.hh"
+
+namespace Trace
+{
+
+const uint32_t BinaryLogger::version;
+
+BinaryLogger::BinaryLogger(std::ostream &stream, size_t buffer_size)
+    : stream(stream), buffer(buffer_size), mask(buffer_size - 1),
+      head(0), tail(0), done(false), textBuf(*this), textStream(&textBuf)
+{
+    fatal_if(!isPowerOf2(buffer_size),
+             "Binary trace buffer size %d is not a power of two\n",
+             buffer_size);
+
+    rawArgs = true;
+
+    record.append("gem5trc", 8);
+    append(version);
+    pushRecord();
+
+    thread = std::thread(&BinaryLogger::writer, this);
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    close();
+}
+
+void
+BinaryLogger::close()
+{
+    if (!thread.joinable())
+        return;
+
+    flushText();
+    done.store(true, std::memory_order_release);
+    thread.join();
+}
+
+uint32_t
+BinaryLogger::stringId(const std::string &str)
+{
+    auto it = stringIds.find(str);
+    if (it != stringIds.end())
+        return it->second;
+
+    const uint32_t id = strings.size();
+    stringIds.emplace(str, id);
+    strings.push_back(str);
+
+    record.push_back(String);
+    append(id);
+    append(uint32_t(str.size()));
+    record.append(str);
+    pushRecord();
+
+    return id;
+}
+
+uint32_t
+BinaryLogger::formatId(const char *fmt)
+{
+    // Formats are almost always string literals, so the address is
+    // enough to find them. Check the contents anyway in case a
+    // temporary string reused the address of an earlier one.
+    auto it = formatIds.find(fmt);
+    if (it != formatIds.end() && strings[it->second] == fmt)
+        return it->second;
+
+    const uint32_t id = stringId(fmt);
+    formatIds[fmt] = id;
+    return id;
+}
+
+void
+BinaryLogger::beginRecord(RecordType type, Tick when,
+        const std::string &name, const std::string &flag)
+{
+    const uint32_t name_id = stringId(name);
+    const uint32_t flag_id = stringId(flag);
+
+    uint8_t opts = 0;
+    if (!DTRACE(FmtTicksOff) && (when != MaxTick))
+        opts |= ShowTick;
+    if (DTRACE(FmtFlag) && !flag.empty())
+        opts |= ShowFlag;
+
+    record.push_back(type);
+    append(opts);
+    append(uint64_t(when));
+    append(name_id);
+    append(flag_id);
+}
+
+void
+BinaryLogger::pushRecord()
+{
+    if (!thread.joinable() && done.load(std::memory_order_relaxed)) {
+        stream.write(record.data(), record.size());
+        record.clear();
+        return;
+    }
+
+    const uint64_t size = buffer.size();
+    const char *data = record.data();
+    size_t len = record.size();
+    uint64_t h = head.load(std::memory_order_relaxed);
+
+    while (len) {
+        const uint64_t space =
+            size - (h - tail.load(std::memory_order_acquire));
+        if (!space) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const uint64_t offset = h & mask;
+        const size_t n = std::min<uint64_t>({len, space, size - offset});
+        std::copy(data, data + n, buffer.data() + offset);
+
+        data += n;
+        len -= n;
+        h += n;
+        head.store(h, std::memory_order_release);
+    }
+
+    record.clear();
+}
+
+void
+BinaryLogger::flushText()
+{
+    const std::string text = textBuf.str();
+    if (text.empty())
+        return;
+    textBuf.str("");
+
+    beginRecord(Text, MaxTick, std::string(), std::string());
+    append(uint32_t(text.size()));
+    record.append(text);
+    pushRecord();
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (!name.empty() && ignore.match(name))
+        return;
+
+    flushText();
+
+    beginRecord(Text, when, name, flag);
+    append(uint32_t(message.size()));
+    record.append(message);
+    pushRecord();
+
+    if (DTRACE(FmtStackTrace))
+        print_backtrace();
+}
+
+void
+BinaryLogger::logArgs(Tick when, const std::string &name,
+        const std::string &flag, const char *fmt, const std::string &args)
+{
+    flushText();
+
+    const uint32_t fmt_id = formatId(fmt);
+
+    beginRecord(Message, when, name, flag);
+    append(fmt_id);
+    append(uint32_t(args.size()));
+    record.append(args);
+    pushRecord();
+
+    if (DTRACE(FmtStackTrace))
+        print_backtrace();
+}
+
+void
+BinaryLogger::writer()
+{
+    const uint64_t size = buffer.size();
+
+    while (true) {
+        // Read done before head so nothing pushed before close() is
+        // left behind.
+        const bool stop = done.load(std::memory_order_acquire);
+        const uint64_t t = tail.load(std::memory_order_relaxed);
+        const uint64_t h = head.load(std::memory_order_acquire);
+
+        if (h == t) {
+            if (stop)
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        const uint64_t offset = t & mask;
+        const uint64_t n = std::min(h - t, size - offset);
+        stream.write(buffer.data() + offset, n);
+        tail.store(t + n, std::memory_order_release);
+    }
+
+    stream.flush();
+}
+
+} // namespace Trace
@@ -0,0 +1,177 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_BINARY_LOGGER_HH__
+#define __BASE_BINARY_LOGGER_HH__
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "base/trace.hh"
+
+namespace Trace {
+
+/**
+ * Logger that leaves the formatting of messages to an offline decoder
+ * (util/decode_trace.py).  Messages are recorded as the tick, ids of the
+ * object name, flag and format string and the encoded arguments (see
+ * ArgEncoder), and go through a ring buffer that a background thread
+ * drains to the output stream.  The simulation thread never formats or
+ * writes anything itself.
+ *
+ * The file starts with the magic "gem5trc\0" and a 32 bit version in
+ * host byte order, followed by the records:
+ *
+ *   'S' <id:u32> <len:u32> <bytes>                  string table entry
+ *   'M' <opts:u8> <tick:u64> <name:u32> <flag:u32> <fmt:u32>
+ *       <len:u32> <args>                            message
+ *   'T' <opts:u8> <tick:u64> <name:u32> <flag:u32>
+ *       <len:u32> <text>                            preformatted text
+ *
+ * Names, flags and formats refer to string table entries, which always
+ * come before their first use.  The opts bits tell whether the tick and
+ * the flag were to be printed (FmtTicksOff/FmtFlag) when the message was
+ * logged.
+ *
+ * Like the rest of the logging code this expects a single thread to log
+ * messages at a time.
+ */
+class BinaryLogger : public Logger
+{
+  public:
+    static const uint32_t version = 1;
+
+    enum RecordType : char
+    {
+        String = 'S',
+        Message = 'M',
+        Text = 'T',
+    };
+
+    enum RecordOpts : uint8_t
+    {
+        ShowTick = 0x1,
+        ShowFlag = 0x2,
+    };
+
+    /**
+     * @param stream Stream the records are written to, only ever accessed
+     *     by the writer thread until the logger is closed.
+     * @param buffer_size Size of the ring buffer, must be a power of two.
+     */
+    BinaryLogger(std::ostream &stream, size_t buffer_size = 1 << 22);
+    ~BinaryLogger();
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    /** Text written to this stream is recorded when it is flushed or
+     *  before the next message, whichever comes first. */
+    std::ostream &getOstream() override { return textStream; }
+
+    /** Write out everything recorded so far and stop the writer
+     *  thread.  Later messages are written out synchronously. */
+    void close();
+
+    /** Closes the logger, as the simulator is about to exit */
+    void flush() override { close(); }
+
+  protected:
+    void logArgs(Tick when, const std::string &name,
+            const std::string &flag, const char *fmt,
+            const std::string &args) override;
+
+  private:
+    /** Get the id of a string, defining it first if it is new */
+    uint32_t stringId(const std::string &str);
+
+    /** Same for a format string, which is looked up by its address */
+    uint32_t formatId(const char *fmt);
+
+    /** Start a message or text record in the record buffer */
+    void beginRecord(RecordType type, Tick when, const std::string &name,
+            const std::string &flag);
+
+    template <typename T>
+    void
+    append(const T &value)
+    {
+        encodeRaw(record, &value, sizeof(value));
+    }
+
+    /** Hand the record buffer over to the writer thread */
+    void pushRecord();
+
+    /** Record whatever was written to the text stream */
+    void flushText();
+
+    /** Body of the writer thread */
+    void writer();
+
+    std::ostream &stream;
+
+    /** The ring buffer, head and tail count the bytes ever pushed
+     *  into it and written out of it. */
+    std::vector<char> buffer;
+    const uint64_t mask;
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> tail;
+
+    /** Set to make the writer thread exit once the buffer is empty */
+    std::atomic<bool> done;
+    std::thread thread;
+
+    /** Record being put together */
+    std::string record;
+
+    std::unordered_map<std::string, uint32_t> stringIds;
+    std::vector<std::string> strings;
+    std::unordered_map<const char *, uint32_t> formatIds;
+
+    class TextBuf : public std::stringbuf
+    {
+      private:
+        BinaryLogger &logger;
+
+      public:
+        TextBuf(BinaryLogger &logger) : logger(logger) { }
+
+      protected:
+        int sync() override { logger.flushText(); return 0; }
+    };
+
+    TextBuf textBuf;
+    std::ostream textStream;
+};
+
+} // namespace Trace
+
+#endif // __BASE_BINARY_LOGGER_HH__
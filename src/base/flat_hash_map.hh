@@ -0,0 +1,241 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_FLAT_HASH_MAP_HH__
+#define __BASE_FLAT_HASH_MAP_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * Hash map stored in a single array of slots, for the hot lookups of
+ * the simulator (decode caches, stalled messages, MSHRs, snoop filter
+ * lines). Collisions are resolved with linear probing, so the entries
+ * that collide are next to each other and a lookup usually touches a
+ * single cache line. Erased entries are filled by shifting the
+ * following entries of their run back (backward shift deletion), so
+ * there are no tombstones and lookups never get longer after erases.
+ *
+ * The hash of a key is scrambled with Fibonacci hashing, whose top
+ * bits depend on all the bits of the hash, as std::hash is the
+ * identity for integers and the low bits of addresses are mostly
+ * zero. The table keeps at least half of its slots free and doubles
+ * its size when it would get fuller than that.
+ *
+ * Inserts and erases can move entries around, so pointers to values
+ * are only valid until the next insert or erase.
+ *
+ * @tparam Key The type of the keys, compared with ==.
+ * @tparam Value The type of the values, default constructible.
+ * @tparam Hash Hash function for the keys.
+ */
+template <class Key, class Value, class Hash = std::hash<Key>>
+class FlatHashMap
+{
+  private:
+    struct Slot
+    {
+        Key key;
+        Value value;
+        bool used;
+
+        Slot() : key(), value(), used(false) {}
+    };
+
+    std::vector<Slot> slots;
+    /** log2 of the number of slots, 0 before the first insert */
+    unsigned bits;
+    /** Number of entries in the map */
+    size_t count;
+
+    size_t next(size_t i) const { return (i + 1) & (slots.size() - 1); }
+
+    /** Slot of a key, or the free slot where it would go */
+    size_t
+    slotOf(const Key &key) const
+    {
+        size_t i = home(key);
+        while (slots[i].used && !(slots[i].key == key))
+            i = next(i);
+        return i;
+    }
+
+    void
+    rehash(unsigned new_bits)
+    {
+        std::vector<Slot> old(size_t(1) << new_bits);
+        old.swap(slots);
+        bits = new_bits;
+
+        for (auto &slot : old) {
+            if (!slot.used)
+                continue;
+            size_t i = home(slot.key);
+            while (slots[i].used)
+                i = next(i);
+            std::swap(slots[i], slot);
+        }
+    }
+
+  public:
+    /**
+     * @param entries Number of entries to make room for, the table
+     *        grows past them as needed.
+     */
+    explicit FlatHashMap(size_t entries = 0)
+        : bits(0), count(0)
+    {
+        reserve(entries);
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    /** Number of slots of the table, at least twice the entries */
+    size_t capacity() const { return slots.size(); }
+
+    /** Make room for a number of entries without growing the table */
+    void
+    reserve(size_t entries)
+    {
+        unsigned new_bits = bits ? bits : 4;
+        while ((size_t(1) << new_bits) < 2 * entries)
+            ++new_bits;
+        if (new_bits != bits)
+            rehash(new_bits);
+    }
+
+    /** Slot where the probe sequence for a key starts */
+    size_t
+    home(const Key &key) const
+    {
+        assert(bits);
+        const uint64_t h = Hash()(key);
+        return (h * 0x9e3779b97f4a7c15ULL) >> (64 - bits);
+    }
+
+    /** The value of a key, nullptr if the key isn't in the map */
+    Value *
+    find(const Key &key)
+    {
+        if (!count)
+            return nullptr;
+        Slot &slot = slots[slotOf(key)];
+        return slot.used ? &slot.value : nullptr;
+    }
+
+    const Value *
+    find(const Key &key) const
+    {
+        return const_cast<FlatHashMap *>(this)->find(key);
+    }
+
+    /** The value of a key, adding a default value if needed */
+    Value &
+    operator[](const Key &key)
+    {
+        if (2 * (count + 1) > slots.size())
+            reserve(count + 1);
+
+        Slot &slot = slots[slotOf(key)];
+        if (!slot.used) {
+            slot.key = key;
+            slot.value = Value();
+            slot.used = true;
+            ++count;
+        }
+        return slot.value;
+    }
+
+    /**
+     * Remove a key.
+     *
+     * @return Whether the key was in the map.
+     */
+    bool
+    erase(const Key &key)
+    {
+        if (!count)
+            return false;
+
+        size_t hole = slotOf(key);
+        if (!slots[hole].used)
+            return false;
+        --count;
+
+        // Move back the entries of the run after the hole that could no
+        // longer be found from their home slot
+        const size_t mask = slots.size() - 1;
+        for (size_t i = next(hole); slots[i].used; i = next(i)) {
+            if (((i - home(slots[i].key)) & mask) >= ((i - hole) & mask)) {
+                std::swap(slots[hole], slots[i]);
+                hole = i;
+            }
+        }
+        slots[hole].used = false;
+        slots[hole].value = Value();
+        return true;
+    }
+
+    /** Remove all the entries, keeping the size of the table */
+    void
+    clear()
+    {
+        for (auto &slot : slots) {
+            if (slot.used) {
+                slot.used = false;
+                slot.value = Value();
+            }
+        }
+        count = 0;
+    }
+
+    /** Call f(key, value) for every entry, in no particular order */
+    template <class F>
+    void
+    forEach(F f)
+    {
+        for (auto &slot : slots) {
+            if (slot.used)
+                f(slot.key, slot.value);
+        }
+    }
+
+    template <class F>
+    void
+    forEach(F f) const
+    {
+        for (const auto &slot : slots) {
+            if (slot.used)
+                f(slot.key, slot.value);
+        }
+    }
+};
+
+#endif // __BASE_FLAT_HASH_MAP_HH__
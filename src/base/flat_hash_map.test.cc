@@ -0,0 +1,271 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/flat_hash_map.hh"
+
+namespace
+{
+
+typedef FlatHashMap<uint64_t, std::string> Map;
+
+/** Keys, in increasing order, whose probe sequences start at a slot */
+std::vector<uint64_t>
+keysAt(const Map &map, size_t slot, size_t count, uint64_t first = 1)
+{
+    std::vector<uint64_t> keys;
+    for (uint64_t key = first; keys.size() < count; ++key) {
+        if (map.home(key) == slot)
+            keys.push_back(key);
+    }
+    return keys;
+}
+
+/** Check that all the keys are in the map with their values */
+void
+expectAll(const Map &map, const std::unordered_map<uint64_t, std::string> &ref)
+{
+    EXPECT_EQ(ref.size(), map.size());
+    for (const auto &kv : ref) {
+        const std::string *value = map.find(kv.first);
+        ASSERT_NE(nullptr, value) << "Missing key " << kv.first;
+        EXPECT_EQ(kv.second, *value);
+    }
+
+    size_t visited = 0;
+    map.forEach([&](uint64_t key, const std::string &value) {
+        ++visited;
+        EXPECT_EQ(1, ref.count(key));
+    });
+    EXPECT_EQ(ref.size(), visited);
+}
+
+} // anonymous namespace
+
+TEST(FlatHashMapTest, Empty)
+{
+    Map map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(0, map.size());
+    EXPECT_EQ(nullptr, map.find(0));
+    EXPECT_EQ(nullptr, map.find(42));
+    EXPECT_FALSE(map.erase(42));
+}
+
+TEST(FlatHashMapTest, InsertFindAndOverwrite)
+{
+    Map map;
+    map[3] = "three";
+    map[0] = "zero";
+    EXPECT_EQ(2, map.size());
+    EXPECT_FALSE(map.empty());
+
+    ASSERT_NE(nullptr, map.find(3));
+    EXPECT_EQ("three", *map.find(3));
+    EXPECT_EQ("zero", *map.find(0));
+    EXPECT_EQ(nullptr, map.find(4));
+
+    map[3] = "drei";
+    EXPECT_EQ(2, map.size());
+    EXPECT_EQ("drei", *map.find(3));
+
+    // Looking a key up with [] adds a default value
+    EXPECT_EQ("", map[7]);
+    EXPECT_EQ(3, map.size());
+}
+
+TEST(FlatHashMapTest, CollidingKeysShareARun)
+{
+    Map map;
+    const auto keys = keysAt(map, 5, 4);
+    for (auto key : keys)
+        map[key] = std::to_string(key);
+
+    for (auto key : keys) {
+        ASSERT_NE(nullptr, map.find(key));
+        EXPECT_EQ(std::to_string(key), *map.find(key));
+    }
+}
+
+TEST(FlatHashMapTest, EraseShiftsTheRunBack)
+{
+    Map map(6);
+    const size_t slots = map.capacity();
+
+    // A run of keys homed at 2, and one homed at 3 that gets pushed
+    // behind them. Erasing the first key has to move all of them back.
+    const auto at2 = keysAt(map, 2, 3);
+    const auto at3 = keysAt(map, 3, 1);
+    const auto at6 = keysAt(map, 6, 1);
+    std::unordered_map<uint64_t, std::string> ref;
+    for (auto key : { at2[0], at2[1], at2[2], at3[0], at6[0] }) {
+        map[key] = std::to_string(key);
+        ref[key] = std::to_string(key);
+    }
+    EXPECT_EQ(slots, map.capacity());
+
+    for (auto key : { at2[0], at2[2], at3[0], at2[1] }) {
+        EXPECT_TRUE(map.erase(key));
+        EXPECT_FALSE(map.erase(key));
+        ref.erase(key);
+        expectAll(map, ref);
+    }
+}
+
+TEST(FlatHashMapTest, EraseWrapsAround)
+{
+    Map map(4);
+    const size_t last = map.capacity() - 1;
+
+    // The run starts in the last slot and continues at the first ones,
+    // where it meets an entry homed at slot 0
+    const auto at_last = keysAt(map, last, 3);
+    const auto at0 = keysAt(map, 0, 2);
+    std::unordered_map<uint64_t, std::string> ref;
+    for (auto key : { at_last[0], at_last[1], at0[0], at_last[2], at0[1] }) {
+        map[key] = std::to_string(key);
+        ref[key] = std::to_string(key);
+    }
+
+    for (auto key : { at_last[1], at0[0], at_last[0], at0[1], at_last[2] }) {
+        EXPECT_TRUE(map.erase(key));
+        ref.erase(key);
+        expectAll(map, ref);
+    }
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(FlatHashMapTest, GrowsToStayHalfEmpty)
+{
+    Map map;
+    std::unordered_map<uint64_t, std::string> ref;
+    size_t capacity = map.capacity();
+    for (uint64_t key = 0; key < 1000; ++key) {
+        map[key << 12] = std::to_string(key);
+        ref[key << 12] = std::to_string(key);
+
+        EXPECT_LE(2 * map.size(), map.capacity());
+        if (map.capacity() != capacity) {
+            EXPECT_EQ(2 * capacity, map.capacity());
+            capacity = map.capacity();
+        }
+    }
+    expectAll(map, ref);
+}
+
+TEST(FlatHashMapTest, ReserveAvoidsGrowth)
+{
+    Map map(100);
+    const size_t capacity = map.capacity();
+    EXPECT_LE(200, capacity);
+    for (uint64_t key = 0; key < 100; ++key)
+        map[key] = "x";
+    EXPECT_EQ(capacity, map.capacity());
+
+    // Reserving less never shrinks the table
+    map.reserve(10);
+    EXPECT_EQ(capacity, map.capacity());
+}
+
+TEST(FlatHashMapTest, ClearKeepsTheTable)
+{
+    Map map;
+    for (uint64_t key = 0; key < 100; ++key)
+        map[key] = "x";
+    const size_t capacity = map.capacity();
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(capacity, map.capacity());
+    for (uint64_t key = 0; key < 100; ++key)
+        EXPECT_EQ(nullptr, map.find(key));
+
+    map[5] = "five";
+    EXPECT_EQ("five", *map.find(5));
+}
+
+TEST(FlatHashMapTest, ErasedValuesAreReset)
+{
+    FlatHashMap<int, std::vector<int>> map;
+    map[1].push_back(1);
+    map.erase(1);
+    EXPECT_TRUE(map[1].empty());
+}
+
+TEST(FlatHashMapTest, CustomHash)
+{
+    struct Key
+    {
+        uint64_t addr;
+        bool secure;
+        bool
+        operator==(const Key &other) const
+        {
+            return addr == other.addr && secure == other.secure;
+        }
+    };
+    struct KeyHash
+    {
+        size_t operator()(const Key &k) const { return k.addr ^ k.secure; }
+    };
+
+    FlatHashMap<Key, int, KeyHash> map;
+    map[Key{64, false}] = 1;
+    map[Key{64, true}] = 2;
+    EXPECT_EQ(2, map.size());
+    EXPECT_EQ(1, *map.find(Key{64, false}));
+    EXPECT_EQ(2, *map.find(Key{64, true}));
+    EXPECT_EQ(nullptr, map.find(Key{128, false}));
+}
+
+TEST(FlatHashMapTest, MatchesUnorderedMap)
+{
+    Map map;
+    std::unordered_map<uint64_t, std::string> ref;
+    std::mt19937_64 rng(1234);
+
+    // Few distinct keys, so inserts, overwrites and erases all hit
+    for (int i = 0; i < 20000; ++i) {
+        const uint64_t key = (rng() % 512) << 6;
+        const int op = rng() % 3;
+        if (op == 0) {
+            EXPECT_EQ(ref.erase(key) != 0, map.erase(key));
+        } else {
+            map[key] = std::to_string(i);
+            ref[key] = std::to_string(i);
+        }
+
+        if (i % 1000 == 0)
+            expectAll(map, ref);
+    }
+    expectAll(map, ref);
+}
@@ -0,0 +1,211 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/free_list_pool.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+
+thread_local FreeListPool::ThreadList **FreeListPool::localLists = nullptr;
+thread_local unsigned FreeListPool::numLocalLists = 0;
+
+std::mutex FreeListPool::registryMutex;
+unsigned FreeListPool::nextId = 0;
+
+std::vector<FreeListPool *> &
+FreeListPool::registry()
+{
+    static std::vector<FreeListPool *> all;
+    return all;
+}
+
+const std::vector<FreeListPool *> &
+FreeListPool::pools()
+{
+    return registry();
+}
+
+unsigned
+FreeListPool::newId()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return nextId++;
+}
+
+FreeListPool::FreeListPool(const std::string &name, size_t max_size)
+    : _name(name), _maxSize(MinBlockSize << sizeClass(max_size)),
+      id(newId()), state(new State)
+{
+    panic_if(max_size > MaxBlockSize,
+             "Pool %s: blocks of %d bytes are too large.", name, max_size);
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    registry().push_back(this);
+}
+
+FreeListPool::~FreeListPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto &all = registry();
+        all.erase(std::find(all.begin(), all.end(), this));
+    }
+
+    // Blocks still in use may be released later on, e.g., by static
+    // objects destroyed after the pool, and they may only be released
+    // to the heap with their slab. Leak the pool instead.
+    if (state->outstanding())
+        return;
+
+    // The ids are not reused, so the threads never look at their
+    // pointers to these lists again.
+    delete state;
+    state = nullptr;
+}
+
+FreeListPool::State::~State()
+{
+    for (auto list : lists) {
+        for (auto slab : list->slabs)
+            ::operator delete(slab);
+        delete list;
+    }
+}
+
+Counter
+FreeListPool::State::outstanding() const
+{
+    std::lock_guard<std::mutex> lock(listsMutex);
+    Counter total = 0;
+    for (auto list : lists) {
+        total += list->allocs.load(std::memory_order_relaxed) -
+            list->releases.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+FreeListPool::ThreadList *
+FreeListPool::registerThread()
+{
+    // Free the array of the thread when it exits.
+    static thread_local struct Cleanup
+    {
+        ~Cleanup() { delete [] localLists; }
+    } cleanup;
+
+    if (id >= numLocalLists) {
+        const unsigned num_lists = std::max(2 * numLocalLists, id + 1);
+        ThreadList **local_lists = new ThreadList *[num_lists]();
+        std::copy(localLists, localLists + numLocalLists, local_lists);
+        delete [] localLists;
+        localLists = local_lists;
+        numLocalLists = num_lists;
+    }
+
+    ThreadList *list = new ThreadList();
+    localLists[id] = list;
+
+    std::lock_guard<std::mutex> lock(state->listsMutex);
+    state->lists.push_back(list);
+    return list;
+}
+
+void *
+FreeListPool::refill(ThreadList &list, unsigned cls)
+{
+    Block *batch = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(state->sharedMutex);
+        if (!state->shared[cls].empty()) {
+            batch = state->shared[cls].back();
+            state->shared[cls].pop_back();
+        }
+    }
+
+    if (batch) {
+        increment(list.hits);
+        list.free[cls] = batch->next;
+        list.freeCount[cls] = BatchSize - 1;
+        return batch;
+    }
+
+    const size_t block_size = MinBlockSize << cls;
+
+    // Block sizes all divide the slab size, so a slab is always used
+    // up completely before a new one is needed.
+    if (!list.slabLeft[cls]) {
+        list.slab[cls] = static_cast<uint8_t *>(::operator new(SlabSize));
+        list.slabLeft[cls] = SlabSize;
+        list.slabs.push_back(list.slab[cls]);
+    }
+
+    void *block = list.slab[cls];
+    list.slab[cls] += block_size;
+    list.slabLeft[cls] -= block_size;
+    return block;
+}
+
+void
+FreeListPool::shareBatch(ThreadList &list, unsigned cls)
+{
+    Block *batch = list.free[cls];
+    Block *last = batch;
+    for (size_t i = 1; i < BatchSize; ++i)
+        last = last->next;
+    list.free[cls] = last->next;
+    list.freeCount[cls] -= BatchSize;
+    last->next = nullptr;
+
+    std::lock_guard<std::mutex> lock(state->sharedMutex);
+    state->shared[cls].push_back(batch);
+}
+
+Counter
+FreeListPool::allocations() const
+{
+    std::lock_guard<std::mutex> lock(state->listsMutex);
+    Counter total = 0;
+    for (auto list : state->lists)
+        total += list->allocs.load(std::memory_order_relaxed);
+    return total;
+}
+
+Counter
+FreeListPool::hits() const
+{
+    std::lock_guard<std::mutex> lock(state->listsMutex);
+    Counter total = 0;
+    for (auto list : state->lists)
+        total += list->hits.load(std::memory_order_relaxed);
+    return total;
+}
+
+double
+FreeListPool::hitRate() const
+{
+    const Counter allocs = allocations();
+    return allocs ? double(hits()) / allocs : 0;
+}
@@ -0,0 +1,290 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_FREE_LIST_POOL_HH__
+#define __BASE_FREE_LIST_POOL_HH__
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "base/types.hh"
+
+/**
+ * A pool of small memory blocks for objects that are allocated and
+ * freed at a high rate, e.g., packets and their data.
+ *
+ * Requests are rounded up to a power-of-two size class between
+ * MinBlockSize and the maximum size of the pool. Every thread owns a
+ * free list per size class, so allocation and release rarely take a
+ * lock. Blocks released by a thread go to that thread's free list, no
+ * matter which thread allocated them. Once a free list holds more than
+ * two batches of blocks, a batch moves to a list shared by all threads,
+ * so that objects created by one thread and deleted by another are
+ * recycled instead of piling up. When a free list is empty, it takes a
+ * batch from the shared list or, failing that, a block is carved out
+ * of a per-thread slab. Slabs are in turn allocated from the heap a few
+ * kilobytes at a time. Requests larger than the maximum size go
+ * straight to the global operator new.
+ *
+ * Pools are meant to be global objects. They register themselves on
+ * construction, and unregister on destruction, so that their statistics
+ * can be reported, see pools().
+ *
+ * Memory is only returned to the heap when the pool is destroyed, and
+ * only if all its blocks have been released by then. Global pools are
+ * destroyed at exit, often with blocks still owned by objects that are
+ * never deleted, or by static objects destroyed after the pool. The
+ * memory of such a pool is deliberately leaked instead, and its blocks
+ * can still be released and allocated afterwards.
+ */
+class FreeListPool
+{
+  public:
+    static const size_t MinBlockSize = 16;
+    static const size_t MaxBlockSize = 2048;
+    static const size_t SlabSize = 16 * 1024;
+    /** Number of blocks moved between threads at once. */
+    static const size_t BatchSize = 64;
+
+    FreeListPool(const std::string &name, size_t max_size);
+    ~FreeListPool();
+    FreeListPool(const FreeListPool &) = delete;
+    FreeListPool &operator=(const FreeListPool &) = delete;
+
+    void *
+    allocate(size_t size)
+    {
+        if (!state)
+            return ::operator new(size);
+
+        ThreadList &list = local();
+        increment(list.allocs);
+
+        if (size > _maxSize)
+            return ::operator new(size);
+
+        const unsigned cls = sizeClass(size);
+        Block *block = list.free[cls];
+        if (block) {
+            increment(list.hits);
+            list.free[cls] = block->next;
+            --list.freeCount[cls];
+            return block;
+        }
+
+        return refill(list, cls);
+    }
+
+    void
+    release(void *p, size_t size)
+    {
+        if (!p)
+            return;
+
+        if (!state) {
+            ::operator delete(p);
+            return;
+        }
+
+        ThreadList &list = local();
+        increment(list.releases);
+
+        if (size > _maxSize) {
+            ::operator delete(p);
+            return;
+        }
+
+        const unsigned cls = sizeClass(size);
+        Block *block = static_cast<Block *>(p);
+        block->next = list.free[cls];
+        list.free[cls] = block;
+        if (++list.freeCount[cls] > 2 * BatchSize)
+            shareBatch(list, cls);
+    }
+
+    const std::string &name() const { return _name; }
+
+    /** Largest request served from the pool. */
+    size_t maxSize() const { return _maxSize; }
+
+    /** Number of allocations, summed over all threads. */
+    Counter allocations() const;
+
+    /** Number of allocations served by a recycled block. */
+    Counter hits() const;
+
+    /** Fraction of allocations served by a recycled block. */
+    double hitRate() const;
+
+    /** All pools currently constructed. */
+    static const std::vector<FreeListPool *> &pools();
+
+  private:
+    struct Block
+    {
+        Block *next;
+    };
+
+    static const unsigned NumClasses = 8;
+
+    /** Per-thread state of a pool, freed with the pool. */
+    struct ThreadList
+    {
+        Block *free[NumClasses];
+        size_t freeCount[NumClasses];
+        uint8_t *slab[NumClasses];
+        size_t slabLeft[NumClasses];
+        /** Slabs taken from the heap. */
+        std::vector<void *> slabs;
+        /**
+         * Written by the owning thread only, but read by the thread
+         * reporting the statistics.
+         */
+        std::atomic<Counter> allocs;
+        std::atomic<Counter> hits;
+        std::atomic<Counter> releases;
+    };
+
+    /**
+     * Everything but the per-thread free lists that may be needed after
+     * the destruction of the pool, see the class description.
+     */
+    struct State
+    {
+        mutable std::mutex listsMutex;
+        std::vector<ThreadList *> lists;
+
+        /** Batches of BatchSize free blocks shared by all threads. */
+        std::mutex sharedMutex;
+        std::vector<Block *> shared[NumClasses];
+
+        /** Number of blocks allocated and not yet released. */
+        Counter outstanding() const;
+
+        ~State();
+    };
+
+    const std::string _name;
+    const size_t _maxSize;
+    /** Index in the per-thread lists, never reused. */
+    const unsigned id;
+
+    /** Null once the pool is destroyed and its memory freed. */
+    State *state;
+
+    /** Lists of the calling thread, indexed by pool id. */
+    static thread_local ThreadList **localLists;
+    static thread_local unsigned numLocalLists;
+
+    static std::mutex registryMutex;
+    static unsigned nextId;
+    static unsigned newId();
+    static std::vector<FreeListPool *> &registry();
+
+    /**
+     * Increment a counter of the calling thread. No other thread
+     * writes it, so there is no need for an atomic read-modify-write.
+     */
+    static void
+    increment(std::atomic<Counter> &counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+    }
+
+    static unsigned
+    sizeClass(size_t size)
+    {
+        unsigned cls = 0;
+        for (size_t block = MinBlockSize; block < size; block <<= 1)
+            ++cls;
+        return cls;
+    }
+
+    ThreadList &
+    local()
+    {
+        if (id < numLocalLists && localLists[id])
+            return *localLists[id];
+        return *registerThread();
+    }
+
+    ThreadList *registerThread();
+
+    /**
+     * Get a block of the given size class for an empty free list,
+     * from the shared batches or from the slab.
+     */
+    void *refill(ThreadList &list, unsigned cls);
+
+    /** Move a batch of blocks from a free list to the shared ones. */
+    void shareBatch(ThreadList &list, unsigned cls);
+};
+
+/**
+ * An allocator for standard containers and std::allocate_shared
+ * backed by the global FreeListPool passed as template argument.
+ */
+template <class T, FreeListPool &Pool>
+class FreeListAllocator
+{
+  public:
+    typedef T value_type;
+
+    template <class U>
+    struct rebind
+    {
+        typedef FreeListAllocator<U, Pool> other;
+    };
+
+    FreeListAllocator() = default;
+
+    template <class U>
+    FreeListAllocator(const FreeListAllocator<U, Pool> &) {}
+
+    T *
+    allocate(size_t n)
+    {
+        return static_cast<T *>(Pool.allocate(n * sizeof(T)));
+    }
+
+    void
+    deallocate(T *p, size_t n)
+    {
+        Pool.release(p, n * sizeof(T));
+    }
+
+    template <class U>
+    bool operator==(const FreeListAllocator<U, Pool> &) const { return true; }
+
+    template <class U>
+    bool operator!=(const FreeListAllocator<U, Pool> &) const { return false; }
+};
+
+#endif // __BASE_FREE_LIST_POOL_HH__
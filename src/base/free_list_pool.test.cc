@@ -0,0 +1,337 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "base/free_list_pool.hh"
+
+namespace
+{
+
+FreeListPool testPool("test", 128);
+
+} // anonymous namespace
+
+TEST(FreeListPoolTest, MaxSizeRoundedUp)
+{
+    FreeListPool pool("rounded", 100);
+    EXPECT_EQ(128u, pool.maxSize());
+}
+
+TEST(FreeListPoolTest, RecyclesBlocks)
+{
+    FreeListPool pool("recycle", 64);
+
+    void *first = pool.allocate(64);
+    EXPECT_EQ(0, pool.hits());
+    pool.release(first, 64);
+
+    // The block just released is the next one handed out.
+    void *second = pool.allocate(64);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(2, pool.allocations());
+    EXPECT_EQ(1, pool.hits());
+    EXPECT_DOUBLE_EQ(0.5, pool.hitRate());
+    pool.release(second, 64);
+}
+
+TEST(FreeListPoolTest, SizeClasses)
+{
+    FreeListPool pool("classes", 64);
+
+    void *small = pool.allocate(8);
+    pool.release(small, 8);
+
+    // A request from a different size class does not reuse the block.
+    void *large = pool.allocate(64);
+    EXPECT_NE(small, large);
+    EXPECT_EQ(0, pool.hits());
+
+    // A request from the same size class does.
+    void *other_small = pool.allocate(16);
+    EXPECT_EQ(small, other_small);
+    EXPECT_EQ(1, pool.hits());
+
+    pool.release(large, 64);
+    pool.release(other_small, 16);
+}
+
+TEST(FreeListPoolTest, DistinctBlocks)
+{
+    FreeListPool pool("distinct", 32);
+
+    // Span several slabs and check that no block is handed out twice.
+    const int count = 4 * FreeListPool::SlabSize / 32;
+    std::set<void *> blocks;
+    for (int i = 0; i < count; ++i) {
+        void *block = pool.allocate(32);
+        EXPECT_TRUE(blocks.insert(block).second);
+        memset(block, 0xff, 32);
+    }
+
+    for (auto block : blocks)
+        pool.release(block, 32);
+    EXPECT_EQ(0, pool.hits());
+}
+
+TEST(FreeListPoolTest, OversizedRequests)
+{
+    FreeListPool pool("oversized", 32);
+
+    void *block = pool.allocate(1024);
+    EXPECT_NE(nullptr, block);
+    pool.release(block, 1024);
+    EXPECT_EQ(1, pool.allocations());
+    EXPECT_EQ(0, pool.hits());
+}
+
+TEST(FreeListPoolTest, Unregister)
+{
+    const size_t count = FreeListPool::pools().size();
+    {
+        FreeListPool pool("unregister", 32);
+        EXPECT_EQ(count + 1, FreeListPool::pools().size());
+        pool.release(pool.allocate(32), 32);
+    }
+    EXPECT_EQ(count, FreeListPool::pools().size());
+}
+
+// Pools destroyed like global ones at exit, while static objects that
+// are destroyed later on may still own some of their blocks
+TEST(FreeListPoolTest, ReleaseAfterDestruction)
+{
+    static std::aligned_storage<sizeof(FreeListPool),
+                                alignof(FreeListPool)>::type storage;
+    FreeListPool *pool = new (&storage) FreeListPool("leaked", 32);
+
+    void *block = pool->allocate(32);
+    pool->~FreeListPool();
+
+    // The memory of the pool is leaked, so blocks are still recycled
+    pool->release(block, 32);
+    void *other = pool->allocate(32);
+    EXPECT_EQ(block, other);
+    pool->release(other, 32);
+}
+
+TEST(FreeListPoolTest, AllocateAfterDestruction)
+{
+    static std::aligned_storage<sizeof(FreeListPool),
+                                alignof(FreeListPool)>::type storage;
+    FreeListPool *pool = new (&storage) FreeListPool("freed", 32);
+
+    pool->release(pool->allocate(32), 32);
+    pool->~FreeListPool();
+
+    // Nothing was in use, so the memory of the pool is freed and
+    // later requests are served by the heap
+    void *block = pool->allocate(32);
+    EXPECT_NE(nullptr, block);
+    pool->release(block, 32);
+}
+
+TEST(FreeListPoolTest, ManyPools)
+{
+    // Every pool gets its own per-thread lists, however many pools
+    // were created before.
+    for (int i = 0; i < 100; ++i) {
+        FreeListPool pool("many", 32);
+        pool.release(pool.allocate(32), 32);
+        pool.release(pool.allocate(32), 32);
+        EXPECT_EQ(2, pool.allocations());
+        EXPECT_EQ(1, pool.hits());
+    }
+}
+
+TEST(FreeListPoolTest, PerThreadLists)
+{
+    void *main_block = testPool.allocate(128);
+    testPool.release(main_block, 128);
+
+    // Another thread has its own, empty, free list.
+    void *thread_block = nullptr;
+    std::thread thread([&thread_block]() {
+        thread_block = testPool.allocate(128);
+        testPool.release(thread_block, 128);
+    });
+    thread.join();
+
+    EXPECT_NE(main_block, thread_block);
+    EXPECT_EQ(2, testPool.allocations());
+    EXPECT_EQ(0, testPool.hits());
+}
+
+TEST(FreeListPoolTest, CrossThreadRelease)
+{
+    FreeListPool pool("cross", 32);
+    const Counter count = 8 * FreeListPool::BatchSize;
+
+    // Blocks allocated by this thread and released by another one make
+    // their way back to this thread, except for the at most two batches
+    // the other thread keeps, rather than new ones being carved every
+    // time.
+    Counter hits = 0;
+    for (int round = 0; round < 4; ++round) {
+        hits = pool.hits();
+        std::vector<void *> blocks;
+        for (Counter i = 0; i < count; ++i)
+            blocks.push_back(pool.allocate(32));
+        hits = pool.hits() - hits;
+
+        std::thread thread([&pool, &blocks]() {
+            for (auto block : blocks)
+                pool.release(block, 32);
+        });
+        thread.join();
+    }
+    EXPECT_LE(count - Counter(2 * FreeListPool::BatchSize), hits);
+}
+
+// Run a function on a thread of its own, with its own free lists
+template <class F>
+void
+onNewThread(F f)
+{
+    std::thread thread(f);
+    thread.join();
+}
+
+TEST(FreeListPoolTest, SharedBatches)
+{
+    FreeListPool pool("batches", 32);
+    const size_t batch = FreeListPool::BatchSize;
+
+    std::vector<void *> blocks;
+    onNewThread([&pool, &blocks, batch]() {
+        for (size_t i = 0; i < 3 * batch; ++i)
+            blocks.push_back(pool.allocate(32));
+    });
+    const std::set<void *> released(blocks.begin(), blocks.end());
+
+    // A free list keeps up to two batches to itself, so another thread
+    // still carves new blocks.
+    for (size_t i = 0; i < 2 * batch; ++i)
+        pool.release(blocks[i], 32);
+    Counter hits = pool.hits();
+    void *carved = nullptr;
+    onNewThread([&pool, &carved]() { carved = pool.allocate(32); });
+    EXPECT_EQ(hits, pool.hits());
+    EXPECT_EQ(0, released.count(carved));
+
+    // One more block moves the most recently released batch to the
+    // shared list, where the next thread with an empty free list finds
+    // it. Once that batch is used up, blocks are carved again.
+    pool.release(blocks[2 * batch], 32);
+    hits = pool.hits();
+    std::vector<void *> recycled;
+    void *next = nullptr;
+    onNewThread([&pool, &recycled, &next, batch]() {
+        for (size_t i = 0; i < batch; ++i)
+            recycled.push_back(pool.allocate(32));
+        next = pool.allocate(32);
+    });
+    EXPECT_EQ(hits + batch, pool.hits());
+    EXPECT_EQ(batch, std::set<void *>(recycled.begin(),
+                                      recycled.end()).size());
+    for (size_t i = 0; i < batch; ++i)
+        EXPECT_EQ(1, released.count(recycled[i]));
+    EXPECT_EQ(0, released.count(next));
+
+    // The releasing thread kept the rest of its blocks.
+    hits = pool.hits();
+    void *kept = pool.allocate(32);
+    EXPECT_EQ(hits + 1, pool.hits());
+    EXPECT_EQ(1, released.count(kept));
+    EXPECT_EQ(0, std::count(recycled.begin(), recycled.end(), kept));
+}
+
+TEST(FreeListPoolTest, ProducerConsumer)
+{
+    FreeListPool pool("producer", 32);
+    const size_t in_flight = 4 * FreeListPool::BatchSize;
+    const size_t count = 64 * in_flight;
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<void *> queue;
+    std::set<void *> seen;
+
+    // One thread allocates blocks that another thread releases, with at
+    // most in_flight blocks between the two at any time.
+    std::thread producer([&]() {
+        for (size_t i = 0; i < count; ++i) {
+            void *block = pool.allocate(32);
+            memset(block, 0xff, 32);
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [&]() { return queue.size() < in_flight; });
+            seen.insert(block);
+            queue.push_back(block);
+            cond.notify_all();
+        }
+    });
+    std::thread consumer([&]() {
+        for (size_t i = 0; i < count; ++i) {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [&]() { return !queue.empty(); });
+            void *block = queue.front();
+            queue.pop_front();
+            cond.notify_all();
+            lock.unlock();
+            pool.release(block, 32);
+        }
+    });
+    producer.join();
+    consumer.join();
+
+    // A block is only carved when the producer finds no free block in
+    // its own list or the shared ones, i.e., when all other blocks are
+    // in flight or kept by the consumer, which keeps at most two
+    // batches. Every other allocation recycles a block.
+    EXPECT_LE(seen.size(), in_flight + 3 * FreeListPool::BatchSize);
+    EXPECT_EQ(Counter(count), pool.allocations());
+    EXPECT_EQ(Counter(count - seen.size()), pool.hits());
+}
+
+TEST(FreeListPoolTest, SharedPtrAllocator)
+{
+    const Counter allocs = testPool.allocations();
+    {
+        auto ptr = std::allocate_shared<uint64_t>(
+            FreeListAllocator<uint64_t, testPool>(), 42);
+        EXPECT_EQ(42u, *ptr);
+    }
+    EXPECT_EQ(allocs + 1, testPool.allocations());
+}
@@ -0,0 +1,276 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_INTRUSIVE_LIST_HH__
+#define __BASE_INTRUSIVE_LIST_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+
+template <class T> class IntrusiveListHook;
+
+/**
+ * A doubly linked list of reference counted objects that keeps its links
+ * inside the objects themselves, so adding and removing elements never
+ * allocates. An object can be in as many lists as it has hooks, but only
+ * in one list per hook.
+ *
+ * Like a std::list<RefCountingPtr<T>>, the list holds a reference to
+ * each of its elements: it calls incref() when an element is added and
+ * decref() when it is removed. T must therefore derive from RefCounted,
+ * and elements may be destroyed by erase(), pop_front() or clear().
+ *
+ * Iterators are bidirectional, and stay valid until the element they
+ * point to is removed. As with the sentinel node of a std::list, they
+ * wrap around through end(): decrementing begin() or incrementing the
+ * last element yields end(), and decrementing end() yields the last
+ * element. Dereferencing an iterator returns a plain pointer to the
+ * element rather than a reference, which is enough for the usual
+ * (*it)->member and DynInstPtr inst = *it idioms.
+ *
+ * The hook is found through a class rather than a pointer to the member
+ * of T, since a member pointer cannot be formed while T is incomplete,
+ * e.g., in the classes T itself depends on.
+ *
+ * @tparam T The type of the elements.
+ * @tparam HookOf A class with a static get(T *) returning the hook of an
+ *         element that links it into this list.
+ */
+template <class T, class HookOf>
+class IntrusiveList
+{
+  private:
+    T *head;
+    T *tail;
+    size_t _size;
+
+    static IntrusiveListHook<T> &hook(T *elem) { return HookOf::get(elem); }
+
+  public:
+    class iterator
+    {
+      private:
+        const IntrusiveList *list;
+        T *elem;
+
+        friend class IntrusiveList;
+
+      public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T *value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T *const *pointer;
+        typedef T *reference;
+
+        iterator() : list(nullptr), elem(nullptr) {}
+        iterator(const IntrusiveList *_list, T *_elem)
+            : list(_list), elem(_elem)
+        {}
+
+        T *operator*() const { assert(elem); return elem; }
+
+        iterator &
+        operator++()
+        {
+            elem = elem ? hook(elem).next : list->head;
+            return *this;
+        }
+
+        iterator
+        operator++(int)
+        {
+            iterator it = *this;
+            ++*this;
+            return it;
+        }
+
+        iterator &
+        operator--()
+        {
+            elem = elem ? hook(elem).prev : list->tail;
+            return *this;
+        }
+
+        iterator
+        operator--(int)
+        {
+            iterator it = *this;
+            --*this;
+            return it;
+        }
+
+        bool
+        operator==(const iterator &other) const
+        {
+            return list == other.list && elem == other.elem;
+        }
+
+        bool
+        operator!=(const iterator &other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    IntrusiveList() : head(nullptr), tail(nullptr), _size(0) {}
+    IntrusiveList(const IntrusiveList &) = delete;
+    IntrusiveList &operator=(const IntrusiveList &) = delete;
+
+    ~IntrusiveList() { clear(); }
+
+    bool empty() const { return _size == 0; }
+    size_t size() const { return _size; }
+
+    T *front() const { assert(head); return head; }
+    T *back() const { assert(tail); return tail; }
+
+    iterator begin() const { return iterator(this, head); }
+    iterator end() const { return iterator(this, nullptr); }
+
+    /** Get an iterator to an element that is in this list. */
+    iterator
+    iteratorTo(T *elem) const
+    {
+        assert(hook(elem).list == this);
+        return iterator(this, elem);
+    }
+
+    /** Check if an element is in this list. */
+    bool
+    contains(const T *elem) const
+    {
+        return hook(const_cast<T *>(elem)).list == this;
+    }
+
+    /**
+     * Insert an element before the given position.
+     *
+     * @return An iterator to the inserted element.
+     */
+    iterator
+    insert(iterator pos, T *elem)
+    {
+        assert(pos.list == this);
+        IntrusiveListHook<T> &link = hook(elem);
+        assert(!link.list);
+
+        T *next = pos.elem;
+        T *prev = next ? hook(next).prev : tail;
+
+        link.list = this;
+        link.prev = prev;
+        link.next = next;
+        if (prev)
+            hook(prev).next = elem;
+        else
+            head = elem;
+        if (next)
+            hook(next).prev = elem;
+        else
+            tail = elem;
+
+        ++_size;
+        elem->incref();
+        return iterator(this, elem);
+    }
+
+    void push_back(T *elem) { insert(end(), elem); }
+    void push_front(T *elem) { insert(begin(), elem); }
+
+    /**
+     * Remove an element from the list, dropping the reference the list
+     * held to it.
+     *
+     * @return An iterator to the element that followed it.
+     */
+    iterator
+    erase(iterator pos)
+    {
+        assert(pos.list == this && pos.elem);
+        T *elem = pos.elem;
+        IntrusiveListHook<T> &link = hook(elem);
+        T *next = link.next;
+
+        if (link.prev)
+            hook(link.prev).next = next;
+        else
+            head = next;
+        if (next)
+            hook(next).prev = link.prev;
+        else
+            tail = link.prev;
+
+        link.list = nullptr;
+        link.prev = nullptr;
+        link.next = nullptr;
+
+        --_size;
+        elem->decref();
+        return iterator(this, next);
+    }
+
+    void pop_front() { erase(begin()); }
+    void pop_back() { erase(iterator(this, tail)); }
+
+    void
+    clear()
+    {
+        while (head)
+            pop_front();
+    }
+};
+
+/**
+ * The links of an object in an IntrusiveList. Declare one member of this
+ * type per list the object may be in at the same time.
+ */
+template <class T>
+class IntrusiveListHook
+{
+  private:
+    template <class U, class HookOf>
+    friend class IntrusiveList;
+
+    const void *list;
+    T *prev;
+    T *next;
+
+  public:
+    IntrusiveListHook() : list(nullptr), prev(nullptr), next(nullptr) {}
+
+    /** Objects are copied without their list membership. */
+    IntrusiveListHook(const IntrusiveListHook &)
+        : IntrusiveListHook()
+    {}
+    IntrusiveListHook &operator=(const IntrusiveListHook &) { return *this; }
+
+    ~IntrusiveListHook() { assert(!list); }
+
+    /** Check if the object is in a list through this hook. */
+    bool linked() const { return list != nullptr; }
+};
+
+#endif // __BASE_INTRUSIVE_LIST_HH__
@@ -0,0 +1,176 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "base/intrusive_list.hh"
+#include "base/refcnt.hh"
+
+namespace
+{
+
+int liveElems = 0;
+
+class Elem : public RefCounted
+{
+  public:
+    const int value;
+    IntrusiveListHook<Elem> firstHook;
+    IntrusiveListHook<Elem> secondHook;
+
+    Elem(int _value) : value(_value) { ++liveElems; }
+    ~Elem() { --liveElems; }
+};
+
+struct FirstHook
+{
+    static IntrusiveListHook<Elem> &
+    get(Elem *elem)
+    {
+        return elem->firstHook;
+    }
+};
+
+struct SecondHook
+{
+    static IntrusiveListHook<Elem> &
+    get(Elem *elem)
+    {
+        return elem->secondHook;
+    }
+};
+
+typedef RefCountingPtr<Elem> ElemPtr;
+typedef IntrusiveList<Elem, FirstHook> FirstList;
+typedef IntrusiveList<Elem, SecondHook> SecondList;
+
+std::vector<int>
+values(const FirstList &list)
+{
+    std::vector<int> v;
+    for (auto it = list.begin(); it != list.end(); ++it)
+        v.push_back((*it)->value);
+    return v;
+}
+
+} // anonymous namespace
+
+TEST(IntrusiveListTest, Empty)
+{
+    FirstList list;
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(0u, list.size());
+    EXPECT_TRUE(list.begin() == list.end());
+}
+
+TEST(IntrusiveListTest, PushAndErase)
+{
+    {
+        FirstList list;
+        list.push_back(new Elem(2));
+        list.push_back(new Elem(3));
+        list.push_front(new Elem(1));
+        EXPECT_EQ(3u, list.size());
+        EXPECT_EQ(3, liveElems);
+        EXPECT_EQ(std::vector<int>({1, 2, 3}), values(list));
+        EXPECT_EQ(1, list.front()->value);
+        EXPECT_EQ(3, list.back()->value);
+
+        auto it = list.erase(++list.begin());
+        EXPECT_EQ(3, (*it)->value);
+        EXPECT_EQ(2, liveElems);
+        EXPECT_EQ(std::vector<int>({1, 3}), values(list));
+
+        list.insert(it, new Elem(2));
+        EXPECT_EQ(std::vector<int>({1, 2, 3}), values(list));
+
+        list.pop_back();
+        list.pop_front();
+        EXPECT_EQ(std::vector<int>({2}), values(list));
+    }
+    // The list dropped its reference to the last element
+    EXPECT_EQ(0, liveElems);
+}
+
+TEST(IntrusiveListTest, DecrementEnd)
+{
+    FirstList list;
+    list.push_back(new Elem(1));
+    list.push_back(new Elem(2));
+
+    auto it = list.end();
+    --it;
+    EXPECT_EQ(2, (*it)->value);
+    --it;
+    EXPECT_EQ(1, (*it)->value);
+    EXPECT_TRUE(it == list.begin());
+
+    // Iterators wrap around through end()
+    --it;
+    EXPECT_TRUE(it == list.end());
+    ++it;
+    EXPECT_TRUE(it == list.begin());
+}
+
+TEST(IntrusiveListTest, DecrementEndOfEmpty)
+{
+    FirstList list;
+    auto it = list.end();
+    --it;
+    EXPECT_TRUE(it == list.end());
+}
+
+TEST(IntrusiveListTest, SharedOwnership)
+{
+    ElemPtr elem = new Elem(7);
+    {
+        FirstList first;
+        SecondList second;
+        first.push_back(elem.get());
+        second.push_back(elem.get());
+        EXPECT_TRUE(first.contains(elem.get()));
+        EXPECT_TRUE(second.contains(elem.get()));
+        EXPECT_TRUE(elem->firstHook.linked());
+
+        first.erase(first.iteratorTo(elem.get()));
+        EXPECT_FALSE(first.contains(elem.get()));
+        EXPECT_TRUE(second.contains(elem.get()));
+        EXPECT_EQ(1, liveElems);
+    }
+    // Both lists are gone, but the pointer still holds the element
+    EXPECT_EQ(1, liveElems);
+    EXPECT_FALSE(elem->secondHook.linked());
+    elem = nullptr;
+    EXPECT_EQ(0, liveElems);
+}
+
+TEST(IntrusiveListTest, IteratorsOfDifferentLists)
+{
+    FirstList a;
+    FirstList b;
+    EXPECT_TRUE(a.end() != b.end());
+}
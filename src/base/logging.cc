@@ -43,6 +43,7 @@
 #include <sstream>
 
 #include "base/hostinfo.hh"
+#include "base/trace.hh"
 
 namespace {
 
@@ -67,6 +68,8 @@ class ExitLogger : public NormalLogger
         std::stringstream ss;
         ccprintf(ss, "Memory Usage: %ld KBytes\n", memUsage());
         NormalLogger::log(loc, s + ss.str());
+        // Don't lose the debug output leading up to the error
+        Trace::getDebugLogger()->flush();
     }
 };
 
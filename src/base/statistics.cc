@@ -54,7 +54,6 @@
 #include "base/str.hh"
 #include "base/time.hh"
 #include "base/trace.hh"
-#include "sim/root.hh"
 
 using namespace std;
 
@@ -157,8 +156,11 @@ int Info::id_count = 0;
 int debug_break_id = -1;
 
 Info::Info()
-    : flags(none), precision(-1), prereq(0), storageParams(NULL)
+    : flags(none), precision(-1), prereq(0), storageParams(NULL),
+      zeroReset(false)
 {
+    Arena::init();
+
     id = id_count++;
     if (debug_break_id >= 0 and debug_break_id == id)
         Debug::breakpoint();
@@ -574,17 +576,6 @@ reset()
         fatal("No registered Stats::reset handler");
 }
 
-const Info *
-resolve(const std::string &name)
-{
-    const auto &it = nameMap().find(name);
-    if (it != nameMap().cend()) {
-        return it->second;
-    } else {
-        return Root::root()->resolveStat(name);
-    }
-}
-
 void
 registerDumpCallback(Callback *cb)
 {
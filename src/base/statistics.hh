@@ -72,6 +72,7 @@
 #include <string>
 #include <vector>
 
+#include "base/stats/arena.hh"
 #include "base/stats/group.hh"
 #include "base/stats/info.hh"
 #include "base/stats/output.hh"
@@ -497,6 +498,9 @@ class StatStor
   public:
     struct Params : public StorageParams {};
 
+    /** reset() clears all the bytes of this storage */
+    static const bool zeroReset = true;
+
   public:
     /**
      * Builds this storage element and calls the base constructor of the
@@ -568,6 +572,8 @@ class AvgStor
   public:
     struct Params : public StorageParams {};
 
+    static const bool zeroReset = false;
+
   public:
     /**
      * Build and initializes this stat storage.
@@ -658,8 +664,8 @@ class ScalarBase : public DataWrap<Derived, ScalarInfoProxy>
     typedef typename Stor::Params Params;
 
   protected:
-    /** The storage of this stat. */
-    char storage[sizeof(Storage)] __attribute__ ((aligned (8)));
+    /** The storage of this stat, in the stats arena. */
+    Storage *storage;
 
   protected:
     /**
@@ -670,7 +676,7 @@ class ScalarBase : public DataWrap<Derived, ScalarInfoProxy>
     Storage *
     data()
     {
-        return reinterpret_cast<Storage *>(storage);
+        return storage;
     }
 
     /**
@@ -682,13 +688,15 @@ class ScalarBase : public DataWrap<Derived, ScalarInfoProxy>
     const Storage *
     data() const
     {
-        return reinterpret_cast<const Storage *>(storage);
+        return storage;
     }
 
     void
     doInit()
     {
+        storage = Arena::allocate<Storage>(1, Storage::zeroReset);
         new (storage) Storage(this->info());
+        this->info()->zeroReset = Storage::zeroReset;
         this->setInit();
     }
 
@@ -1061,12 +1069,12 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
         assert(!storage && "already initialized");
         _size = s;
 
-        char *ptr = new char[_size * sizeof(Storage)];
-        storage = reinterpret_cast<Storage *>(ptr);
+        storage = Arena::allocate<Storage>(_size, Storage::zeroReset);
 
         for (off_type i = 0; i < _size; ++i)
             new (&storage[i]) Storage(this->info());
 
+        this->info()->zeroReset = Storage::zeroReset;
         this->setInit();
     }
 
@@ -1137,7 +1145,6 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
 
         for (off_type i = 0; i < _size; ++i)
             data(i)->~Storage();
-        delete [] reinterpret_cast<char *>(storage);
     }
 
     /**
@@ -1278,7 +1285,6 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
 
         for (off_type i = 0; i < _size; ++i)
             data(i)->~Storage();
-        delete [] reinterpret_cast<char *>(storage);
     }
 
     Derived &
@@ -1296,12 +1302,12 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
         info->y = _y;
         _size = x * y;
 
-        char *ptr = new char[_size * sizeof(Storage)];
-        storage = reinterpret_cast<Storage *>(ptr);
+        storage = Arena::allocate<Storage>(_size, Storage::zeroReset);
 
         for (off_type i = 0; i < _size; ++i)
             new (&storage[i]) Storage(info);
 
+        info->zeroReset = Storage::zeroReset;
         this->setInit();
 
         return self;
@@ -1431,9 +1437,11 @@ class DistStor
     /** The number of samples. */
     Counter samples;
     /** Counter for each bucket. */
-    VCounter cvec;
+    CounterArray cvec;
 
   public:
+    static const bool zeroReset = false;
+
     DistStor(Info *info)
         : cvec(safe_cast<const Params *>(info->storageParams)->buckets)
     {
@@ -1569,9 +1577,11 @@ class HistStor
     /** The number of samples. */
     Counter samples;
     /** Counter for each bucket. */
-    VCounter cvec;
+    CounterArray cvec;
 
   public:
+    static const bool zeroReset = false;
+
     HistStor(Info *info)
         : cvec(safe_cast<const Params *>(info->storageParams)->buckets)
     {
@@ -1704,6 +1714,8 @@ class SampleStor
     Counter samples;
 
   public:
+    static const bool zeroReset = true;
+
     /**
      * Create and initialize this storage.
      */
@@ -1781,6 +1793,8 @@ class AvgSampleStor
     Counter squares;
 
   public:
+    static const bool zeroReset = true;
+
     /**
      * Create and initialize this storage.
      */
@@ -1849,8 +1863,8 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
     typedef typename Stor::Params Params;
 
   protected:
-    /** The storage for this stat. */
-    char storage[sizeof(Storage)] __attribute__ ((aligned (8)));
+    /** The storage for this stat, in the stats arena. */
+    Storage *storage;
 
   protected:
     /**
@@ -1860,7 +1874,7 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
     Storage *
     data()
     {
-        return reinterpret_cast<Storage *>(storage);
+        return storage;
     }
 
     /**
@@ -1870,20 +1884,29 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
     const Storage *
     data() const
     {
-        return reinterpret_cast<const Storage *>(storage);
+        return storage;
     }
 
     void
     doInit()
     {
+        storage = Arena::allocate<Storage>(1, Storage::zeroReset);
         new (storage) Storage(this->info());
+        this->info()->zeroReset = Storage::zeroReset;
         this->setInit();
     }
 
   public:
     DistBase(Group *parent, const char *name, const char *desc)
-        : DataWrap<Derived, DistInfoProxy>(parent, name, desc)
+        : DataWrap<Derived, DistInfoProxy>(parent, name, desc),
+          storage(nullptr)
+    {
+    }
+
+    ~DistBase()
     {
+        if (storage)
+            data()->~Storage();
     }
 
     /**
@@ -1967,13 +1990,13 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
         assert(!storage && "already initialized");
         _size = s;
 
-        char *ptr = new char[_size * sizeof(Storage)];
-        storage = reinterpret_cast<Storage *>(ptr);
+        storage = Arena::allocate<Storage>(_size, Storage::zeroReset);
 
         Info *info = this->info();
         for (off_type i = 0; i < _size; ++i)
             new (&storage[i]) Storage(info);
 
+        info->zeroReset = Storage::zeroReset;
         this->setInit();
     }
 
@@ -1990,7 +2013,6 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
 
         for (off_type i = 0; i < _size; ++i)
             data(i)->~Storage();
-        delete [] reinterpret_cast<char *>(storage);
     }
 
     Proxy operator[](off_type index)
@@ -3349,7 +3371,6 @@ void dump();
 void reset();
 void enable();
 bool enabled();
-const Info* resolve(const std::string &name);
 
 /**
  * Register reset and dump handlers.  These are the functions which
@@ -0,0 +1,101 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/arena.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+namespace Stats {
+
+namespace {
+
+/** Chunks are big enough to hold the stats of many objects */
+const size_t chunkSize = 256 * 1024;
+
+} // anonymous namespace
+
+bool Arena::_resetting = false;
+
+std::vector<Arena::Chunk> &
+Arena::chunks(bool zero_reset)
+{
+    // Constructed during the construction of the first stat (see
+    // init()). Static objects are destroyed in the reverse order their
+    // construction completed, so the lists outlive every static stat
+    // and the storage is still there when the stat destroys it.
+    static std::vector<Chunk> lists[2];
+
+    return lists[zero_reset];
+}
+
+void *
+Arena::allocate(size_t size, size_t align, bool zero_reset)
+{
+    assert(align && align <= alignof(std::max_align_t));
+
+    std::vector<Chunk> &list = chunks(zero_reset);
+
+    if (!list.empty()) {
+        Chunk &chunk = list.back();
+        const size_t offset = (chunk.used + align - 1) & ~(align - 1);
+        if (offset + size <= chunk.size) {
+            chunk.used = offset + size;
+            return chunk.data.get() + offset;
+        }
+    }
+
+    // Bigger allocations get a chunk of their own. Keep allocating
+    // from the current chunk in that case, it probably has more room.
+    const size_t new_size = std::max(size, chunkSize);
+    Chunk chunk = { std::unique_ptr<char[]>(new char[new_size]),
+                     new_size, size };
+    char *data = chunk.data.get();
+    if (new_size == size && !list.empty())
+        list.insert(list.end() - 1, std::move(chunk));
+    else
+        list.push_back(std::move(chunk));
+
+    return data;
+}
+
+void
+Arena::beginReset()
+{
+    for (const auto &chunk : chunks(true))
+        std::memset(chunk.data.get(), 0, chunk.used);
+
+    _resetting = true;
+}
+
+void
+Arena::endReset()
+{
+    _resetting = false;
+}
+
+} // namespace Stats
@@ -0,0 +1,131 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_ARENA_HH__
+#define __BASE_STATS_ARENA_HH__
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "base/stats/types.hh"
+
+namespace Stats {
+
+/**
+ * Backing memory for the storage of all stats.
+ *
+ * Stats get their storage out of a few large chunks instead of separate
+ * heap blocks, which keeps the storage of the whole system together
+ * for dumps and resets. Storage that resets to all zero bytes (see the
+ * zeroReset member of the storage classes) goes in chunks of its own,
+ * so a reset of all stats can clear it with a memset per chunk instead
+ * of resetting the stats one by one. This clears the stats of every
+ * group, so resetStats() overrides have to reset the stats of their
+ * base class too.
+ *
+ * Memory is only handed back when the arena is destroyed at exit,
+ * stats are expected to live as long as the simulation.
+ */
+class Arena
+{
+  public:
+    /**
+     * Allocate uninitialized memory for the storage of a stat.
+     *
+     * @param size Size of the allocation in bytes.
+     * @param align Required alignment, at most alignof(max_align_t).
+     * @param zero_reset Whether the storage resets to all zero bytes.
+     */
+    static void *allocate(size_t size, size_t align, bool zero_reset);
+
+    template <class T>
+    static T *
+    allocate(size_t count, bool zero_reset)
+    {
+        return static_cast<T *>(
+            allocate(count * sizeof(T), alignof(T), zero_reset));
+    }
+
+    /**
+     * Zero the storage of all the stats that reset to zero. Until
+     * endReset(), Group::resetStats() skips these stats.
+     */
+    static void beginReset();
+    static void endReset();
+
+    /** Are the zero reset stats already reset? */
+    static bool resetting() { return _resetting; }
+
+    /**
+     * Construct the arena if it doesn't exist yet. Every stat calls this
+     * while it is constructed, so the arena is destroyed after all the
+     * stats with static storage duration that could still use it.
+     */
+    static void init() { chunks(true); }
+
+  private:
+    struct Chunk
+    {
+        std::unique_ptr<char[]> data;
+        size_t size;
+        size_t used;
+    };
+
+    static std::vector<Chunk> &chunks(bool zero_reset);
+
+    static bool _resetting;
+};
+
+/**
+ * Fixed size array of counters allocated from the arena, used for the
+ * buckets of distributions.
+ */
+class CounterArray
+{
+  private:
+    Counter *_data;
+    size_type _size;
+
+  public:
+    CounterArray(size_type size)
+        : _data(Arena::allocate<Counter>(size, false)), _size(size)
+    {
+        for (off_type i = 0; i < _size; ++i)
+            _data[i] = Counter();
+    }
+
+    CounterArray(const CounterArray &) = delete;
+    CounterArray &operator=(const CounterArray &) = delete;
+
+    size_type size() const { return _size; }
+
+    Counter &operator[](off_type index) { return _data[index]; }
+    const Counter &operator[](off_type index) const { return _data[index]; }
+};
+
+} // namespace Stats
+
+#endif // __BASE_STATS_ARENA_HH__
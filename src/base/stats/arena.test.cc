@@ -0,0 +1,309 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/stats/arena.hh"
+#include "sim/eventq_impl.hh"
+
+namespace
+{
+
+/** A group whose resetStats() also resets state of its own, like DRAM */
+class TimedGroup : public Stats::Group
+{
+  public:
+    Stats::Scalar reads;
+    Stats::Distribution sizes;
+    Tick lastReset;
+
+    TimedGroup(Stats::Group *parent)
+        : Stats::Group(parent, "timed"),
+          reads(this, "reads", "Reads"),
+          sizes(this, "sizes", "Sizes"),
+          lastReset(0)
+    {
+        sizes.init(0, 8, 2);
+    }
+
+    void
+    resetStats() override
+    {
+        Stats::Group::resetStats();
+
+        lastReset = curTick();
+    }
+};
+
+/** A group that resets some stats again itself, like the Ruby objects */
+class HistGroup : public Stats::Group
+{
+  public:
+    Stats::Histogram latency;
+    Stats::Vector hits;
+
+    HistGroup(Stats::Group *parent)
+        : Stats::Group(parent, "hist"),
+          latency(this, "latency", "Latency"),
+          hits(this, "hits", "Hits")
+    {
+        latency.init(4);
+        hits.init(2);
+    }
+
+    void
+    resetStats() override
+    {
+        Stats::Group::resetStats();
+
+        latency.reset();
+    }
+};
+
+/** Stats of every kind that has arena storage */
+struct Tree
+{
+    Stats::Group root;
+    Stats::Scalar scalar;
+    Stats::Average average;
+    Stats::Vector vector;
+    Stats::AverageVector averageVector;
+    Stats::Vector2d vector2d;
+    Stats::Distribution dist;
+    Stats::StandardDeviation stdev;
+    Stats::AverageDeviation avgdev;
+    Stats::VectorDistribution vectorDist;
+    TimedGroup timed;
+    HistGroup hist;
+
+    Tree()
+        : root(nullptr),
+          scalar(&root, "scalar", "A scalar"),
+          average(&root, "average", "An average"),
+          vector(&root, "vector", "A vector"),
+          averageVector(&root, "averageVector", "An average vector"),
+          vector2d(&root, "vector2d", "A 2d vector"),
+          dist(&root, "dist", "A distribution"),
+          stdev(&root, "stdev", "A standard deviation"),
+          avgdev(&root, "avgdev", "An average deviation"),
+          vectorDist(&root, "vectorDist", "A vector distribution"),
+          timed(&root), hist(&root)
+    {
+        vector.init(3);
+        averageVector.init(2);
+        vector2d.init(2, 3);
+        dist.init(0, 10, 5);
+        vectorDist.init(2, 0, 4, 2);
+    }
+
+    void
+    sample(int seed)
+    {
+        scalar += 3 + seed;
+        average = 7 + seed;
+        vector[0] += 1;
+        vector[2] += 4 + seed;
+        averageVector[1] = 5;
+        vector2d[1][2] += 6 + seed;
+        for (int i = 0; i < 4; ++i) {
+            dist.sample(i * 4 + seed);
+            stdev.sample(i + seed);
+            avgdev.sample(2 * i);
+            vectorDist[i % 2].sample(i + seed);
+            timed.sizes.sample(3 * i);
+            hist.latency.sample(10 * i + seed);
+        }
+        timed.reads += 2;
+        hist.hits[1] += 9;
+    }
+};
+
+void
+snapshot(const Stats::DistData &data, std::vector<double> &values)
+{
+    values.insert(values.end(), {
+        data.min_val, data.max_val, data.underflow, data.overflow,
+        data.sum, data.squares, data.samples, data.bucket_size });
+    values.insert(values.end(), data.cvec.begin(), data.cvec.end());
+}
+
+/** The values of all the stats in a group and its sub-groups */
+void
+snapshot(Stats::Group &group, std::vector<double> &values)
+{
+    for (auto *info : group.getStats()) {
+        info->prepare();
+
+        if (auto *s = dynamic_cast<Stats::ScalarInfo *>(info)) {
+            values.push_back(s->result());
+        } else if (auto *v = dynamic_cast<Stats::VectorInfo *>(info)) {
+            for (auto r : v->result())
+                values.push_back(r);
+        } else if (auto *v2d = dynamic_cast<Stats::Vector2dInfo *>(info)) {
+            for (auto c : v2d->cvec)
+                values.push_back(c);
+        } else if (auto *d = dynamic_cast<Stats::DistInfo *>(info)) {
+            snapshot(d->data, values);
+        } else if (auto *vd = dynamic_cast<Stats::VectorDistInfo *>(info)) {
+            for (const auto &data : vd->data)
+                snapshot(data, values);
+        } else {
+            ADD_FAILURE() << "Unexpected kind of stat " << info->name;
+        }
+    }
+
+    for (auto &g : group.getStatGroups())
+        snapshot(*g.second, values);
+}
+
+std::vector<double>
+snapshot(Stats::Group &group)
+{
+    std::vector<double> values;
+    snapshot(group, values);
+    return values;
+}
+
+class ArenaTest : public testing::Test
+{
+  protected:
+    EventQueue eq;
+
+    ArenaTest() : eq("test") { curEventQueue(&eq); }
+};
+
+} // anonymous namespace
+
+TEST(Arena, AllocationsAreAligned)
+{
+    for (size_t align = 1; align <= alignof(std::max_align_t); align *= 2) {
+        // Throw the next allocation off alignment first
+        Stats::Arena::allocate(1, 1, true);
+        Stats::Arena::allocate(1, 1, false);
+
+        auto *zero = Stats::Arena::allocate(3 * align, align, true);
+        auto *other = Stats::Arena::allocate(3 * align, align, false);
+        EXPECT_EQ(0, reinterpret_cast<uintptr_t>(zero) % align);
+        EXPECT_EQ(0, reinterpret_cast<uintptr_t>(other) % align);
+    }
+}
+
+TEST(Arena, AllocationsDontOverlap)
+{
+    // Big allocations get chunks of their own, the small ones after them
+    // keep using the current chunk
+    const std::vector<size_t> sizes = { 8, 1 << 20, 16, 4 << 20, 8 };
+
+    std::vector<std::pair<uintptr_t, uintptr_t>> ranges;
+    for (auto size : sizes) {
+        for (bool zero_reset : { true, false }) {
+            auto *data = static_cast<char *>(
+                Stats::Arena::allocate(size, 8, zero_reset));
+            // The whole allocation has to be writable
+            std::fill(data, data + size, 0x5a);
+            ranges.emplace_back(reinterpret_cast<uintptr_t>(data),
+                                reinterpret_cast<uintptr_t>(data) + size);
+        }
+    }
+
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        for (size_t j = i + 1; j < ranges.size(); ++j) {
+            EXPECT_TRUE(ranges[i].second <= ranges[j].first ||
+                        ranges[j].second <= ranges[i].first);
+        }
+    }
+}
+
+TEST_F(ArenaTest, BeginResetOnlyClearsZeroResetStats)
+{
+    Tree tree;
+    tree.sample(0);
+
+    Stats::Arena::beginReset();
+    EXPECT_TRUE(Stats::Arena::resetting());
+
+    EXPECT_EQ(0, tree.scalar.value());
+    EXPECT_EQ(0, tree.vector.total());
+    EXPECT_EQ(0, tree.timed.reads.value());
+    EXPECT_EQ(0, tree.hist.hits.total());
+    // Averages and distributions are reset by resetStats()
+    EXPECT_EQ(7, tree.average.value());
+    EXPECT_FALSE(tree.dist.zero());
+
+    Stats::Arena::endReset();
+    EXPECT_FALSE(Stats::Arena::resetting());
+}
+
+TEST_F(ArenaTest, BulkResetMatchesPerStatReset)
+{
+    Tree per_stat;
+    Tree bulk;
+
+    eq.setCurTick(100);
+    per_stat.sample(1);
+    bulk.sample(1);
+    const std::vector<double> sampled = snapshot(per_stat.root);
+    EXPECT_EQ(sampled, snapshot(bulk.root));
+
+    eq.setCurTick(200);
+    per_stat.root.resetStats();
+    const std::vector<double> reset = snapshot(per_stat.root);
+    EXPECT_NE(sampled, reset);
+
+    Stats::Arena::beginReset();
+    bulk.root.resetStats();
+    Stats::Arena::endReset();
+    EXPECT_EQ(reset, snapshot(bulk.root));
+
+    // The overrides did their own part of the reset in both cases
+    EXPECT_EQ(200, per_stat.timed.lastReset);
+    EXPECT_EQ(200, bulk.timed.lastReset);
+    EXPECT_TRUE(per_stat.hist.latency.zero());
+    EXPECT_TRUE(bulk.hist.latency.zero());
+
+    // Both start over from the same state
+    eq.setCurTick(300);
+    per_stat.sample(2);
+    bulk.sample(2);
+    EXPECT_EQ(snapshot(per_stat.root), snapshot(bulk.root));
+}
+
+TEST_F(ArenaTest, ResetOfASubTreeResetsAllItsStats)
+{
+    Tree tree;
+    tree.sample(0);
+
+    // Outside of a bulk reset resetStats() resets every stat itself
+    tree.timed.resetStats();
+    EXPECT_EQ(0, tree.timed.reads.value());
+    EXPECT_TRUE(tree.timed.sizes.zero());
+    EXPECT_EQ(3, tree.scalar.value());
+}
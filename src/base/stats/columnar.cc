@@ -0,0 +1,354 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/columnar.hh"
+
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/stats/info.hh"
+#include "sim/core.hh"
+
+namespace Stats {
+
+const uint32_t Columnar::version;
+
+namespace {
+
+/** Columns of a distribution, see Columnar::appendDist() */
+size_t
+distColumns(const DistData &data)
+{
+    return data.type == Deviation ? 5 : 9 + data.cvec.size();
+}
+
+const std::string &
+subname(const std::vector<std::string> &subnames, off_type i,
+        std::string &buf)
+{
+    if (i < subnames.size() && !subnames[i].empty())
+        return subnames[i];
+    buf = std::to_string(i);
+    return buf;
+}
+
+const std::string &
+subdesc(const std::vector<std::string> &subdescs, off_type i,
+        const std::string &desc)
+{
+    if (i < subdescs.size() && !subdescs[i].empty())
+        return subdescs[i];
+    return desc;
+}
+
+} // anonymous namespace
+
+Columnar::Columnar(std::ostream &stream, bool desc)
+    : stream(stream), enableDescriptions(desc),
+      schema(nullptr), matched(0)
+{
+    stream.write("gem5col", 8);
+    write(version);
+    if (!valid())
+        fatal("Unable to open statistics file for writing\n");
+}
+
+void
+Columnar::begin()
+{
+    values.clear();
+    matched = 0;
+    building.reset();
+}
+
+void
+Columnar::end()
+{
+    assert(pathStarts.empty());
+
+    // Stats left over in the schema don't match either
+    if (!building && (!schema || matched != schema->stats.size()))
+        startSchema();
+
+    if (building) {
+        schema = nullptr;
+        for (auto &s : schemas) {
+            if (s->stats == building->stats) {
+                schema = s.get();
+                break;
+            }
+        }
+
+        if (!schema) {
+            building->id = schemas.size();
+
+            write('S');
+            write(building->id);
+            write(uint32_t(building->names.size()));
+            for (size_t i = 0; i < building->names.size(); ++i) {
+                writeString(building->names[i]);
+                writeString(building->descs[i]);
+            }
+
+            schemas.push_back(std::move(building));
+            schema = schemas.back().get();
+        }
+        building.reset();
+    }
+
+    write('D');
+    write(schema->id);
+    write(uint64_t(curTick()));
+    stream.write(reinterpret_cast<const char *>(values.data()),
+                 values.size() * sizeof(double));
+    stream.flush();
+}
+
+bool
+Columnar::valid() const
+{
+    return stream.good();
+}
+
+void
+Columnar::beginGroup(const char *name)
+{
+    pathStarts.push_back(path.size());
+    if (!path.empty())
+        path += '.';
+    path += name;
+}
+
+void
+Columnar::endGroup()
+{
+    assert(!pathStarts.empty());
+    path.resize(pathStarts.back());
+    pathStarts.pop_back();
+}
+
+std::string
+Columnar::statName(const std::string &name) const
+{
+    return path.empty() ? name : path + "." + name;
+}
+
+bool
+Columnar::beginStat(const Info &info, size_t columns)
+{
+    if (!building) {
+        if (schema && matched < schema->stats.size() &&
+            schema->stats[matched].first == info.id &&
+            schema->stats[matched].second == columns) {
+            ++matched;
+            return false;
+        }
+        startSchema();
+    }
+
+    building->stats.emplace_back(info.id, columns);
+    return true;
+}
+
+void
+Columnar::startSchema()
+{
+    building.reset(new Schema);
+    if (!schema)
+        return;
+
+    // The stats that matched so far are the same in the new schema
+    building->stats.assign(schema->stats.begin(),
+                           schema->stats.begin() + matched);
+    building->names.assign(schema->names.begin(),
+                           schema->names.begin() + values.size());
+    building->descs.assign(schema->descs.begin(),
+                           schema->descs.begin() + values.size());
+}
+
+void
+Columnar::addColumn(const std::string &name, const std::string &desc)
+{
+    building->names.push_back(name);
+    building->descs.push_back(enableDescriptions ? desc : std::string());
+}
+
+void
+Columnar::writeString(const std::string &str)
+{
+    write(uint32_t(str.size()));
+    stream.write(str.data(), str.size());
+}
+
+void
+Columnar::visit(const ScalarInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    if (beginStat(info, 1))
+        addColumn(statName(info.name), info.desc);
+
+    values.push_back(info.result());
+}
+
+void
+Columnar::visit(const VectorInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    const VResult &result = info.result();
+
+    if (beginStat(info, result.size())) {
+        const std::string base = statName(info.name) + info.separatorString;
+        std::string buf;
+        for (off_type i = 0; i < result.size(); ++i) {
+            addColumn(base + subname(info.subnames, i, buf),
+                      subdesc(info.subdescs, i, info.desc));
+        }
+    }
+
+    values.insert(values.end(), result.begin(), result.end());
+}
+
+void
+Columnar::visit(const Vector2dInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    if (beginStat(info, info.cvec.size())) {
+        std::string xbuf, ybuf;
+        for (off_type i = 0; i < info.x; ++i) {
+            const std::string base =
+                statName(info.name + "_" + subname(info.subnames, i, xbuf)) +
+                info.separatorString;
+            for (off_type j = 0; j < info.y; ++j) {
+                addColumn(base + subname(info.y_subnames, j, ybuf),
+                          subdesc(info.subdescs, i, info.desc));
+            }
+        }
+    }
+
+    values.insert(values.end(), info.cvec.begin(), info.cvec.end());
+}
+
+void
+Columnar::nameDist(const std::string &base, const DistData &data,
+                   const std::string &desc)
+{
+    static const char *fields[] = {
+        "samples", "min_value", "max_value", "sum", "squares",
+        "underflows", "overflows", "min", "bucket_size",
+    };
+
+    const size_t columns = distColumns(data);
+    for (size_t i = 0; i < columns; ++i) {
+        addColumn(i < 9 ? base + fields[i] : base + std::to_string(i - 9),
+                  desc);
+    }
+}
+
+/**
+ * Distributions are stored as their samples, min_value, max_value, sum
+ * and squares, followed for everything but deviations by underflows,
+ * overflows, min, bucket_size and the buckets, named by their index.
+ */
+void
+Columnar::appendDist(const DistData &data)
+{
+    values.push_back(data.samples);
+    values.push_back(data.min_val);
+    values.push_back(data.max_val);
+    values.push_back(data.sum);
+    values.push_back(data.squares);
+
+    if (data.type == Deviation)
+        return;
+
+    values.push_back(data.underflow);
+    values.push_back(data.overflow);
+    values.push_back(data.min);
+    values.push_back(data.bucket_size);
+    values.insert(values.end(), data.cvec.begin(), data.cvec.end());
+}
+
+void
+Columnar::visit(const DistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    if (beginStat(info, distColumns(info.data)))
+        nameDist(statName(info.name) + info.separatorString, info.data,
+                 info.desc);
+
+    appendDist(info.data);
+}
+
+void
+Columnar::visit(const VectorDistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    size_t columns = 0;
+    for (const auto &data : info.data)
+        columns += distColumns(data);
+
+    if (beginStat(info, columns)) {
+        std::string buf;
+        for (off_type i = 0; i < info.data.size(); ++i) {
+            nameDist(statName(info.name + "_" +
+                              subname(info.subnames, i, buf)) +
+                     info.separatorString,
+                     info.data[i], subdesc(info.subdescs, i, info.desc));
+        }
+    }
+
+    for (const auto &data : info.data)
+        appendDist(data);
+}
+
+void
+Columnar::visit(const FormulaInfo &info)
+{
+    visit((const VectorInfo &)info);
+}
+
+void
+Columnar::visit(const SparseHistInfo &info)
+{
+    warn_once("Columnar stat files don't support sparse histograms.\n");
+}
+
+std::unique_ptr<Output>
+initColumnar(const std::string &filename, bool desc)
+{
+    OutputStream *os = simout.create(filename, true);
+    return std::unique_ptr<Output>(new Columnar(*os->stream(), desc));
+}
+
+} // namespace Stats
@@ -0,0 +1,153 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_COLUMNAR_HH__
+#define __BASE_STATS_COLUMNAR_HH__
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace Stats {
+
+struct DistData;
+
+/**
+ * Stat output that stores every dump as one row of doubles.
+ *
+ * The column names are written once, in a schema record, and each dump
+ * after that only appends the tick and the values of all the columns.
+ * Dumps that visit the same stats in the same order share a schema; it
+ * is only when a dump visits different stats (e.g., a dump of a sub-tree)
+ * that a new schema is written.  Checking that a dump matches its schema
+ * only compares stat ids, so no names are built in the common case.
+ *
+ * The file starts with the magic "gem5col\0" and a 32 bit version in
+ * host byte order, followed by the records (all in host byte order):
+ *
+ *   'S' <schema:u32> <columns:u32>
+ *       (<len:u32> <name> <len:u32> <desc>) * columns
+ *   'D' <schema:u32> <tick:u64> <value:f64> * columns
+ *
+ * util/stats_columnar.py reads these files.  The output is compressed
+ * if the file name ends in .gz.
+ */
+class Columnar : public Output
+{
+  public:
+    static const uint32_t version = 1;
+
+    Columnar(std::ostream &stream, bool desc);
+
+    Columnar() = delete;
+    Columnar(const Columnar &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    struct Schema
+    {
+        uint32_t id;
+        /** Id and number of columns of each stat, in visiting order */
+        std::vector<std::pair<int, size_t>> stats;
+        std::vector<std::string> names;
+        std::vector<std::string> descs;
+    };
+
+    /**
+     * Check the next stat of the dump against the schema.
+     *
+     * @return true if the stat doesn't match and its columns need to be
+     *     named with addColumn().
+     */
+    bool beginStat(const Info &info, size_t columns);
+
+    /** Start a new schema with the stats that matched so far */
+    void startSchema();
+
+    void addColumn(const std::string &name, const std::string &desc);
+
+    void appendDist(const DistData &data);
+    void nameDist(const std::string &base, const DistData &data,
+                  const std::string &desc);
+
+    std::string statName(const std::string &name) const;
+
+    template <typename T>
+    void
+    write(const T &value)
+    {
+        stream.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    void writeString(const std::string &str);
+
+  protected:
+    std::ostream &stream;
+    const bool enableDescriptions;
+
+    /** Group path, and where each group starts in it */
+    std::string path;
+    std::vector<size_t> pathStarts;
+
+    std::vector<std::unique_ptr<Schema>> schemas;
+
+    /** Schema the current dump is expected to match */
+    Schema *schema;
+    /** Number of stats of the dump that matched schema */
+    size_t matched;
+    /** Schema being built if the dump didn't match */
+    std::unique_ptr<Schema> building;
+
+    /** Values of the current dump */
+    std::vector<double> values;
+};
+
+std::unique_ptr<Output> initColumnar(const std::string &filename,
+                                     bool desc = true);
+
+} // namespace Stats
+
+#endif // __BASE_STATS_COLUMNAR_HH__
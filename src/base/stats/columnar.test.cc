@@ -0,0 +1,271 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/stats/columnar.hh"
+#include "sim/eventq_impl.hh"
+
+/*
+ * The stats are written to a string and read back with the reader
+ * below, which follows the format described in base/stats/columnar.hh
+ * the same way util/stats_columnar.py does.
+ */
+
+namespace
+{
+
+struct Dump
+{
+    uint32_t schema;
+    Tick tick;
+    std::vector<double> values;
+};
+
+struct ColumnarFile
+{
+    uint32_t version;
+    /** Column names of each schema, by schema id */
+    std::map<uint32_t, std::vector<std::string>> schemas;
+    std::vector<Dump> dumps;
+
+    /** Value of a column in a dump, NaN if the column doesn't exist */
+    double
+    value(const Dump &dump, const std::string &name) const
+    {
+        const auto &names = schemas.at(dump.schema);
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (names[i] == name)
+                return dump.values.at(i);
+        }
+        return std::nan("");
+    }
+};
+
+class Reader
+{
+  public:
+    Reader(const std::string &_data) : data(_data), pos(0) {}
+
+    template <typename T>
+    T
+    get()
+    {
+        T value;
+        EXPECT_LE(pos + sizeof(value), data.size());
+        std::memcpy(&value, data.data() + pos, sizeof(value));
+        pos += sizeof(value);
+        return value;
+    }
+
+    std::string
+    getString()
+    {
+        const uint32_t len = get<uint32_t>();
+        std::string str = data.substr(pos, len);
+        pos += len;
+        return str;
+    }
+
+    bool done() const { return pos >= data.size(); }
+
+    ColumnarFile
+    read()
+    {
+        ColumnarFile file;
+        EXPECT_EQ(std::string("gem5col", 8), data.substr(0, 8));
+        pos = 8;
+        file.version = get<uint32_t>();
+
+        while (!done()) {
+            const char type = get<char>();
+            const uint32_t schema = get<uint32_t>();
+            if (type == 'S') {
+                EXPECT_EQ(0u, file.schemas.count(schema));
+                auto &names = file.schemas[schema];
+                const uint32_t columns = get<uint32_t>();
+                for (uint32_t i = 0; i < columns; ++i) {
+                    names.push_back(getString());
+                    getString();
+                }
+            } else {
+                EXPECT_EQ('D', type);
+                EXPECT_EQ(1u, file.schemas.count(schema));
+                Dump dump;
+                dump.schema = schema;
+                dump.tick = get<uint64_t>();
+                for (size_t i = 0; i < file.schemas[schema].size(); ++i)
+                    dump.values.push_back(get<double>());
+                file.dumps.push_back(dump);
+            }
+        }
+
+        return file;
+    }
+
+  private:
+    const std::string data;
+    size_t pos;
+};
+
+class ColumnarTest : public testing::Test
+{
+  protected:
+    EventQueue eq;
+    std::ostringstream stream;
+    Stats::Columnar columnar;
+
+    Stats::Group group;
+    Stats::Scalar scalar;
+    Stats::Vector vector;
+    Stats::Distribution dist;
+
+    ColumnarTest()
+        : eq("test"), columnar(stream, true), group(nullptr),
+          scalar(&group, "scalar", "A scalar"),
+          vector(&group, "vector", "A vector"),
+          dist(&group, "dist", "A distribution")
+    {
+        curEventQueue(&eq);
+
+        vector.init(2).subname(0, "first");
+        dist.init(0, 3, 2);
+    }
+
+    /** Dump the given stats at a tick */
+    void
+    dump(Tick when, const std::vector<Stats::Info *> &infos)
+    {
+        eq.setCurTick(when);
+        columnar.begin();
+        for (auto *info : infos) {
+            info->prepare();
+            info->visit(columnar);
+        }
+        columnar.end();
+    }
+
+    std::vector<Stats::Info *>
+    allStats()
+    {
+        return group.getStats();
+    }
+
+    ColumnarFile read() { return Reader(stream.str()).read(); }
+};
+
+} // anonymous namespace
+
+TEST_F(ColumnarTest, ColumnNames)
+{
+    dump(100, allStats());
+
+    ColumnarFile file = read();
+    EXPECT_EQ(Stats::Columnar::version, file.version);
+    ASSERT_EQ(1u, file.schemas.size());
+
+    const std::vector<std::string> expected = {
+        "scalar", "vector::first", "vector::1",
+        "dist::samples", "dist::min_value", "dist::max_value", "dist::sum",
+        "dist::squares", "dist::underflows", "dist::overflows", "dist::min",
+        "dist::bucket_size", "dist::0", "dist::1",
+    };
+    EXPECT_EQ(expected, file.schemas[0]);
+}
+
+TEST_F(ColumnarTest, TwoDumpsShareSchema)
+{
+    scalar = 3;
+    vector[0] = 1;
+    vector[1] = 2;
+    dist.sample(1);
+    dist.sample(2);
+    dist.sample(5);
+    dump(100, allStats());
+
+    scalar += 4;
+    vector[1] = 7;
+    dist.sample(0);
+    dump(200, allStats());
+
+    ColumnarFile file = read();
+    ASSERT_EQ(1u, file.schemas.size());
+    ASSERT_EQ(2u, file.dumps.size());
+
+    const Dump &first = file.dumps[0];
+    EXPECT_EQ(100u, first.tick);
+    EXPECT_EQ(3, file.value(first, "scalar"));
+    EXPECT_EQ(1, file.value(first, "vector::first"));
+    EXPECT_EQ(2, file.value(first, "vector::1"));
+    EXPECT_EQ(3, file.value(first, "dist::samples"));
+    EXPECT_EQ(1, file.value(first, "dist::min_value"));
+    EXPECT_EQ(5, file.value(first, "dist::max_value"));
+    EXPECT_EQ(8, file.value(first, "dist::sum"));
+    EXPECT_EQ(30, file.value(first, "dist::squares"));
+    EXPECT_EQ(0, file.value(first, "dist::underflows"));
+    EXPECT_EQ(1, file.value(first, "dist::overflows"));
+    EXPECT_EQ(1, file.value(first, "dist::0"));
+    EXPECT_EQ(1, file.value(first, "dist::1"));
+
+    const Dump &second = file.dumps[1];
+    EXPECT_EQ(0u, second.schema);
+    EXPECT_EQ(200u, second.tick);
+    EXPECT_EQ(7, file.value(second, "scalar"));
+    EXPECT_EQ(1, file.value(second, "vector::first"));
+    EXPECT_EQ(7, file.value(second, "vector::1"));
+    EXPECT_EQ(4, file.value(second, "dist::samples"));
+    EXPECT_EQ(0, file.value(second, "dist::min_value"));
+    EXPECT_EQ(2, file.value(second, "dist::0"));
+}
+
+TEST_F(ColumnarTest, DifferentStatsStartNewSchema)
+{
+    scalar = 1;
+    dump(100, allStats());
+    dump(200, { allStats()[0] });
+    dump(300, allStats());
+
+    ColumnarFile file = read();
+    ASSERT_EQ(2u, file.schemas.size());
+    ASSERT_EQ(3u, file.dumps.size());
+
+    // Going back to all the stats reuses the first schema
+    EXPECT_EQ(file.dumps[0].schema, file.dumps[2].schema);
+    EXPECT_NE(file.dumps[0].schema, file.dumps[1].schema);
+
+    const auto &names = file.schemas[file.dumps[1].schema];
+    ASSERT_EQ(1u, names.size());
+    EXPECT_EQ("scalar", names[0]);
+    EXPECT_EQ(1, file.value(file.dumps[1], "scalar"));
+    EXPECT_EQ(300u, file.dumps[2].tick);
+}
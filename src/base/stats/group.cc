@@ -39,6 +39,7 @@
 
 #include <cassert>
 
+#include "base/stats/arena.hh"
 #include "base/stats/info.hh"
 #include "base/trace.hh"
 #include "debug/Stats.hh"
@@ -81,8 +82,13 @@ Group::regStats()
 void
 Group::resetStats()
 {
-    for (auto &s : stats)
-        s->reset();
+    // Stats that reset to zero are cleared in bulk during a reset of
+    // all stats
+    const bool bulk = Arena::resetting();
+    for (auto &s : stats) {
+        if (!(bulk && s->zeroReset))
+            s->reset();
+    }
 
     for (auto &g : mergedStatGroups)
         g->resetStats();
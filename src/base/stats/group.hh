@@ -130,7 +130,9 @@ class Group
     virtual void regStats();
 
     /**
-     * Callback to reset stats.
+     * Callback to reset stats. Overrides have to call the resetStats()
+     * of their base class, a reset of all stats clears the stats of
+     * every group that reset to zero anyway (see Stats::Arena).
      *
      * @ingroup api_stats
      */
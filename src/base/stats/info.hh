@@ -90,6 +90,11 @@ class Info
 
   public:
     const StorageParams *storageParams;
+    /**
+     * The storage of this stat is in the zero reset part of the stats
+     * arena and is already reset by Arena::beginReset().
+     */
+    bool zeroReset;
 
   public:
     Info();
@@ -32,7 +32,12 @@
 #ifndef __BASE_TRACE_HH__
 #define __BASE_TRACE_HH__
 
+#include <cstdint>
+#include <cstring>
+#include <ostream>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 #include "base/cprintf.hh"
 #include "base/debug.hh"
@@ -42,6 +47,187 @@
 
 namespace Trace {
 
+/**
+ * Encoders for the arguments of a debug message, used by the loggers
+ * that keep messages unformatted (see Logger::logArgs).  Every argument
+ * is a one character type tag followed by its value in host byte order:
+ *
+ *   'i'/'u' <size:u8> <value:i64/u64>   signed/unsigned integers
+ *   'c' <value:i64>                      char types, printed as characters
+ *   'b' <value:u8>                       bool
+ *   'f' <value:f64>                      floating point
+ *   's' <len:u32> <bytes>                strings
+ *
+ * Types that only print through their own operator<< can't be encoded,
+ * the messages using them are formatted as usual instead.
+ */
+template <typename T, typename Enable = void>
+struct ArgEncoder
+{
+    static bool encode(std::string &buf, const T &arg) { return false; }
+};
+
+inline void
+encodeRaw(std::string &buf, const void *data, size_t len)
+{
+    buf.append(static_cast<const char *>(data), len);
+}
+
+inline void
+encodeString(std::string &buf, const char *str, uint32_t len)
+{
+    buf.push_back('s');
+    encodeRaw(buf, &len, sizeof(len));
+    encodeRaw(buf, str, len);
+}
+
+template <typename T>
+struct ArgEncoder<T,
+    typename std::enable_if<std::is_integral<T>::value>::type>
+{
+    static bool
+    encode(std::string &buf, const T &arg)
+    {
+        typedef typename std::conditional<std::is_signed<T>::value,
+                int64_t, uint64_t>::type Value;
+        const Value value = arg;
+        buf.push_back(std::is_signed<T>::value ? 'i' : 'u');
+        buf.push_back(sizeof(T));
+        encodeRaw(buf, &value, sizeof(value));
+        return true;
+    }
+};
+
+template <typename T>
+struct ArgEncoder<T,
+    typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+    static bool
+    encode(std::string &buf, const T &arg)
+    {
+        const double value = arg;
+        buf.push_back('f');
+        encodeRaw(buf, &value, sizeof(value));
+        return true;
+    }
+};
+
+namespace StreamCheck {
+
+struct NoStreamOperator { };
+
+// Worse match than an operator<< taking the type itself, which is found
+// by argument dependent lookup, but better than the conversion of an
+// unscoped enum to int for the operator<< of the stream.
+template <typename T>
+NoStreamOperator operator<<(std::ostream &os, const T &arg);
+
+// Only checked for enums, other types may not print at all.
+template <typename T, bool = std::is_enum<T>::value>
+struct HasStreamOperator : public std::false_type { };
+
+template <typename T>
+struct HasStreamOperator<T, true>
+{
+    static const bool value = !std::is_same<
+        decltype(std::declval<std::ostream &>() << std::declval<const T &>()),
+        NoStreamOperator>::value;
+};
+
+} // namespace StreamCheck
+
+// Unscoped enums without an operator<< of their own print as their
+// underlying integer. Other enums, e.g. the ones of SLICC, print their
+// names and are formatted as text.
+template <typename T>
+struct ArgEncoder<T,
+    typename std::enable_if<std::is_enum<T>::value &&
+        std::is_convertible<T, long long>::value &&
+        !StreamCheck::HasStreamOperator<T>::value>::type>
+{
+    static bool
+    encode(std::string &buf, const T &arg)
+    {
+        typedef typename std::underlying_type<T>::type Underlying;
+        return ArgEncoder<Underlying>::encode(buf, Underlying(arg));
+    }
+};
+
+template <typename T>
+struct CharArgEncoder
+{
+    static bool
+    encode(std::string &buf, const T &arg)
+    {
+        const int64_t value = arg;
+        buf.push_back('c');
+        encodeRaw(buf, &value, sizeof(value));
+        return true;
+    }
+};
+
+template <> struct ArgEncoder<char> : public CharArgEncoder<char> {};
+template <> struct ArgEncoder<signed char>
+    : public CharArgEncoder<signed char> {};
+template <> struct ArgEncoder<unsigned char>
+    : public CharArgEncoder<unsigned char> {};
+
+template <>
+struct ArgEncoder<bool>
+{
+    static bool
+    encode(std::string &buf, const bool &arg)
+    {
+        buf.push_back('b');
+        buf.push_back(arg);
+        return true;
+    }
+};
+
+template <>
+struct ArgEncoder<std::string>
+{
+    static bool
+    encode(std::string &buf, const std::string &arg)
+    {
+        encodeString(buf, arg.data(), arg.size());
+        return true;
+    }
+};
+
+template <>
+struct ArgEncoder<const char *>
+{
+    static bool
+    encode(std::string &buf, const char *arg)
+    {
+        if (!arg)
+            return false;
+        encodeString(buf, arg, std::strlen(arg));
+        return true;
+    }
+};
+
+template <>
+struct ArgEncoder<char *> : public ArgEncoder<const char *> {};
+
+inline bool
+encodeArgs(std::string &buf)
+{
+    return true;
+}
+
+/** Append the encoding of all the arguments to buf. Returns false if
+ *  one of them has no encoding. */
+template <typename T, typename ...Args>
+bool
+encodeArgs(std::string &buf, const T &arg, const Args &...args)
+{
+    // Decay arrays so that string literals are encoded as strings
+    typedef typename std::decay<T>::type Arg;
+    return ArgEncoder<Arg>::encode(buf, arg) && encodeArgs(buf, args...);
+}
+
 /** Debug logging base class.  Handles formatting and outputting
  *  time/name/message messages */
 class Logger
@@ -50,6 +236,19 @@ class Logger
     /** Name match for objects to ignore */
     ObjectMatch ignore;
 
+    /** Set by loggers that want the arguments of messages unformatted */
+    bool rawArgs = false;
+
+    /** Scratch buffer the arguments of a message are encoded into */
+    std::string argBuf;
+
+    /** Log a message with its arguments encoded by encodeArgs.  Only
+     *  called when rawArgs is set */
+    virtual void logArgs(Tick when, const std::string &name,
+            const std::string &flag, const char *fmt,
+            const std::string &args)
+    { }
+
   public:
     /** Log a single message */
     template <typename ...Args>
@@ -67,6 +266,13 @@ class Logger
     {
         if (!name.empty() && ignore.match(name))
             return;
+        if (rawArgs) {
+            argBuf.clear();
+            if (encodeArgs(argBuf, args...)) {
+                logArgs(when, name, flag, fmt, argBuf);
+                return;
+            }
+        }
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, flag, line.str());
@@ -93,6 +299,10 @@ class Logger
     /** Add objects to ignore */
     void addIgnore(const ObjectMatch &ignore_) { ignore.add(ignore_); }
 
+    /** Write out everything logged so far, e.g. before the simulator
+     *  exits on an error */
+    virtual void flush() { getOstream().flush(); }
+
     virtual ~Logger() { }
 };
 
@@ -168,7 +378,10 @@ class Named
 
 #if TRACING_ON
 
-#define DTRACE(x) (Debug::x)
+// Debug::Traced::x is a compile time constant that is false for the
+// flags left out of TRACE_FLAGS, so the compiler drops the check and the
+// arguments of their trace statements.
+#define DTRACE(x) (Debug::Traced::x && Debug::x)
 
 #define DDUMP(x, data, count) do {               \
     using namespace Debug;                       \
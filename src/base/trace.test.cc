@@ -0,0 +1,182 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include "base/cprintf.hh"
+#include "base/trace.hh"
+
+namespace
+{
+
+enum Plain { PlainZero, PlainThree = 3 };
+
+// Like the enums generated by SLICC
+enum Named { NamedNotPresent, NamedReadOnly };
+
+std::ostream &
+operator<<(std::ostream &os, const Named &named)
+{
+    return os << (named == NamedNotPresent ? "NotPresent" : "ReadOnly");
+}
+
+template <typename T>
+T
+take(const std::string &buf, size_t &pos)
+{
+    T value;
+    std::memcpy(&value, buf.data() + pos, sizeof(value));
+    pos += sizeof(value);
+    return value;
+}
+
+/** Format encoded arguments the way an offline decoder does */
+std::string
+decode(const char *fmt, const std::string &args)
+{
+    std::ostringstream os;
+    cp::Print print(os, fmt);
+    size_t pos = 0;
+    while (pos < args.size()) {
+        const char tag = args[pos++];
+        switch (tag) {
+          case 'i':
+          case 'u': {
+            const unsigned size = args[pos++];
+            const uint64_t value = take<uint64_t>(args, pos);
+            if (tag == 'i' && size == 4)
+                print.add_arg(int32_t(value));
+            else if (tag == 'i')
+                print.add_arg(int64_t(value));
+            else if (size == 4)
+                print.add_arg(uint32_t(value));
+            else
+                print.add_arg(value);
+            break;
+          }
+          case 'c':
+            print.add_arg(char(take<int64_t>(args, pos)));
+            break;
+          case 'b':
+            print.add_arg(bool(args[pos++]));
+            break;
+          case 'f':
+            print.add_arg(take<double>(args, pos));
+            break;
+          case 's': {
+            const uint32_t len = take<uint32_t>(args, pos);
+            print.add_arg(args.substr(pos, len));
+            pos += len;
+            break;
+          }
+          default:
+            ADD_FAILURE() << "Unknown argument tag " << tag;
+            return "";
+        }
+    }
+    print.end_args();
+    return os.str();
+}
+
+/** Logger keeping the last message, decoded if it was encoded */
+class TestLogger : public Trace::Logger
+{
+  public:
+    std::string message;
+    bool encoded = false;
+
+    TestLogger() { rawArgs = true; }
+
+    void
+    logMessage(Tick when, const std::string &name,
+               const std::string &flag, const std::string &msg) override
+    {
+        message = msg;
+        encoded = false;
+    }
+
+    std::ostream &getOstream() override { return stream; }
+
+  protected:
+    void
+    logArgs(Tick when, const std::string &name, const std::string &flag,
+            const char *fmt, const std::string &args) override
+    {
+        message = decode(fmt, args);
+        encoded = true;
+    }
+
+  private:
+    std::ostringstream stream;
+};
+
+} // anonymous namespace
+
+TEST(TraceTest, EncodeInteger)
+{
+    TestLogger logger;
+    logger.dprintf(0, "obj", "%x %#x %d\n", 0xdeadbeefu, -2, int64_t(-5));
+    EXPECT_TRUE(logger.encoded);
+    EXPECT_EQ(csprintf("%x %#x %d\n", 0xdeadbeefu, -2, int64_t(-5)),
+              logger.message);
+}
+
+TEST(TraceTest, EncodeString)
+{
+    TestLogger logger;
+    const std::string str("string");
+    logger.dprintf(0, "obj", "%s %10s %c\n", str, "literal", 'x');
+    EXPECT_TRUE(logger.encoded);
+    EXPECT_EQ(csprintf("%s %10s %c\n", str, "literal", 'x'),
+              logger.message);
+}
+
+TEST(TraceTest, EncodePlainEnum)
+{
+    TestLogger logger;
+    logger.dprintf(0, "obj", "%s %d\n", PlainThree, PlainZero);
+    EXPECT_TRUE(logger.encoded);
+    EXPECT_EQ(csprintf("%s %d\n", PlainThree, PlainZero), logger.message);
+}
+
+TEST(TraceTest, NamedEnumAsText)
+{
+    // Enums printing through their own operator<< are not encoded as
+    // integers, so that their names appear in the output.
+    std::string buf;
+    EXPECT_FALSE(Trace::encodeArgs(buf, NamedReadOnly));
+
+    TestLogger logger;
+    logger.dprintf(0, "obj", "%s %x %s\n", NamedNotPresent, 42u, "str");
+    EXPECT_FALSE(logger.encoded);
+    EXPECT_EQ(csprintf("%s %x %s\n", NamedNotPresent, 42u, "str"),
+              logger.message);
+    EXPECT_EQ("NotPresent 2a str\n", logger.message);
+}
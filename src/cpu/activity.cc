@@ -39,7 +39,7 @@ ActivityRecorder::ActivityRecorder(const string &name, int num_stages,
     int longest_latency, int activity)
     : _name(name), activityBuffer(longest_latency, 0),
       longestLatency(longest_latency), activityCount(activity),
-      numStages(num_stages)
+      inFlight(0), numStages(num_stages)
 {
     stageActive = new bool[numStages];
     std::memset(stageActive, 0, numStages);
@@ -62,6 +62,7 @@ ActivityRecorder::activity()
     activityBuffer[0] = true;
 
     ++activityCount;
+    ++inFlight;
 
     DPRINTF(Activity, "Activity: %i\n", activityCount);
 }
@@ -73,6 +74,7 @@ ActivityRecorder::advance()
     // time buffer advances, then decrement the activityCount.
     if (activityBuffer[-longestLatency]) {
         --activityCount;
+        --inFlight;
 
         assert(activityCount >= 0);
 
@@ -124,6 +126,7 @@ void
 ActivityRecorder::reset()
 {
     activityCount = 0;
+    inFlight = 0;
     std::memset(stageActive, 0, numStages);
     for (int i = 0; i < longestLatency + 1; ++i)
         activityBuffer.advance();
@@ -87,6 +87,11 @@ class ActivityRecorder
     /** Returns if the CPU should be active. */
     bool active() { return activityCount; }
 
+    /** Returns if there is no communication left in the time buffers,
+     *  so that only the stages that are active have anything to do.
+     */
+    bool quiet() const { return !inFlight; }
+
     /** Clears the time buffer and the activity count. */
     void reset();
 
@@ -128,6 +133,11 @@ class ActivityRecorder
      */
     int activityCount;
 
+    /** Number of cycles of the time buffer that have activity. This is
+     *  the part of activityCount that doesn't come from active stages.
+     */
+    int inFlight;
+
     /** Number of stages that can be marked as active or inactive. */
     int numStages;
 
@@ -0,0 +1,60 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/backdoor_cache.hh"
+
+#include <algorithm>
+
+const BackdoorCache::Entry *
+BackdoorCache::find(Addr addr) const
+{
+    for (const auto &e : entries) {
+        if (e.backdoor->range().contains(addr))
+            return &e;
+    }
+    return nullptr;
+}
+
+const BackdoorCache::Entry *
+BackdoorCache::add(MemBackdoorPtr backdoor, AbstractMemory *memory)
+{
+    // Every entry adds an invalidation callback, so a backdoor must not
+    // be added twice.
+    for (const auto &e : entries) {
+        if (e.backdoor == backdoor)
+            return &e;
+    }
+
+    backdoor->addInvalidationCallback(
+        [this](const MemBackdoor &bd) {
+            entries.erase(std::remove_if(entries.begin(), entries.end(),
+                              [&bd](const Entry &e) {
+                                  return e.backdoor == &bd;
+                              }),
+                          entries.end());
+        });
+    entries.push_back(Entry{backdoor, memory});
+    return &entries.back();
+}
@@ -0,0 +1,72 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_BACKDOOR_CACHE_HH__
+#define __CPU_BACKDOOR_CACHE_HH__
+
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/backdoor.hh"
+
+class AbstractMemory;
+
+/**
+ * The memory backdoors acquired by an object, each of them dropped as
+ * soon as it is invalidated.
+ */
+class BackdoorCache
+{
+  public:
+    struct Entry
+    {
+        MemBackdoorPtr backdoor;
+        AbstractMemory *memory;
+    };
+
+    BackdoorCache() = default;
+    BackdoorCache(const BackdoorCache &) = delete;
+    BackdoorCache &operator=(const BackdoorCache &) = delete;
+
+    /**
+     * Find the backdoor covering an address.
+     * @return The entry, or nullptr if there is none.
+     */
+    const Entry *find(Addr addr) const;
+
+    /**
+     * Add a backdoor to a memory, unless it has been added before.
+     * @return The entry of the backdoor.
+     */
+    const Entry *add(MemBackdoorPtr backdoor, AbstractMemory *memory);
+
+    /** Number of backdoors. */
+    size_t size() const { return entries.size(); }
+
+  private:
+    std::vector<Entry> entries;
+};
+
+#endif // __CPU_BACKDOOR_CACHE_HH__
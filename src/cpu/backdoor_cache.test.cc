@@ -0,0 +1,87 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "cpu/backdoor_cache.hh"
+
+TEST(BackdoorCacheTest, FindByAddress)
+{
+    uint8_t data[0x100];
+    MemBackdoor backdoor(AddrRange(0x1000, 0x1100), data,
+                         MemBackdoor::Readable);
+    BackdoorCache cache;
+
+    EXPECT_EQ(nullptr, cache.find(0x1000));
+    const BackdoorCache::Entry *entry = cache.add(&backdoor, nullptr);
+    EXPECT_EQ(&backdoor, entry->backdoor);
+    EXPECT_EQ(entry, cache.find(0x1000));
+    EXPECT_EQ(entry, cache.find(0x10ff));
+    EXPECT_EQ(nullptr, cache.find(0x1100));
+}
+
+TEST(BackdoorCacheTest, PartialOverlap)
+{
+    uint8_t data[0x100];
+    MemBackdoor backdoor(AddrRange(0x1000, 0x1100), data,
+                         MemBackdoor::Readable);
+    BackdoorCache cache;
+    const BackdoorCache::Entry *entry = cache.add(&backdoor, nullptr);
+
+    // An access straddling the end of the backdoor finds it for its
+    // first byte only, and asking the memory for a backdoor again
+    // returns the same one, which is not added a second time.
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(nullptr, cache.find(0x1100));
+        EXPECT_EQ(entry, cache.find(0x10fc));
+        EXPECT_EQ(entry, cache.add(&backdoor, nullptr));
+    }
+    EXPECT_EQ(1u, cache.size());
+}
+
+TEST(BackdoorCacheTest, Invalidation)
+{
+    uint8_t data[0x200];
+    MemBackdoor first(AddrRange(0x1000, 0x1100), data,
+                      MemBackdoor::Readable);
+    MemBackdoor second(AddrRange(0x1100, 0x1200), data + 0x100,
+                       MemBackdoor::Readable);
+    BackdoorCache cache;
+    cache.add(&first, nullptr);
+    cache.add(&second, nullptr);
+    EXPECT_EQ(2u, cache.size());
+
+    first.invalidate();
+    EXPECT_EQ(1u, cache.size());
+    EXPECT_EQ(nullptr, cache.find(0x1000));
+    EXPECT_NE(nullptr, cache.find(0x1100));
+
+    // An invalidated backdoor can be added again.
+    cache.add(&first, nullptr);
+    EXPECT_EQ(2u, cache.size());
+    EXPECT_NE(nullptr, cache.find(0x1000));
+}
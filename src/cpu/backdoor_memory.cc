@@ -0,0 +1,101 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/backdoor_memory.hh"
+
+#include <cstring>
+
+#include "base/trace.hh"
+#include "debug/BackdoorMemory.hh"
+#include "mem/abstract_mem.hh"
+#include "mem/physical.hh"
+#include "sim/system.hh"
+
+BackdoorMemory::BackdoorMemory(System *_system)
+    : system(_system)
+{
+}
+
+bool
+BackdoorMemory::canAccess(const RequestPtr &req) const
+{
+    return !req->isLocalAccess() && system->isMemAddr(req->getPaddr());
+}
+
+const BackdoorMemory::Entry *
+BackdoorMemory::find(Addr addr, Addr size)
+{
+    const Entry *entry = backdoors.find(addr);
+    if (!entry) {
+        AbstractMemory *memory = system->getPhysMem().findMemory(addr);
+        // the writes are reported to the memory, see access()
+        MemBackdoorPtr backdoor = memory ? memory->getBackdoor(true, true) :
+            nullptr;
+        if (!backdoor || !backdoor->readable() || !backdoor->writeable())
+            return nullptr;
+
+        DPRINTF(BackdoorMemory, "Accessing %s through a backdoor.\n",
+                backdoor->range().to_string());
+        entry = backdoors.add(backdoor, memory);
+    }
+
+    // An access past the end of the backdoor of its first byte is left
+    // to the memory.
+    const AddrRange &range = entry->backdoor->range();
+    if (range.contains(addr) && range.contains(addr + size - 1))
+        return entry;
+    return nullptr;
+}
+
+void
+BackdoorMemory::access(PacketPtr pkt)
+{
+    const RequestPtr &req = pkt->req;
+    const bool plain = (pkt->cmd == MemCmd::ReadReq ||
+                        pkt->cmd == MemCmd::WriteReq) &&
+        !req->isLLSC() && !req->isMasked();
+    const Entry *entry = plain ? find(pkt->getAddr(), pkt->getSize()) :
+        nullptr;
+
+    // A write has to clear the reservations of other threads, which
+    // the memory keeps track of.
+    if (!entry ||
+        (pkt->isWrite() && !entry->memory->getLockedAddrList().empty())) {
+        system->getPhysMem().access(pkt);
+        return;
+    }
+
+    uint8_t *host = entry->backdoor->ptr() +
+        (pkt->getAddr() - entry->backdoor->range().start());
+    if (pkt->isRead()) {
+        std::memcpy(pkt->getPtr<uint8_t>(), host, pkt->getSize());
+    } else {
+        std::memcpy(host, pkt->getConstPtr<uint8_t>(), pkt->getSize());
+        entry->memory->markDirty(pkt->getAddr(), pkt->getSize());
+    }
+
+    if (pkt->needsResponse())
+        pkt->makeResponse();
+}
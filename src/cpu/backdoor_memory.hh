@@ -0,0 +1,80 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_BACKDOOR_MEMORY_HH__
+#define __CPU_BACKDOOR_MEMORY_HH__
+
+#include "base/types.hh"
+#include "cpu/backdoor_cache.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+
+class System;
+
+/**
+ * Functional access to the memories of a system on behalf of a timing
+ * CPU, for a "functional-warm" mode in which the CPU keeps modelling
+ * its own pipeline but charges fixed latencies for memory accesses
+ * instead of sending them through the memory system.
+ *
+ * Plain reads and writes are served through memory backdoors, which
+ * are cached here. Everything else, e.g. load-linked/store-conditional
+ * pairs, swaps and atomics, and writes to memories with outstanding
+ * locked addresses, is handed to the memory itself so that its
+ * semantics are kept. In both cases the accesses bypass any caches and
+ * snooping, so all the agents that may cache the memory of the system
+ * have to use this mode for it to stay coherent.
+ */
+class BackdoorMemory
+{
+  protected:
+    typedef BackdoorCache::Entry Entry;
+
+    System *system;
+
+    /** Backdoors acquired so far. */
+    BackdoorCache backdoors;
+
+    /**
+     * Find the backdoor covering a range of addresses, asking the
+     * memory for one if there is none yet.
+     * @return The entry, or nullptr if there is no backdoor.
+     */
+    const Entry *find(Addr addr, Addr size);
+
+  public:
+    BackdoorMemory(System *system);
+
+    /** Check whether a request can be served by this object. */
+    bool canAccess(const RequestPtr &req) const;
+
+    /**
+     * Perform an access, turning the packet into a response if it
+     * needs one.
+     */
+    void access(PacketPtr pkt);
+};
+
+#endif // __CPU_BACKDOOR_MEMORY_HH__
@@ -47,6 +47,7 @@
 #include <sstream>
 #include <string>
 
+#include "arch/decoder.hh"
 #include "arch/generic/tlb.hh"
 #include "base/cprintf.hh"
 #include "base/loader/symtab.hh"
@@ -247,7 +248,7 @@ BaseCPU::mwaitAtomic(ThreadID tid, ThreadContext *tc, BaseTLB *dtb)
     assert(tid < numThreads);
     AddressMonitor &monitor = addressMonitor[tid];
 
-    RequestPtr req = std::make_shared<Request>();
+    RequestPtr req = Request::create();
 
     Addr addr = monitor.vAddr;
     int block_size = cacheLineSize();
@@ -411,6 +412,15 @@ BaseCPU::regStats()
         }
     } else if (size == 1)
         threadContexts[0]->regStats(name());
+
+    for (int i = 0; i < size; ++i) {
+        DecodeCache::CacheStats &stats =
+            threadContexts[i]->getDecoderPtr()->cacheStats;
+        if (size > 1)
+            stats.regStats(csprintf("%s.ctx%d", name(), i));
+        else
+            stats.regStats(name());
+    }
 }
 
 Port &
@@ -237,7 +237,7 @@ Checker<Impl>::verify(const DynInstPtr &completed_inst)
             // If not in the middle of a macro instruction
             if (!curMacroStaticInst) {
                 // set up memory request for instruction fetch
-                auto mem_req = std::make_shared<Request>(
+                auto mem_req = Request::create(
                     fetch_PC, sizeof(MachInst), 0, masterId, fetch_PC,
                     thread->contextId());
 
@@ -29,10 +29,15 @@
 #ifndef __CPU_DECODE_CACHE_HH__
 #define __CPU_DECODE_CACHE_HH__
 
-#include <unordered_map>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "arch/isa_traits.hh"
 #include "arch/types.hh"
+#include "base/flat_hash_map.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
 #include "config/the_isa.hh"
 #include "cpu/static_inst_fwd.hh"
 
@@ -44,9 +49,23 @@ namespace TheISA
 namespace DecodeCache
 {
 
+/// Hit and miss counts of the decode caches used by a decoder. Most
+/// of the caches are shared by all decoders, their counts are not. The
+/// CPU owning the decoder registers these with its own stats.
+struct CacheStats
+{
+    /// Decodes served from a decode cache.
+    Stats::Scalar hits;
+    /// Decodes that had to run the decoder.
+    Stats::Scalar misses;
+    Stats::Formula hitRate;
+
+    void regStats(const std::string &name);
+};
+
 /// Hash for decoded instructions.
 template <typename EMI>
-using InstMap = std::unordered_map<EMI, StaticInstPtr>;
+using InstMap = FlatHashMap<EMI, StaticInstPtr>;
 
 /// A sparse map from an Addr to a Value, stored in page chunks.
 template<class Value>
@@ -58,22 +77,19 @@ class AddrMap
         Value items[TheISA::PageBytes];
     };
     // A map of cache pages which allows a sparse mapping.
-    typedef typename std::unordered_map<Addr, CachePage *> PageMap;
-    typedef typename PageMap::iterator PageIt;
-    // Mini cache of recent lookups.
-    PageIt recent[2];
-    PageMap pageMap;
-
-    /// Update the mini cache of recent lookups.
-    /// @param recentest The most recent result;
-    void
-    update(PageIt recentest)
-    {
-        recent[1] = recent[0];
-        recent[0] = recentest;
-    }
+    FlatHashMap<Addr, CachePage *> pageMap;
+    // Owner of all the pages in the map.
+    std::vector<std::unique_ptr<CachePage>> pages;
+
+    // Direct-mapped cache of recent lookups, indexed by page number.
+    static const unsigned FrontEntries = 16;
+    struct FrontEntry {
+        Addr pageAddr;
+        CachePage *page;
+    };
+    FrontEntry front[FrontEntries];
 
-    /// Attempt to find the CacheePage which goes with a particular
+    /// Attempt to find the CachePage which goes with a particular
     /// address. First check the small cache of recent results, then
     /// actually look in the hash map.
     /// @param addr The address to look up.
@@ -83,37 +99,29 @@ class AddrMap
         Addr page_addr = addr & ~(TheISA::PageBytes - 1);
 
         // Check against recent lookups.
-        if (recent[0] != pageMap.end()) {
-            if (recent[0]->first == page_addr)
-                return recent[0]->second;
-            if (recent[1] != pageMap.end() &&
-                    recent[1]->first == page_addr) {
-                update(recent[1]);
-                // recent[1] has just become recent[0].
-                return recent[0]->second;
-            }
-        }
-
-        // Actually look in the has_map.
-        PageIt it = pageMap.find(page_addr);
-        if (it != pageMap.end()) {
-            update(it);
-            return it->second;
+        FrontEntry &entry =
+            front[(page_addr / TheISA::PageBytes) % FrontEntries];
+        if (entry.page && entry.pageAddr == page_addr)
+            return entry.page;
+
+        // Actually look in the hash map, or add a new page.
+        CachePage *&page = pageMap[page_addr];
+        if (!page) {
+            pages.emplace_back(new CachePage);
+            page = pages.back().get();
         }
 
-        // Didn't find an existing page, so add a new one.
-        CachePage *newPage = new CachePage;
-        page_addr = page_addr & ~(TheISA::PageBytes - 1);
-        typename PageMap::value_type to_insert(page_addr, newPage);
-        update(pageMap.insert(to_insert).first);
-        return newPage;
+        entry.pageAddr = page_addr;
+        entry.page = page;
+        return page;
     }
 
   public:
     /// Constructor
     AddrMap()
     {
-        recent[0] = recent[1] = pageMap.end();
+        for (auto &entry : front)
+            entry = FrontEntry{0, nullptr};
     }
 
     Value &
@@ -64,22 +64,22 @@ Trace::ExeTracerRecord::traceInst(const StaticInstPtr &inst, bool ran)
 {
     std::stringstream outs;
 
-    if (!Debug::ExecUser || !Debug::ExecKernel) {
+    if (!DTRACE(ExecUser) || !DTRACE(ExecKernel)) {
         bool in_user_mode = TheISA::inUserMode(thread);
-        if (in_user_mode && !Debug::ExecUser) return;
-        if (!in_user_mode && !Debug::ExecKernel) return;
+        if (in_user_mode && !DTRACE(ExecUser)) return;
+        if (!in_user_mode && !DTRACE(ExecKernel)) return;
     }
 
-    if (Debug::ExecAsid)
+    if (DTRACE(ExecAsid))
         outs << "A" << dec << TheISA::getExecutingAsid(thread) << " ";
 
-    if (Debug::ExecThread)
+    if (DTRACE(ExecThread))
         outs << "T" << thread->threadId() << " : ";
 
     std::string sym_str;
     Addr sym_addr;
     Addr cur_pc = pc.instAddr();
-    if (Loader::debugSymbolTable && Debug::ExecSymbol &&
+    if (Loader::debugSymbolTable && DTRACE(ExecSymbol) &&
             (!FullSystem || !inUserMode(thread)) &&
             Loader::debugSymbolTable->findNearestSymbol(
                 cur_pc, sym_str, sym_addr)) {
@@ -108,15 +108,15 @@ Trace::ExeTracerRecord::traceInst(const StaticInstPtr &inst, bool ran)
     if (ran) {
         outs << " : ";
 
-        if (Debug::ExecOpClass) {
+        if (DTRACE(ExecOpClass)) {
             outs << Enums::OpClassStrings[inst->opClass()] << " : ";
         }
 
-        if (Debug::ExecResult && !predicate) {
+        if (DTRACE(ExecResult) && !predicate) {
             outs << "Predicated False";
         }
 
-        if (Debug::ExecResult && data_status != DataInvalid) {
+        if (DTRACE(ExecResult) && data_status != DataInvalid) {
             switch (data_status) {
               case DataVec:
                 {
@@ -151,16 +151,16 @@ Trace::ExeTracerRecord::traceInst(const StaticInstPtr &inst, bool ran)
             }
         }
 
-        if (Debug::ExecEffAddr && getMemValid())
+        if (DTRACE(ExecEffAddr) && getMemValid())
             outs << " A=0x" << hex << addr;
 
-        if (Debug::ExecFetchSeq && fetch_seq_valid)
+        if (DTRACE(ExecFetchSeq) && fetch_seq_valid)
             outs << "  FetchSeq=" << dec << fetch_seq;
 
-        if (Debug::ExecCPSeq && cp_seq_valid)
+        if (DTRACE(ExecCPSeq) && cp_seq_valid)
             outs << "  CPSeq=" << dec << cp_seq;
 
-        if (Debug::ExecFlags) {
+        if (DTRACE(ExecFlags)) {
             outs << "  flags=(";
             inst->printFlags(outs, "|");
             outs << ")";
@@ -188,14 +188,14 @@ Trace::ExeTracerRecord::dump()
      * finishes. Macroops then behave like regular instructions and don't
      * complete/print when they fault.
      */
-    if (Debug::ExecMacro && staticInst->isMicroop() &&
-        ((Debug::ExecMicro &&
+    if (DTRACE(ExecMacro) && staticInst->isMicroop() &&
+        ((DTRACE(ExecMicro) &&
             macroStaticInst && staticInst->isFirstMicroop()) ||
-            (!Debug::ExecMicro &&
+            (!DTRACE(ExecMicro) &&
              macroStaticInst && staticInst->isLastMicroop()))) {
         traceInst(macroStaticInst, false);
     }
-    if (Debug::ExecMicro || !staticInst->isMicroop()) {
+    if (DTRACE(ExecMicro) || !staticInst->isMicroop()) {
         traceInst(staticInst, true);
     }
 }
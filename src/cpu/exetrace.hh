@@ -68,7 +68,7 @@ class ExeTracer : public InstTracer
             const StaticInstPtr staticInst, TheISA::PCState pc,
             const StaticInstPtr macroStaticInst = NULL)
     {
-        if (!Debug::ExecEnable)
+        if (!DTRACE(ExecEnable))
             return NULL;
 
         return new ExeTracerRecord(when, tc,
@@ -39,6 +39,7 @@
 
 #include "base/callback.hh"
 #include "base/output.hh"
+#include "base/trace.hh"
 #include "config/the_isa.hh"
 #include "cpu/static_inst.hh"
 #include "cpu/thread_context.hh"
@@ -122,7 +123,7 @@ InstPBTrace::getInstRecord(Tick when, ThreadContext *tc, const StaticInstPtr si,
                            TheISA::PCState pc, const StaticInstPtr mi)
 {
     // Only record the trace if Exec debugging is enabled
-    if (!Debug::ExecEnable)
+    if (!DTRACE(ExecEnable))
         return NULL;
 
     return new InstPBTraceRecord(*this, when, tc, si, pc, mi);
@@ -65,7 +65,7 @@ class IntelTrace : public InstTracer
             const StaticInstPtr staticInst, TheISA::PCState pc,
             const StaticInstPtr macroStaticInst = NULL)
     {
-        if (!Debug::ExecEnable)
+        if (!DTRACE(ExecEnable))
             return NULL;
 
         return new IntelTraceRecord(when, tc, staticInst, pc, macroStaticInst);
@@ -364,6 +364,9 @@ KvmVM::delayedStartup()
                       "a KVM VM.\n");
             }
 
+            // the guest writes to the region without us noticing
+            memories[slot].dirtyPages->disableTracking();
+
             const MemSlot slot = allocMemSlot(range.size());
             setupMemSlot(slot, pmem, range.start(), 0/* flags */);
         } else {
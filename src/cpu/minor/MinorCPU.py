@@ -212,6 +212,8 @@ class MinorCPU(BaseCPU):
     fetch1ToFetch2BackwardDelay = Param.Cycles(1,
         "Backward cycle delay from Fetch2 to Fetch1 for branch prediction"
         " signalling (0 means in the same cycle, 1 mean the next cycle)")
+    fetch1FunctionalWarmLatency = Param.Cycles(1,
+        "Latency of a line fetch in functional-warm mode")
 
     fetch2InputBufferSize = Param.Unsigned(2,
         "Size of input buffer to Fetch2 in cycles-worth of insts.")
@@ -261,6 +263,8 @@ class MinorCPU(BaseCPU):
         "Size of LSQ transfers queue (memory transaction queue)")
     executeLSQStoreBufferSize = Param.Unsigned(5,
         "Size of LSQ store buffer")
+    executeFunctionalWarmLatency = Param.Cycles(2,
+        "Latency of a data memory access in functional-warm mode")
     executeBranchDelay = Param.Cycles(1,
         "Delay from Execute deciding to branch and Fetch1 reacting"
         " (1 means next cycle)")
@@ -280,6 +284,10 @@ class MinorCPU(BaseCPU):
     enableIdling = Param.Bool(True,
         "Enable cycle skipping when the processor is idle\n");
 
+    functionalWarm = Param.Bool(False,
+        "Serve fetches and data accesses through memory backdoors instead"
+        " of the memory system, charging fixed latencies")
+
     branchPred = Param.BranchPredictor(TournamentBP(
         numThreads = Parent.numThreads), "Branch Predictor")
 
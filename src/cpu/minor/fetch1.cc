@@ -74,7 +74,10 @@ Fetch1::Fetch1(const std::string &name_,
     icacheState(IcacheRunning),
     lineSeqNum(InstId::firstLineSeqNum),
     numFetchesInMemorySystem(0),
-    numFetchesInITLB(0)
+    numFetchesInITLB(0),
+    warmMemory(params.functionalWarm ?
+        new BackdoorMemory(params.system) : nullptr),
+    warmLatency(params.fetch1FunctionalWarmLatency)
 {
     if (lineSnap == 0) {
         lineSnap = cpu.cacheLineSize();
@@ -322,7 +325,7 @@ Fetch1::tryToSend(FetchRequestPtr request)
 {
     bool ret = false;
 
-    if (icachePort.sendTimingReq(request->packet)) {
+    if (sendToMemory(request->packet)) {
         /* Invalidate the fetch_requests packet so we don't
          *  accidentally fail to deallocate it (or use it!)
          *  later by overwriting it */
@@ -345,6 +348,21 @@ Fetch1::tryToSend(FetchRequestPtr request)
     return ret;
 }
 
+bool
+Fetch1::sendToMemory(PacketPtr packet)
+{
+    if (!warmMemory || !warmMemory->canAccess(packet->req))
+        return icachePort.sendTimingReq(packet);
+
+    warmMemory->access(packet);
+    cpu.schedule(new EventFunctionWrapper(
+            [this, packet]{ recvTimingResp(packet); },
+            name() + ".warmResponseEvent", true),
+        cpu.clockEdge(warmLatency));
+
+    return true;
+}
+
 void
 Fetch1::stepQueues()
 {
@@ -45,6 +45,9 @@
 #ifndef __CPU_MINOR_FETCH1_HH__
 #define __CPU_MINOR_FETCH1_HH__
 
+#include <memory>
+
+#include "cpu/backdoor_memory.hh"
 #include "cpu/minor/buffers.hh"
 #include "cpu/minor/cpu.hh"
 #include "cpu/minor/pipe_data.hh"
@@ -175,7 +178,7 @@ class Fetch1 : public Named
             pc(pc_),
             fault(NoFault)
         {
-            request = std::make_shared<Request>();
+            request = Request::create();
         }
 
         ~FetchRequest();
@@ -315,6 +318,11 @@ class Fetch1 : public Named
      *  transfers queue */
     unsigned int numFetchesInITLB;
 
+    /** Fetches in functional-warm mode, if enabled */
+    std::unique_ptr<BackdoorMemory> warmMemory;
+    /** Latency of a fetch in functional-warm mode */
+    const Cycles warmLatency;
+
   protected:
     friend std::ostream &operator <<(std::ostream &os,
         Fetch1::FetchState state);
@@ -354,6 +362,11 @@ class Fetch1 : public Named
      *  sent to memory */
     bool tryToSend(FetchRequestPtr request);
 
+    /** Send a packet to the memory system or, in functional-warm mode,
+     *  perform it functionally and deliver the response after
+     *  warmLatency.  Returns true if the packet was accepted */
+    bool sendToMemory(PacketPtr packet);
+
     /** Move a request between queues */
     void moveFromRequestsToTransfers(FetchRequestPtr request);
 
@@ -68,7 +68,7 @@ LSQ::LSQRequest::LSQRequest(LSQ &port_, MinorDynInstPtr inst_, bool isLoad_,
     isTranslationDelayed(false),
     state(NotIssued)
 {
-    request = std::make_shared<Request>();
+    request = Request::create();
 }
 
 void
@@ -491,7 +491,7 @@ LSQ::SplitDataRequest::makeFragmentRequests()
             }
         }
 
-        RequestPtr fragment = std::make_shared<Request>();
+        RequestPtr fragment = Request::create();
         bool disabled_fragment = false;
 
         fragment->setContext(request->contextId());
@@ -1205,7 +1205,7 @@ LSQ::tryToSend(LSQRequestPtr request)
                 request->setState(LSQRequest::Complete);
             else
                 request->setState(LSQRequest::RequestIssuing);
-        } else if (dcachePort.sendTimingReq(packet)) {
+        } else if (sendToMemory(packet)) {
             DPRINTF(MinorMem, "Sent data memory request\n");
 
             numAccessesInMemorySystem++;
@@ -1261,6 +1261,21 @@ LSQ::tryToSend(LSQRequestPtr request)
     return ret;
 }
 
+bool
+LSQ::sendToMemory(PacketPtr packet)
+{
+    if (!warmMemory || !warmMemory->canAccess(packet->req))
+        return dcachePort.sendTimingReq(packet);
+
+    warmMemory->access(packet);
+    cpu.schedule(new EventFunctionWrapper(
+            [this, packet]{ recvTimingResp(packet); },
+            name() + ".warmResponseEvent", true),
+        cpu.clockEdge(warmLatency));
+
+    return true;
+}
+
 void
 LSQ::moveFromRequestsToTransfers(LSQRequestPtr request)
 {
@@ -1397,7 +1412,8 @@ LSQ::LSQ(std::string name_, std::string dcache_port_name_,
     unsigned int in_memory_system_limit, unsigned int line_width,
     unsigned int requests_queue_size, unsigned int transfers_queue_size,
     unsigned int store_buffer_size,
-    unsigned int store_buffer_cycle_store_limit) :
+    unsigned int store_buffer_cycle_store_limit,
+    bool functional_warm, Cycles functional_warm_latency) :
     Named(name_),
     cpu(cpu_),
     execute(execute_),
@@ -1415,7 +1431,9 @@ LSQ::LSQ(std::string name_, std::string dcache_port_name_,
     numStoresInTransfers(0),
     numAccessesIssuedToMemory(0),
     retryRequest(NULL),
-    cacheBlockMask(~(cpu_.cacheLineSize() - 1))
+    cacheBlockMask(~(cpu_.cacheLineSize() - 1)),
+    warmMemory(functional_warm ? new BackdoorMemory(cpu_.system) : nullptr),
+    warmLatency(functional_warm_latency)
 {
     if (in_memory_system_limit < 1) {
         fatal("%s: executeMaxAccessesInMemory must be >= 1 (%d)\n", name_,
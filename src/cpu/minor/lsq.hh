@@ -45,6 +45,9 @@
 #ifndef __CPU_MINOR_NEW_LSQ_HH__
 #define __CPU_MINOR_NEW_LSQ_HH__
 
+#include <memory>
+
+#include "cpu/backdoor_memory.hh"
 #include "cpu/minor/buffers.hh"
 #include "cpu/minor/cpu.hh"
 #include "cpu/minor/pipe_data.hh"
@@ -613,6 +616,11 @@ class LSQ : public Named
     /** Address Mask for a cache block (e.g. ~(cache_block_size-1)) */
     Addr cacheBlockMask;
 
+    /** Accesses in functional-warm mode, if enabled */
+    std::unique_ptr<BackdoorMemory> warmMemory;
+    /** Latency of an access in functional-warm mode */
+    const Cycles warmLatency;
+
   protected:
     /** Try and issue a memory access for a translated request at the
      *  head of the requests queue.  Also tries to move the request
@@ -624,6 +632,11 @@ class LSQ : public Named
      *  sent to memory (and was also the last packet in a transfer) */
     bool tryToSend(LSQRequestPtr request);
 
+    /** Send a packet to the memory system or, in functional-warm mode,
+     *  perform it functionally and deliver the response after
+     *  warmLatency.  Returns true if the packet was accepted */
+    bool sendToMemory(PacketPtr packet);
+
     /** Clear a barrier (if it's the last one marked up in lastMemBarrier) */
     void clearMemBarrier(MinorDynInstPtr inst);
 
@@ -642,7 +655,8 @@ class LSQ : public Named
         unsigned int max_accesses_in_memory_system, unsigned int line_width,
         unsigned int requests_queue_size, unsigned int transfers_queue_size,
         unsigned int store_buffer_size,
-        unsigned int store_buffer_cycle_store_limit);
+        unsigned int store_buffer_cycle_store_limit,
+        bool functional_warm, Cycles functional_warm_latency);
 
     virtual ~LSQ();
 
@@ -73,6 +73,10 @@ class DerivO3CPU(BaseCPU):
         return True
 
     activity = Param.Unsigned(0, "Initial count")
+    skipIdleStageTicks = Param.Bool(False, "Don't tick the pipeline stages "
+          "that have no work while no communication is in flight, and stop "
+          "ticking the CPU when no stage has any. The stats are kept as if "
+          "they ticked. Only for a single thread in SE mode")
 
     cacheStorePorts = Param.Unsigned(200, "Cache Ports. "
           "Constrains stores only.")
@@ -208,6 +208,17 @@ class DefaultCommit
     /** Ticks the commit stage, which tries to commit instructions. */
     void tick();
 
+    /** Checks that an inactive commit has nothing left to do on its own,
+     * e.g., telling IEW that the ROB is empty, so that the CPU can skip
+     * its ticks.
+     */
+    bool canSkipTick() const;
+
+    /** Counts ticks that the CPU skipped while commit was quiescent in
+     * the per-cycle stats and probes, as tick() would have.
+     */
+    void skipTicks(Counter ticks);
+
     /** Handles any squashes that are sent from IEW, and adds instructions
      * to the ROB and tries to commit instructions.
      */
@@ -728,6 +728,41 @@ DefaultCommit<Impl>::tick()
     updateStatus();
 }
 
+template <class Impl>
+bool
+DefaultCommit<Impl>::canSkipTick() const
+{
+    for (auto tid : *activeThreads) {
+        if (checkEmptyROB[tid] || trapSquash[tid] || tcSquash[tid] ||
+            commitStatus[tid] == SquashAfterPending) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <class Impl>
+void
+DefaultCommit<Impl>::skipTicks(Counter ticks)
+{
+    if (activeThreads->empty())
+        return;
+
+    // Nothing is ready to commit while commit is quiescent, each tick
+    // would have found the same instruction stalled at the head of the
+    // ROB.
+    for (auto tid : *activeThreads) {
+        if (!rob->isEmpty(tid)) {
+            const DynInstPtr &inst = rob->readHeadInst(tid);
+            for (Counter i = 0; i < ticks; ++i)
+                ppCommitStall->notify(inst);
+        }
+    }
+
+    numCommittedDist.sample(0, ticks);
+}
+
 template <class Impl>
 void
 DefaultCommit<Impl>::handleInterrupt()
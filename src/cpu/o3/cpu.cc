@@ -42,6 +42,8 @@
 
 #include "cpu/o3/cpu.hh"
 
+#include <algorithm>
+
 #include "arch/generic/traits.hh"
 #include "arch/kernel_stats.hh"
 #include "config/the_isa.hh"
@@ -126,6 +128,8 @@ FullO3CPU<Impl>::FullO3CPU(DerivO3CPUParams *params)
       activityRec(name(), NumStages,
                   params->backComSize + params->forwardComSize,
                   params->activity),
+      skipIdleStageTicks(params->skipIdleStageTicks),
+      quiescentSleep(false),
 
       globalSeqNum(1),
       system(params->system),
@@ -137,6 +141,14 @@ FullO3CPU<Impl>::FullO3CPU(DerivO3CPUParams *params)
         _status = SwitchedOut;
     }
 
+    std::fill(stageQuiescent, stageQuiescent + NumStages, false);
+
+    // The stats of the skipped ticks are only replayed for a single
+    // thread, and the stages don't notice interrupts while skipped
+    fatal_if(skipIdleStageTicks && (numThreads > 1 || FullSystem),
+             "%s: skipIdleStageTicks needs a single thread and SE mode.\n",
+             name());
+
     if (params->checker) {
         BaseCPU *temp_checker = params->checker;
         checker = dynamic_cast<Checker<Impl> *>(temp_checker);
@@ -400,6 +412,19 @@ FullO3CPU<Impl>::regStats()
               "to idling")
         .prereq(idleCycles);
 
+    skippedStageTicks
+        .init(NumStages)
+        .name(name() + ".skippedStageTicks")
+        .desc("Number of ticks of each stage skipped because every stage "
+              "or the stage itself had nothing to do")
+        .flags(Stats::total)
+        .prereq(skippedStageTicks);
+    skippedStageTicks.subname(FetchIdx, "fetch");
+    skippedStageTicks.subname(DecodeIdx, "decode");
+    skippedStageTicks.subname(RenameIdx, "rename");
+    skippedStageTicks.subname(IEWIdx, "iew");
+    skippedStageTicks.subname(CommitIdx, "commit");
+
     quiesceCycles
         .name(name() + ".quiesceCycles")
         .desc("Total number of cycles that CPU has spent quiesced or waiting "
@@ -527,16 +552,33 @@ FullO3CPU<Impl>::tick()
 
 //    activity = false;
 
-    //Tick each of the stages
-    fetch.tick();
+    //Tick each of the stages that have something to do
+    int skipped = 0;
 
-    decode.tick();
+    if (skipStage(FetchIdx))
+        ++skipped;
+    else
+        fetch.tick();
 
-    rename.tick();
+    if (skipStage(DecodeIdx))
+        ++skipped;
+    else
+        decode.tick();
 
-    iew.tick();
+    if (skipStage(RenameIdx))
+        ++skipped;
+    else
+        rename.tick();
 
-    commit.tick();
+    if (skipStage(IEWIdx))
+        ++skipped;
+    else
+        iew.tick();
+
+    if (skipStage(CommitIdx))
+        ++skipped;
+    else
+        commit.tick();
 
     // Now advance the time buffers
     timeBuffer.advance();
@@ -561,6 +603,15 @@ FullO3CPU<Impl>::tick()
             DPRINTF(O3CPU, "Idle!\n");
             lastRunningCycle = curCycle();
             timesIdled++;
+        } else if (skipped == NumStages) {
+            // Only the activity count set by the activity parameter is
+            // left. Nothing changes until something calls wakeCPU(): a
+            // functional unit or the LSQ completing, a cache response,
+            // or a thread activation. The time buffers are empty, or
+            // some stage would not be quiescent.
+            DPRINTF(O3CPU, "Every stage is quiescent!\n");
+            lastRunningCycle = curCycle();
+            quiescentSleep = true;
         } else {
             schedule(tickEvent, clockEdge(Cycles(1)));
             DPRINTF(O3CPU, "Scheduling next tick!\n");
@@ -573,6 +624,76 @@ FullO3CPU<Impl>::tick()
     tryDrain();
 }
 
+template <class Impl>
+bool
+FullO3CPU<Impl>::skipStage(StageIdx idx)
+{
+    if (!skipIdleStageTicks)
+        return false;
+
+    // Rename and commit may still have work left once they are inactive
+    if (activityRec.getStageActive(idx) || !activityRec.quiet() ||
+        (idx == RenameIdx && !rename.canSkipTick()) ||
+        (idx == CommitIdx && !commit.canSkipTick())) {
+        stageQuiescent[idx] = false;
+        return false;
+    }
+
+    // Tick the stage once after it goes idle, as it may still update
+    // its status without any input, e.g. unblock a thread.
+    if (!stageQuiescent[idx]) {
+        stageQuiescent[idx] = true;
+        return false;
+    }
+
+    skipStageTicks(idx, 1);
+    return true;
+}
+
+template <class Impl>
+void
+FullO3CPU<Impl>::skipStageTicks(StageIdx idx, Counter ticks)
+{
+    switch (idx) {
+      case FetchIdx:
+        fetch.skipTicks(ticks);
+        break;
+      case DecodeIdx:
+        decode.skipTicks(ticks);
+        break;
+      case RenameIdx:
+        rename.skipTicks(ticks);
+        break;
+      case IEWIdx:
+        iew.skipTicks(ticks);
+        break;
+      case CommitIdx:
+        commit.skipTicks(ticks);
+        break;
+      default:
+        panic("Unknown stage %d\n", idx);
+    }
+
+    skippedStageTicks[idx] += ticks;
+}
+
+template <class Impl>
+void
+FullO3CPU<Impl>::wakeFromQuiescentSleep()
+{
+    quiescentSleep = false;
+
+    // The CPU would have kept ticking, and skipping, every stage in
+    // the cycles between its last tick and the one it wakes up for
+    Cycles cycles(curCycle() - lastRunningCycle);
+    if (cycles > 1) {
+        --cycles;
+        numCycles += cycles;
+        for (int idx = 0; idx < NumStages; ++idx)
+            skipStageTicks(StageIdx(idx), cycles);
+    }
+}
+
 template <class Impl>
 void
 FullO3CPU<Impl>::init()
@@ -1000,6 +1121,11 @@ FullO3CPU<Impl>::drain()
         if (tickEvent.scheduled())
             deschedule(tickEvent);
 
+        // Account for the stage ticks skipped so far, the CPU won't tick
+        // again before it resumes
+        if (quiescentSleep)
+            wakeFromQuiescentSleep();
+
         // Flush out any old data from the time buffers.  In
         // particular, there might be some data in flight from the
         // fetch stage that isn't visible in any of the CPU buffers we
@@ -1129,6 +1255,8 @@ FullO3CPU<Impl>::switchOut()
     BaseCPU::switchOut();
 
     activityRec.reset();
+    std::fill(stageQuiescent, stageQuiescent + NumStages, false);
+    quiescentSleep = false;
 
     _status = SwitchedOut;
 
@@ -1505,12 +1633,10 @@ FullO3CPU<Impl>::squashFromTC(ThreadID tid)
 }
 
 template <class Impl>
-typename FullO3CPU<Impl>::ListIt
+void
 FullO3CPU<Impl>::addInst(const DynInstPtr &inst)
 {
-    instList.push_back(inst);
-
-    return --(instList.end());
+    instList.push_back(inst.get());
 }
 
 template <class Impl>
@@ -1545,7 +1671,7 @@ FullO3CPU<Impl>::removeFrontInst(const DynInstPtr &inst)
     removeInstsThisCycle = true;
 
     // Remove the front instruction.
-    removeList.push(inst->getInstListIt());
+    removeList.push(instList.iteratorTo(inst.get()));
 }
 
 template <class Impl>
@@ -1566,7 +1692,7 @@ FullO3CPU<Impl>::removeInstsNotInROB(ThreadID tid)
         end_it = instList.begin();
         rob_empty = true;
     } else {
-        end_it = (rob.readTailInst(tid))->getInstListIt();
+        end_it = instList.iteratorTo(rob.readTailInst(tid).get());
         DPRINTF(O3CPU, "ROB is not empty, squashing insts not in ROB.\n");
     }
 
@@ -1701,19 +1827,33 @@ template <class Impl>
 void
 FullO3CPU<Impl>::wakeCPU()
 {
-    if (activityRec.active() || tickEvent.scheduled()) {
+    const bool running = tickEvent.scheduled() ||
+        (activityRec.active() && !quiescentSleep);
+
+    // Whatever woke the CPU may have given work to an idle stage, so
+    // don't let any stage skip its tick until this activity drains.
+    // This has to come after checking whether the CPU is running, as
+    // it makes the recorder active.
+    if (skipIdleStageTicks)
+        activityRec.activity();
+
+    if (running) {
         DPRINTF(Activity, "CPU already running.\n");
         return;
     }
 
     DPRINTF(Activity, "Waking up CPU\n");
 
-    Cycles cycles(curCycle() - lastRunningCycle);
-    // @todo: This is an oddity that is only here to match the stats
-    if (cycles > 1) {
-        --cycles;
-        idleCycles += cycles;
-        numCycles += cycles;
+    if (quiescentSleep) {
+        wakeFromQuiescentSleep();
+    } else {
+        Cycles cycles(curCycle() - lastRunningCycle);
+        // @todo: This is an oddity that is only here to match the stats
+        if (cycles > 1) {
+            --cycles;
+            idleCycles += cycles;
+            numCycles += cycles;
+        }
     }
 
     schedule(tickEvent, clockEdge());
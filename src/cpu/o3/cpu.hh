@@ -51,6 +51,7 @@
 
 #include "arch/generic/types.hh"
 #include "arch/types.hh"
+#include "base/intrusive_list.hh"
 #include "base/statistics.hh"
 #include "config/the_isa.hh"
 #include "cpu/o3/comm.hh"
@@ -96,6 +97,7 @@ class FullO3CPU : public BaseO3CPU
   public:
     // Typedefs from the Impl here.
     typedef typename Impl::CPUPol CPUPolicy;
+    typedef typename Impl::DynInst DynInst;
     typedef typename Impl::DynInstPtr DynInstPtr;
     typedef typename Impl::O3CPU O3CPU;
 
@@ -107,7 +109,18 @@ class FullO3CPU : public BaseO3CPU
     typedef O3ThreadState<Impl> ImplState;
     typedef O3ThreadState<Impl> Thread;
 
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
+    /** Links of an instruction in instList */
+    struct InstListHook
+    {
+        static IntrusiveListHook<DynInst> &
+        get(DynInst *inst)
+        {
+            return inst->cpuListHook;
+        }
+    };
+
+    typedef IntrusiveList<DynInst, InstListHook> InstList;
+    typedef typename InstList::iterator ListIt;
 
     friend class O3ThreadContext<Impl>;
 
@@ -505,7 +518,7 @@ class FullO3CPU : public BaseO3CPU
     /** Function to add instruction onto the head of the list of the
      *  instructions.  Used when new instructions are fetched.
      */
-    ListIt addInst(const DynInstPtr &inst);
+    void addInst(const DynInstPtr &inst);
 
     /** Function to tell the CPU that an instruction has completed. */
     void instDone(ThreadID tid, const DynInstPtr &inst);
@@ -538,7 +551,7 @@ class FullO3CPU : public BaseO3CPU
 #endif
 
     /** List of all the instructions in flight. */
-    std::list<DynInstPtr> instList;
+    InstList instList;
 
     /** List of all the instructions that will be removed at the end of this
      *  cycle.
@@ -669,6 +682,43 @@ class FullO3CPU : public BaseO3CPU
     /** Wakes the CPU, rescheduling the CPU if it's not already active. */
     void wakeCPU();
 
+  private:
+    /** Whether to skip the ticks of stages that have nothing to do.
+     *  Skipped ticks still update the per-cycle stats of their stage, so
+     *  the stats match the ones of a run ticking every stage.
+     */
+    const bool skipIdleStageTicks;
+
+    /** Tracks if each stage was already idle, with no communication in
+     *  flight, at its last tick.
+     */
+    bool stageQuiescent[NumStages];
+
+    /** Set when the CPU stopped ticking because every stage skipped its
+     *  tick, while the activity recorder would have kept it running.
+     *  This only happens when the activity parameter keeps the recorder
+     *  active, it is idle otherwise.
+     */
+    bool quiescentSleep;
+
+    /** Checks if a stage can skip its tick this cycle.  A stage is
+     *  skipped once it is inactive, nothing can reach it through the
+     *  time buffers, and it has ticked once in that state to settle.
+     */
+    bool skipStage(StageIdx idx);
+
+    /** Counts ticks of a stage as skipped, updating the stats of the
+     *  stage as if they had been ticked.
+     */
+    void skipStageTicks(StageIdx idx, Counter ticks);
+
+    /** Skips the ticks of every stage in the cycles the CPU didn't tick
+     *  while it was asleep because of quiescent stages.
+     */
+    void wakeFromQuiescentSleep();
+
+  public:
+
     virtual void wakeup(ThreadID tid) override;
 
     /** Gets a free thread id. Use if thread ids change across system. */
@@ -754,6 +804,9 @@ class FullO3CPU : public BaseO3CPU
     Stats::Scalar timesIdled;
     /** Stat for total number of cycles the CPU spends descheduled. */
     Stats::Scalar idleCycles;
+    /** Stat for the number of ticks of each stage that were skipped
+     * because it had nothing to do. */
+    Stats::Vector skippedStageTicks;
     /** Stat for total number of cycles the CPU spends descheduled due to a
      * quiesce operation or waiting for an interrupt. */
     Stats::Scalar quiesceCycles;
@@ -138,6 +138,11 @@ class DefaultDecode
      */
     void tick();
 
+    /** Counts ticks that the CPU skipped while decode was quiescent in
+     * the per-cycle stats, as tick() would have.
+     */
+    void skipTicks(Counter ticks);
+
     /** Determines what to do based on decode's current status.
      * @param status_change decode() sets this variable if there was a status
      * change (ie switching from from blocking to unblocking).
@@ -595,6 +595,24 @@ DefaultDecode<Impl>::tick()
     }
 }
 
+template<class Impl>
+void
+DefaultDecode<Impl>::skipTicks(Counter ticks)
+{
+    for (auto tid : *activeThreads) {
+        if (decodeStatus[tid] == Blocked) {
+            decodeBlockedCycles += ticks;
+        } else if (decodeStatus[tid] == Squashing) {
+            decodeSquashCycles += ticks;
+        } else if (decodeStatus[tid] == Running ||
+                   decodeStatus[tid] == Idle) {
+            // Nothing comes from fetch while decode is quiescent
+            assert(insts[tid].empty());
+            decodeIdleCycles += ticks;
+        }
+    }
+}
+
 template<class Impl>
 void
 DefaultDecode<Impl>::decode(bool &status_change, ThreadID tid)
@@ -41,49 +41,48 @@
 #ifndef __CPU_O3_DEP_GRAPH_HH__
 #define __CPU_O3_DEP_GRAPH_HH__
 
-#include "cpu/o3/comm.hh"
-
-/** Node in a linked list. */
-template <class DynInstPtr>
-class DependencyEntry
-{
-  public:
-    DependencyEntry()
-        : inst(NULL), next(NULL)
-    { }
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
 
-    DynInstPtr inst;
-    //Might want to include data about what arch. register the
-    //dependence is waiting on.
-    DependencyEntry<DynInstPtr> *next;
-};
+#include "base/bitfield.hh"
+#include "base/types.hh"
+#include "cpu/o3/comm.hh"
 
-/** Array of linked list that maintains the dependencies between
- * producing instructions and consuming instructions.  Each linked
- * list represents a single physical register, having the future
- * producer of the register's value, and all consumers waiting on that
- * value on the list.  The head node of each linked list represents
- * the producing instruction of that register.  Instructions are put
- * on the list upon reaching the IQ, and are removed from the list
- * either when the producer completes, or the instruction is squashed.
-*/
+/** Bit matrix that maintains the dependencies between producing
+ * instructions and consuming instructions.  Each consuming
+ * instruction is given a slot while it waits on any register, and
+ * each physical register has a row of bits with one bit per slot,
+ * set if the instruction in that slot waits on the register.  Along
+ * with the rows, the graph keeps the future producer of each
+ * register's value.  Instructions are put in the graph upon reaching
+ * the IQ, and are removed from it either when the producer
+ * completes, or the instruction is squashed.  Neither needs to
+ * allocate or to walk a list of dependents, so the cost of wakeup
+ * does not grow with the size of the IQ.
+ *
+ * Instructions record their slot in their depGraphSlot member, which
+ * must be -1 when they are first inserted.
+ */
 template <class DynInstPtr>
 class DependencyGraph
 {
   public:
-    typedef DependencyEntry<DynInstPtr> DepEntry;
-
     /** Default construction.  Must call resize() prior to use. */
     DependencyGraph()
-        : numEntries(0), memAllocCounter(0), nodesTraversed(0), nodesRemoved(0)
+        : numEntries(0), numSlots(0), numWords(0), maxSrcRegs(0),
+          numDependents(0)
     { }
 
-    ~DependencyGraph();
-
-    /** Resize the dependency graph to have num_entries registers. */
-    void resize(int num_entries);
+    /**
+     * Resize the dependency graph to have num_entries registers, and
+     * room for num_slots waiting instructions of up to max_src_regs
+     * source registers each.  The number of slots grows on demand.
+     */
+    void resize(int num_entries, int num_slots, int max_src_regs);
 
-    /** Clears all of the linked lists. */
+    /** Clears all of the dependencies. */
     void reset();
 
     /** Inserts an instruction to be dependent on the given index. */
@@ -91,90 +90,181 @@ class DependencyGraph
 
     /** Sets the producing instruction of a given register. */
     void setInst(PhysRegIndex idx, const DynInstPtr &new_inst)
-    { dependGraph[idx].inst = new_inst; }
+    { producers[idx] = new_inst; }
 
     /** Clears the producing instruction. */
     void clearInst(PhysRegIndex idx)
-    { dependGraph[idx].inst = NULL; }
+    { producers[idx] = NULL; }
 
-    /** Removes an instruction from a single linked list. */
+    /** Removes an instruction from the dependents of a register. */
     void remove(PhysRegIndex idx, const DynInstPtr &inst_to_remove);
 
-    /** Removes and returns the newest dependent of a specific register. */
+    /** Removes and returns a dependent of a specific register. */
     DynInstPtr pop(PhysRegIndex idx);
 
     /** Checks if the entire dependency graph is empty. */
-    bool empty() const;
+    bool empty() const { return numDependents == 0; }
 
     /** Checks if there are any dependents on a specific register. */
-    bool empty(PhysRegIndex idx) const { return !dependGraph[idx].next; }
+    bool empty(PhysRegIndex idx) const { return !dependCount[idx]; }
 
     /** Debugging function to dump out the dependency graph.
      */
     void dump();
 
   private:
-    /** Array of linked lists.  Each linked list is a list of all the
-     *  instructions that depend upon a given register.  The actual
-     *  register's index is used to index into the graph; ie all
-     *  instructions in flight that are dependent upon r34 will be
-     *  in the linked list of dependGraph[34].
+    /** Returns the word of a register's row that holds a slot's bit. */
+    uint64_t &
+    word(PhysRegIndex idx, int slot)
+    {
+        return waiting[idx * numWords + slot / 64];
+    }
+
+    /** Returns the first source register of a slot. */
+    PhysRegIndex *slotRegs(int slot) { return &srcRegs[slot * maxSrcRegs]; }
+
+    /** Gives an instruction a slot, growing the graph if none is free. */
+    int allocSlot(const DynInstPtr &inst);
+
+    /**
+     * Drops one dependency of the instruction in a slot on a register,
+     * and frees the slot if it was the last one.
      */
-    std::vector<DepEntry> dependGraph;
+    DynInstPtr removeDependency(PhysRegIndex idx, int slot);
 
-    /** Number of linked lists; identical to the number of registers. */
+    /** Doubles the number of slots. */
+    void grow();
+
+    /** Number of registers; one row of the matrix per register. */
     int numEntries;
 
-    // Debug variable, remove when done testing.
-    unsigned memAllocCounter;
+    /** Number of instruction slots; one column per slot. */
+    int numSlots;
 
-  public:
-    // Debug variable, remove when done testing.
-    uint64_t nodesTraversed;
-    // Debug variable, remove when done testing.
-    uint64_t nodesRemoved;
+    /** Number of 64-bit words in each row. */
+    int numWords;
+
+    /** Maximum number of source registers of an instruction. */
+    int maxSrcRegs;
+
+    /** Total number of dependencies in the graph. */
+    int numDependents;
+
+    /** The rows of the matrix, numWords words per register. */
+    std::vector<uint64_t> waiting;
+
+    /** Number of dependencies on each register. */
+    std::vector<int> dependCount;
+
+    /** The producing instruction of each register. */
+    std::vector<DynInstPtr> producers;
+
+    /** The waiting instruction in each slot. */
+    std::vector<DynInstPtr> consumers;
+
+    /**
+     * The registers each slot waits on, maxSrcRegs entries per slot.  A
+     * register appears once per source operand that reads it, so an
+     * instruction that reads a register twice is popped twice.
+     */
+    std::vector<PhysRegIndex> srcRegs;
+
+    /** Number of registers each slot waits on. */
+    std::vector<uint8_t> numSrcRegs;
+
+    /** Stack of the slots that are not in use. */
+    std::vector<int> freeSlots;
 };
 
 template <class DynInstPtr>
-DependencyGraph<DynInstPtr>::~DependencyGraph()
+void
+DependencyGraph<DynInstPtr>::resize(int num_entries, int num_slots,
+                                    int max_src_regs)
 {
+    assert(num_slots > 0 && max_src_regs > 0);
+
+    numEntries = num_entries;
+    numSlots = num_slots;
+    numWords = (numSlots + 63) / 64;
+    maxSrcRegs = max_src_regs;
+    numDependents = 0;
+
+    waiting.assign(numEntries * numWords, 0);
+    dependCount.assign(numEntries, 0);
+    producers.assign(numEntries, NULL);
+    consumers.assign(numSlots, NULL);
+    srcRegs.assign(numSlots * maxSrcRegs, 0);
+    numSrcRegs.assign(numSlots, 0);
+
+    freeSlots.clear();
+    for (int slot = numSlots - 1; slot >= 0; --slot)
+        freeSlots.push_back(slot);
 }
 
 template <class DynInstPtr>
 void
-DependencyGraph<DynInstPtr>::resize(int num_entries)
+DependencyGraph<DynInstPtr>::reset()
 {
-    numEntries = num_entries;
-    dependGraph.resize(numEntries);
+    for (int slot = 0; slot < numSlots; ++slot) {
+        if (consumers[slot]) {
+            consumers[slot]->depGraphSlot = -1;
+            consumers[slot] = NULL;
+        }
+        numSrcRegs[slot] = 0;
+    }
+
+    for (int i = 0; i < numEntries; ++i)
+        producers[i] = NULL;
+
+    std::fill(waiting.begin(), waiting.end(), 0);
+    std::fill(dependCount.begin(), dependCount.end(), 0);
+    numDependents = 0;
+
+    freeSlots.clear();
+    for (int slot = numSlots - 1; slot >= 0; --slot)
+        freeSlots.push_back(slot);
 }
 
 template <class DynInstPtr>
 void
-DependencyGraph<DynInstPtr>::reset()
+DependencyGraph<DynInstPtr>::grow()
 {
-    // Clear the dependency graph
-    DepEntry *curr;
-    DepEntry *prev;
+    const int old_words = numWords;
+    const int old_slots = numSlots;
+
+    numSlots *= 2;
+    numWords = (numSlots + 63) / 64;
 
+    std::vector<uint64_t> new_waiting(numEntries * numWords, 0);
     for (int i = 0; i < numEntries; ++i) {
-        curr = dependGraph[i].next;
+        std::copy(&waiting[i * old_words], &waiting[(i + 1) * old_words],
+                  &new_waiting[i * numWords]);
+    }
+    waiting.swap(new_waiting);
 
-        while (curr) {
-            memAllocCounter--;
+    consumers.resize(numSlots, NULL);
+    srcRegs.resize(numSlots * maxSrcRegs, 0);
+    numSrcRegs.resize(numSlots, 0);
 
-            prev = curr;
-            curr = prev->next;
-            prev->inst = NULL;
+    for (int slot = numSlots - 1; slot >= old_slots; --slot)
+        freeSlots.push_back(slot);
+}
 
-            delete prev;
-        }
+template <class DynInstPtr>
+int
+DependencyGraph<DynInstPtr>::allocSlot(const DynInstPtr &inst)
+{
+    if (freeSlots.empty())
+        grow();
 
-        if (dependGraph[i].inst) {
-            dependGraph[i].inst = NULL;
-        }
+    int slot = freeSlots.back();
+    freeSlots.pop_back();
 
-        dependGraph[i].next = NULL;
-    }
+    assert(!consumers[slot] && numSrcRegs[slot] == 0);
+    consumers[slot] = inst;
+    inst->depGraphSlot = slot;
+
+    return slot;
 }
 
 template <class DynInstPtr>
@@ -182,115 +272,113 @@ void
 DependencyGraph<DynInstPtr>::insert(PhysRegIndex idx,
         const DynInstPtr &new_inst)
 {
-    //Add this new, dependent instruction at the head of the dependency
-    //chain.
+    int slot = new_inst->depGraphSlot;
+    if (slot < 0)
+        slot = allocSlot(new_inst);
 
-    // First create the entry that will be added to the head of the
-    // dependency chain.
-    DepEntry *new_entry = new DepEntry;
-    new_entry->next = dependGraph[idx].next;
-    new_entry->inst = new_inst;
+    assert(consumers[slot] == new_inst);
+    assert(numSrcRegs[slot] < maxSrcRegs);
 
-    // Then actually add it to the chain.
-    dependGraph[idx].next = new_entry;
+    slotRegs(slot)[numSrcRegs[slot]++] = idx;
+    word(idx, slot) |= ULL(1) << (slot % 64);
 
-    ++memAllocCounter;
+    ++dependCount[idx];
+    ++numDependents;
 }
 
-
 template <class DynInstPtr>
-void
-DependencyGraph<DynInstPtr>::remove(PhysRegIndex idx,
-                                    const DynInstPtr &inst_to_remove)
+DynInstPtr
+DependencyGraph<DynInstPtr>::removeDependency(PhysRegIndex idx, int slot)
 {
-    DepEntry *prev = &dependGraph[idx];
-    DepEntry *curr = dependGraph[idx].next;
-
-    // Make sure curr isn't NULL.  Because this instruction is being
-    // removed from a dependency list, it must have been placed there at
-    // an earlier time.  The dependency chain should not be empty,
-    // unless the instruction dependent upon it is already ready.
-    if (curr == NULL) {
-        return;
+    PhysRegIndex *regs = slotRegs(slot);
+    uint8_t &num_regs = numSrcRegs[slot];
+
+    // Drop one occurrence of the register from the slot, and only clear
+    // the slot's bit if the instruction doesn't read it again.
+    bool found = false;
+    bool again = false;
+    for (int i = 0; i < num_regs; ++i) {
+        if (regs[i] != idx)
+            continue;
+        if (!found) {
+            regs[i] = regs[--num_regs];
+            found = true;
+            --i;
+        } else {
+            again = true;
+            break;
+        }
     }
+    assert(found);
 
-    nodesRemoved++;
+    if (!again)
+        word(idx, slot) &= ~(ULL(1) << (slot % 64));
 
-    // Find the instruction to remove within the dependency linked list.
-    while (curr->inst != inst_to_remove) {
-        prev = curr;
-        curr = curr->next;
-        nodesTraversed++;
+    --dependCount[idx];
+    --numDependents;
 
-        assert(curr != NULL);
+    DynInstPtr inst = consumers[slot];
+    if (num_regs == 0) {
+        inst->depGraphSlot = -1;
+        consumers[slot] = NULL;
+        freeSlots.push_back(slot);
     }
+    return inst;
+}
 
-    // Now remove this instruction from the list.
-    prev->next = curr->next;
-
-    --memAllocCounter;
-
-    // Could push this off to the destructor of DependencyEntry
-    curr->inst = NULL;
+template <class DynInstPtr>
+void
+DependencyGraph<DynInstPtr>::remove(PhysRegIndex idx,
+                                    const DynInstPtr &inst_to_remove)
+{
+    // The instruction may have stopped waiting on the register already,
+    // in which case there is nothing to remove.
+    const int slot = inst_to_remove->depGraphSlot;
+    if (slot < 0 || !(word(idx, slot) & (ULL(1) << (slot % 64))))
+        return;
 
-    delete curr;
+    removeDependency(idx, slot);
 }
 
 template <class DynInstPtr>
 DynInstPtr
 DependencyGraph<DynInstPtr>::pop(PhysRegIndex idx)
 {
-    DepEntry *node;
-    node = dependGraph[idx].next;
-    DynInstPtr inst = NULL;
-    if (node) {
-        inst = node->inst;
-        dependGraph[idx].next = node->next;
-        node->inst = NULL;
-        memAllocCounter--;
-        delete node;
-    }
-    return inst;
-}
+    if (!dependCount[idx])
+        return NULL;
 
-template <class DynInstPtr>
-bool
-DependencyGraph<DynInstPtr>::empty() const
-{
-    for (int i = 0; i < numEntries; ++i) {
-        if (!empty(i))
-            return false;
-    }
-    return true;
+    const uint64_t *row = &waiting[idx * numWords];
+    int w = 0;
+    while (!row[w])
+        ++w;
+
+    return removeDependency(idx, w * 64 + findLsbSet(row[w]));
 }
 
 template <class DynInstPtr>
 void
 DependencyGraph<DynInstPtr>::dump()
 {
-    DepEntry *curr;
-
     for (int i = 0; i < numEntries; ++i)
     {
-        curr = &dependGraph[i];
-
-        if (curr->inst) {
+        if (producers[i]) {
             cprintf("dependGraph[%i]: producer: %s [sn:%lli] consumer: ",
-                    i, curr->inst->pcState(), curr->inst->seqNum);
+                    i, producers[i]->pcState(), producers[i]->seqNum);
         } else {
             cprintf("dependGraph[%i]: No producer. consumer: ", i);
         }
 
-        while (curr->next != NULL) {
-            curr = curr->next;
-
-            cprintf("%s [sn:%lli] ",
-                    curr->inst->pcState(), curr->inst->seqNum);
+        for (int slot = 0; slot < numSlots; ++slot) {
+            if (word(i, slot) & (ULL(1) << (slot % 64))) {
+                cprintf("%s [sn:%lli] ", consumers[slot]->pcState(),
+                        consumers[slot]->seqNum);
+            }
         }
 
         cprintf("\n");
     }
-    cprintf("memAllocCounter: %i\n", memAllocCounter);
+    cprintf("Dependencies: %i, free slots: %i of %i\n",
+            numDependents, freeSlots.size(), numSlots);
 }
 
 #endif // __CPU_O3_DEP_GRAPH_HH__
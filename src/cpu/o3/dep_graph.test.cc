@@ -0,0 +1,208 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "cpu/o3/dep_graph.hh"
+
+namespace
+{
+
+/** The graph only needs the slot of an instruction */
+struct Inst
+{
+    int depGraphSlot = -1;
+};
+
+typedef DependencyGraph<Inst *> Graph;
+
+/** Pop all the dependents of a register, in the order they come out */
+std::vector<Inst *>
+popAll(Graph &graph, PhysRegIndex idx)
+{
+    std::vector<Inst *> insts;
+    while (!graph.empty(idx))
+        insts.push_back(graph.pop(idx));
+    EXPECT_EQ(nullptr, graph.pop(idx));
+    return insts;
+}
+
+} // anonymous namespace
+
+TEST(DependencyGraphTest, InsertAndPop)
+{
+    Graph graph;
+    graph.resize(4, 8, 2);
+    EXPECT_TRUE(graph.empty());
+
+    Inst a, b;
+    graph.insert(1, &a);
+    graph.insert(1, &b);
+    graph.insert(2, &b);
+    EXPECT_FALSE(graph.empty());
+    EXPECT_FALSE(graph.empty(1));
+    EXPECT_FALSE(graph.empty(2));
+    EXPECT_TRUE(graph.empty(0));
+    EXPECT_EQ(0, a.depGraphSlot);
+    EXPECT_EQ(1, b.depGraphSlot);
+
+    EXPECT_EQ(std::vector<Inst *>({ &a, &b }), popAll(graph, 1));
+
+    // a waited on nothing else, b still waits on 2
+    EXPECT_EQ(-1, a.depGraphSlot);
+    EXPECT_EQ(1, b.depGraphSlot);
+    EXPECT_FALSE(graph.empty());
+
+    EXPECT_EQ(std::vector<Inst *>({ &b }), popAll(graph, 2));
+    EXPECT_EQ(-1, b.depGraphSlot);
+    EXPECT_TRUE(graph.empty());
+}
+
+TEST(DependencyGraphTest, Remove)
+{
+    Graph graph;
+    graph.resize(4, 8, 2);
+
+    Inst a, b, c;
+    graph.insert(0, &a);
+    graph.insert(0, &b);
+    graph.insert(3, &b);
+    graph.insert(0, &c);
+
+    graph.remove(0, &b);
+    EXPECT_EQ(1, b.depGraphSlot);
+
+    // Removing a dependency that isn't there does nothing
+    graph.remove(0, &b);
+    graph.remove(1, &a);
+
+    EXPECT_EQ(std::vector<Inst *>({ &a, &c }), popAll(graph, 0));
+
+    graph.remove(3, &b);
+    EXPECT_EQ(-1, b.depGraphSlot);
+    EXPECT_TRUE(graph.empty());
+
+    // Neither does removing an instruction that isn't in the graph
+    graph.remove(3, &b);
+    EXPECT_TRUE(graph.empty());
+}
+
+TEST(DependencyGraphTest, SameRegisterTwice)
+{
+    Graph graph;
+    graph.resize(4, 8, 2);
+
+    // An instruction reading a register twice is popped twice, and only
+    // leaves the graph after the second one
+    Inst a;
+    graph.insert(2, &a);
+    graph.insert(2, &a);
+
+    EXPECT_EQ(&a, graph.pop(2));
+    EXPECT_EQ(0, a.depGraphSlot);
+    EXPECT_FALSE(graph.empty(2));
+    EXPECT_EQ(&a, graph.pop(2));
+    EXPECT_EQ(-1, a.depGraphSlot);
+    EXPECT_TRUE(graph.empty());
+}
+
+TEST(DependencyGraphTest, SlotReuse)
+{
+    Graph graph;
+    graph.resize(2, 4, 1);
+
+    Inst insts[4];
+    for (auto &inst : insts)
+        graph.insert(0, &inst);
+
+    // Freed slots are handed out again before any other
+    graph.remove(0, &insts[2]);
+    graph.remove(0, &insts[1]);
+
+    Inst d, e;
+    graph.insert(1, &d);
+    graph.insert(0, &e);
+    EXPECT_EQ(1, d.depGraphSlot);
+    EXPECT_EQ(2, e.depGraphSlot);
+
+    // Pops come out in slot order, not insertion order
+    EXPECT_EQ(std::vector<Inst *>({ &insts[0], &e, &insts[3] }),
+              popAll(graph, 0));
+    EXPECT_EQ(std::vector<Inst *>({ &d }), popAll(graph, 1));
+    EXPECT_TRUE(graph.empty());
+}
+
+TEST(DependencyGraphTest, Grow)
+{
+    Graph graph;
+    graph.resize(3, 2, 2);
+
+    // Start well under a word and grow past the first one, so the rows
+    // are copied into more words
+    const int num_insts = 100;
+    std::vector<Inst> insts(num_insts);
+    for (int i = 0; i < num_insts; ++i)
+        graph.insert(i % 2, &insts[i]);
+    graph.insert(2, &insts[0]);
+
+    for (int i = 0; i < num_insts; ++i)
+        EXPECT_EQ(i, insts[i].depGraphSlot);
+
+    std::vector<Inst *> even, odd;
+    for (int i = 0; i < num_insts; ++i)
+        (i % 2 ? odd : even).push_back(&insts[i]);
+
+    graph.remove(2, &insts[0]);
+    EXPECT_EQ(even, popAll(graph, 0));
+    EXPECT_EQ(odd, popAll(graph, 1));
+    EXPECT_TRUE(graph.empty());
+}
+
+TEST(DependencyGraphTest, Reset)
+{
+    Graph graph;
+    graph.resize(2, 4, 2);
+
+    Inst a, b;
+    graph.insert(0, &a);
+    graph.insert(1, &a);
+    graph.insert(1, &b);
+    graph.setInst(0, &b);
+
+    graph.reset();
+    EXPECT_TRUE(graph.empty());
+    EXPECT_TRUE(graph.empty(0));
+    EXPECT_TRUE(graph.empty(1));
+    EXPECT_EQ(-1, a.depGraphSlot);
+    EXPECT_EQ(-1, b.depGraphSlot);
+    EXPECT_EQ(nullptr, graph.pop(1));
+
+    // All the slots are free again
+    graph.insert(1, &b);
+    EXPECT_EQ(0, b.depGraphSlot);
+    EXPECT_EQ(std::vector<Inst *>({ &b }), popAll(graph, 1));
+}
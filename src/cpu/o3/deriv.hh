@@ -31,6 +31,7 @@
 
 #include "cpu/o3/cpu.hh"
 #include "cpu/o3/impl.hh"
+#include "cpu/o3/isa_specific.hh"
 #include "params/DerivO3CPU.hh"
 
 class DerivO3CPU : public FullO3CPU<O3CPUImpl>
@@ -29,6 +29,12 @@
 #include "cpu/o3/dyn_inst_impl.hh"
 #include "cpu/o3/impl.hh"
 
+// Larger instructions would silently bypass the pool
+static_assert(sizeof(BaseO3DynInst<O3CPUImpl>) <= FreeListPool::MaxBlockSize,
+              "O3 instructions do not fit in a pool block");
+
+FreeListPool dynInstPool("o3_dyn_inst", sizeof(BaseO3DynInst<O3CPUImpl>));
+
 // Force instantiation of BaseO3DynInst for all the implementations that
 // are needed.
 template class BaseO3DynInst<O3CPUImpl>;
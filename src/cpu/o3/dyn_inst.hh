@@ -45,6 +45,8 @@
 #include <array>
 
 #include "arch/isa_traits.hh"
+#include "base/free_list_pool.hh"
+#include "base/intrusive_list.hh"
 #include "config/the_isa.hh"
 #include "cpu/o3/cpu.hh"
 #include "cpu/o3/isa_specific.hh"
@@ -54,6 +56,12 @@
 
 class Packet;
 
+/**
+ * Dynamic instructions are allocated from this pool rather than the heap
+ * since one is created for every fetched instruction.
+ */
+extern FreeListPool dynInstPool;
+
 template <class Impl>
 class BaseO3DynInst : public BaseDynInst<Impl>
 {
@@ -86,6 +94,39 @@ class BaseO3DynInst : public BaseDynInst<Impl>
 
     ~BaseO3DynInst();
 
+    /**
+     * Instructions are allocated from dynInstPool rather than the heap.
+     * @{
+     */
+    static void *
+    operator new(size_t size)
+    {
+        return dynInstPool.allocate(size);
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        dynInstPool.release(p, size);
+    }
+    /** @} */
+
+    /**
+     * Links of this instruction in the instruction lists of the CPU, the
+     * ROB, the IQ and the memory dependence unit. Being in these lists
+     * does not allocate, and each list holds a reference to it.
+     * @{
+     */
+    IntrusiveListHook<BaseO3DynInst> cpuListHook;
+    IntrusiveListHook<BaseO3DynInst> robListHook;
+    IntrusiveListHook<BaseO3DynInst> iqListHook;
+    IntrusiveListHook<BaseO3DynInst> memDepListHook;
+    /** @} */
+
+    /** Slot of this instruction in the IQ's dependency graph, or -1 if
+     *  it doesn't wait on any register. */
+    int depGraphSlot;
+
     /** Executes the instruction.*/
     Fault execute();
 
@@ -107,6 +107,8 @@ BaseO3DynInst<Impl>::initVars()
 
     _numDestMiscRegs = 0;
 
+    depGraphSlot = -1;
+
 #if TRACING_ON
     // Value -1 indicates that particular phase
     // hasn't happened (yet).
@@ -356,6 +356,11 @@ class DefaultFetch
      */
     void tick();
 
+    /** Counts ticks that the CPU skipped while fetch was quiescent in
+     * the per-cycle stats, as tick() would have.
+     */
+    void skipTicks(Counter ticks);
+
     /** Checks all input signals and updates the status as necessary.
      *  @return: Returns if the status has changed due to input signals.
      */
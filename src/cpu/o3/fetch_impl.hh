@@ -629,7 +629,7 @@ DefaultFetch<Impl>::fetchCacheLine(Addr vaddr, ThreadID tid, Addr pc)
     // Setup the memReq to do a read of the first instruction's address.
     // Set the appropriate read size and flags as well.
     // Build request here.
-    RequestPtr mem_req = std::make_shared<Request>(
+    RequestPtr mem_req = Request::create(
         fetchBufferBlockPC, fetchBufferSize,
         Request::INST_FETCH, cpu->instMasterId(), pc,
         cpu->thread[tid]->contextId());
@@ -991,6 +991,28 @@ DefaultFetch<Impl>::tick()
     numInst = 0;
 }
 
+template<class Impl>
+void
+DefaultFetch<Impl>::skipTicks(Counter ticks)
+{
+    // Nothing changes while fetch is quiescent, each of these ticks would
+    // have found the same stall, or idle thread, and fetched nothing.
+    const ThreadID tid = getFetchingThread();
+    for (Counter i = 0; i < ticks; ++i) {
+        if (tid == InvalidThreadID) {
+            profileStall(0);
+        } else {
+            assert(fetchStatus[tid] == Idle);
+            fetchIdleCycles += numFetchingThreads;
+        }
+
+        // Keep the random numbers drawn in step with ticking fetch
+        random_mt.random<uint8_t>(0, activeThreads->size() - 1);
+    }
+
+    fetchNisnDist.sample(0, ticks);
+}
+
 template <class Impl>
 bool
 DefaultFetch<Impl>::checkSignalsAndUpdate(ThreadID tid)
@@ -1131,7 +1153,7 @@ DefaultFetch<Impl>::buildInst(ThreadID tid, StaticInstPtr staticInst,
 #endif
 
     // Add instruction to the CPU's list of instructions.
-    instruction->setInstListIt(cpu->addInst(instruction));
+    cpu->addInst(instruction);
 
     // Write the instruction to the first slot in the queue
     // that heads to decode.
@@ -294,6 +294,11 @@ class DefaultIEW
      */
     void tick();
 
+    /** Counts ticks that the CPU skipped while IEW was quiescent in the
+     * per-cycle stats, as tick() would have.
+     */
+    void skipTicks(Counter ticks);
+
   private:
     /** Updates execution stats based on the instruction. */
     void updateExeInstStats(const DynInstPtr &inst);
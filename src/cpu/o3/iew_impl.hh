@@ -1627,6 +1627,26 @@ DefaultIEW<Impl>::tick()
     }
 }
 
+template <class Impl>
+void
+DefaultIEW<Impl>::skipTicks(Counter ticks)
+{
+    for (auto tid : *activeThreads) {
+        if (dispatchStatus[tid] == Blocked) {
+            iewBlockCycles += ticks;
+        } else if (dispatchStatus[tid] == Squashing) {
+            iewSquashCycles += ticks;
+        }
+    }
+
+    // Nothing is ready to issue while IEW is quiescent
+    if (exeStatus != Squashing)
+        instQueue.skipTicks(ticks);
+
+    // Read by updateStatus() every tick
+    instQueue.intInstQueueReads += ticks;
+}
+
 template <class Impl>
 void
 DefaultIEW<Impl>::updateExeInstStats(const DynInstPtr& inst)
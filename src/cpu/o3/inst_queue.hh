@@ -47,6 +47,7 @@
 #include <queue>
 #include <vector>
 
+#include "base/intrusive_list.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/o3/dep_graph.hh"
@@ -83,6 +84,7 @@ class InstructionQueue
   public:
     //Typedefs from the Impl.
     typedef typename Impl::O3CPU O3CPU;
+    typedef typename Impl::DynInst DynInst;
     typedef typename Impl::DynInstPtr DynInstPtr;
 
     typedef typename Impl::CPUPol::IEW IEW;
@@ -93,6 +95,19 @@ class InstructionQueue
     // Typedef of iterator through the list of instructions.
     typedef typename std::list<DynInstPtr>::iterator ListIt;
 
+    // Typedefs of the list of all instructions in the IQ.
+    struct InstListHook
+    {
+        static IntrusiveListHook<DynInst> &
+        get(DynInst *inst)
+        {
+            return inst->iqListHook;
+        }
+    };
+
+    typedef IntrusiveList<DynInst, InstListHook> InstList;
+    typedef typename InstList::iterator InstListIt;
+
     /** FU completion event class. */
     class FUCompletion : public Event {
       private:
@@ -216,6 +231,11 @@ class InstructionQueue
      */
     void scheduleReadyInsts();
 
+    /** Counts ticks in which no instruction was ready to schedule in the
+     * per-cycle stats, as scheduleReadyInsts() would have.
+     */
+    void skipTicks(Counter ticks);
+
     /** Schedules a single specific non-speculative instruction. */
     void scheduleNonSpec(const InstSeqNum &inst);
 
@@ -311,7 +331,7 @@ class InstructionQueue
     //////////////////////////////////////
 
     /** List of all the instructions in the IQ (some of which may be issued). */
-    std::list<DynInstPtr> instList[Impl::MaxThreads];
+    InstList instList[Impl::MaxThreads];
 
     /** List of instructions that are ready to be executed. */
     std::list<DynInstPtr> instsToExecute;
@@ -362,39 +382,30 @@ class InstructionQueue
 
     typedef typename std::map<InstSeqNum, DynInstPtr>::iterator NonSpecMapIt;
 
-    /** Entry for the list age ordering by op class. */
-    struct ListOrderEntry {
-        OpClass queueType;
-        InstSeqNum oldestInst;
-    };
+    static_assert(Num_OpClasses <= 64,
+                  "Ready queues don't fit in the readyQueues bitmap");
 
-    /** List that contains the age order of the oldest instruction of each
-     *  ready queue.  Used to select the oldest instruction available
-     *  among op classes.
-     *  @todo: Might be better to just move these entries around instead
-     *  of creating new ones every time the position changes due to an
-     *  instruction issuing.  Not sure std::list supports this.
+    /** Bitmap of the op classes whose ready queue is not empty.  Used to
+     *  select the oldest instruction available among op classes without
+     *  keeping the queues sorted by age.
      */
-    std::list<ListOrderEntry> listOrder;
-
-    typedef typename std::list<ListOrderEntry>::iterator ListOrderIt;
+    uint64_t readyQueues;
 
-    /** Tracks if each ready queue is on the age order list. */
-    bool queueOnList[Num_OpClasses];
-
-    /** Iterators of each ready queue.  Points to their spot in the age order
-     *  list.
+    /** Sequence number of the oldest instruction of each ready queue.
+     *  Only valid for the queues that are set in readyQueues.
      */
-    ListOrderIt readyIt[Num_OpClasses];
+    InstSeqNum oldestReady[Num_OpClasses];
 
-    /** Add an op class to the age order list. */
-    void addToOrderList(OpClass op_class);
+    /** Adds an instruction to the ready queue of its op class. */
+    void pushReadyInst(const DynInstPtr &inst);
 
-    /**
-     * Called when the oldest instruction has been removed from a ready queue;
-     * this places that ready queue into the proper spot in the age order list.
+    /** Removes the oldest instruction of the ready queue of an op class. */
+    void popReadyInst(OpClass op_class);
+
+    /** Returns the op class, among the ones set in the given bitmap, that
+     *  has the oldest ready instruction.
      */
-    void moveToYoungerInst(ListOrderIt age_order_it);
+    OpClass oldestReadyQueue(uint64_t queues) const;
 
     DependencyGraph<DynInstPtr> dependGraph;
 
@@ -45,6 +45,7 @@
 #include <limits>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "base/logging.hh"
 #include "cpu/o3/fu_pool.hh"
 #include "cpu/o3/inst_queue.hh"
@@ -105,8 +106,8 @@ InstructionQueue<Impl>::InstructionQueue(O3CPU *cpu_ptr, IEW *iew_ptr,
                     params->numPhysCCRegs;
 
     //Create an entry for each physical register within the
-    //dependency graph.
-    dependGraph.resize(numPhysRegs);
+    //dependency graph, and a slot for each IQ entry.
+    dependGraph.resize(numPhysRegs, numEntries, TheISA::MaxInstSrcRegs);
 
     // Resize the register scoreboard.
     regScoreboard.resize(numPhysRegs);
@@ -159,10 +160,6 @@ template <class Impl>
 InstructionQueue<Impl>::~InstructionQueue()
 {
     dependGraph.reset();
-#ifdef DEBUG
-    cprintf("Nodes traversed: %i, removed: %i\n",
-            dependGraph.nodesTraversed, dependGraph.nodesRemoved);
-#endif
 }
 
 template <class Impl>
@@ -418,11 +415,9 @@ InstructionQueue<Impl>::resetState()
     for (int i = 0; i < Num_OpClasses; ++i) {
         while (!readyInsts[i].empty())
             readyInsts[i].pop();
-        queueOnList[i] = false;
-        readyIt[i] = listOrder.end();
     }
+    readyQueues = 0;
     nonSpecInsts.clear();
-    listOrder.clear();
     deferredMemInsts.clear();
     blockedMemInsts.clear();
     retryMemInsts.clear();
@@ -559,17 +554,7 @@ template <class Impl>
 bool
 InstructionQueue<Impl>::hasReadyInsts()
 {
-    if (!listOrder.empty()) {
-        return true;
-    }
-
-    for (int i = 0; i < Num_OpClasses; ++i) {
-        if (!readyInsts[i].empty()) {
-            return true;
-        }
-    }
-
-    return false;
+    return readyQueues != 0;
 }
 
 template <class Impl>
@@ -591,7 +576,7 @@ InstructionQueue<Impl>::insert(const DynInstPtr &new_inst)
 
     assert(freeEntries != 0);
 
-    instList[new_inst->threadNumber].push_back(new_inst);
+    instList[new_inst->threadNumber].push_back(new_inst.get());
 
     --freeEntries;
 
@@ -642,7 +627,7 @@ InstructionQueue<Impl>::insertNonSpec(const DynInstPtr &new_inst)
 
     assert(freeEntries != 0);
 
-    instList[new_inst->threadNumber].push_back(new_inst);
+    instList[new_inst->threadNumber].push_back(new_inst.get());
 
     --freeEntries;
 
@@ -693,55 +678,52 @@ InstructionQueue<Impl>::getInstToExecute()
 
 template <class Impl>
 void
-InstructionQueue<Impl>::addToOrderList(OpClass op_class)
+InstructionQueue<Impl>::pushReadyInst(const DynInstPtr &inst)
 {
-    assert(!readyInsts[op_class].empty());
-
-    ListOrderEntry queue_entry;
+    OpClass op_class = inst->opClass();
+    const uint64_t queue_bit = ULL(1) << op_class;
 
-    queue_entry.queueType = op_class;
+    readyInsts[op_class].push(inst);
 
-    queue_entry.oldestInst = readyInsts[op_class].top()->seqNum;
-
-    ListOrderIt list_it = listOrder.begin();
-    ListOrderIt list_end_it = listOrder.end();
+    // The oldest instruction only changes if the queue was empty, or if
+    // the new instruction is older than the ones already in it.
+    if (!(readyQueues & queue_bit) || inst->seqNum < oldestReady[op_class]) {
+        oldestReady[op_class] = inst->seqNum;
+        readyQueues |= queue_bit;
+    }
+}
 
-    while (list_it != list_end_it) {
-        if ((*list_it).oldestInst > queue_entry.oldestInst) {
-            break;
-        }
+template <class Impl>
+void
+InstructionQueue<Impl>::popReadyInst(OpClass op_class)
+{
+    readyInsts[op_class].pop();
 
-        list_it++;
+    if (readyInsts[op_class].empty()) {
+        readyQueues &= ~(ULL(1) << op_class);
+    } else {
+        oldestReady[op_class] = readyInsts[op_class].top()->seqNum;
     }
-
-    readyIt[op_class] = listOrder.insert(list_it, queue_entry);
-    queueOnList[op_class] = true;
 }
 
 template <class Impl>
-void
-InstructionQueue<Impl>::moveToYoungerInst(ListOrderIt list_order_it)
+OpClass
+InstructionQueue<Impl>::oldestReadyQueue(uint64_t queues) const
 {
-    // Get iterator of next item on the list
-    // Delete the original iterator
-    // Determine if the next item is either the end of the list or younger
-    // than the new instruction.  If so, then add in a new iterator right here.
-    // If not, then move along.
-    ListOrderEntry queue_entry;
-    OpClass op_class = (*list_order_it).queueType;
-    ListOrderIt next_it = list_order_it;
-
-    ++next_it;
-
-    queue_entry.queueType = op_class;
-    queue_entry.oldestInst = readyInsts[op_class].top()->seqNum;
-
-    while (next_it != listOrder.end() &&
-           (*next_it).oldestInst < queue_entry.oldestInst) {
-        ++next_it;
+    assert(queues);
+
+    OpClass oldest = (OpClass)findLsbSet(queues);
+    queues &= queues - 1;
+
+    while (queues) {
+        OpClass op_class = (OpClass)findLsbSet(queues);
+        queues &= queues - 1;
+
+        if (oldestReady[op_class] < oldestReady[oldest])
+            oldest = op_class;
     }
 
-    readyIt[op_class] = listOrder.insert(next_it, queue_entry);
+    return oldest;
 }
 
 template <class Impl>
@@ -787,20 +769,19 @@ InstructionQueue<Impl>::scheduleReadyInsts()
         addReadyMemInst(mem_inst);
     }
 
-    // Have iterator to head of the list
-    // While I haven't exceeded bandwidth or reached the end of the list,
-    // Try to get a FU that can do what this op needs.
-    // If successful, change the oldestInst to the new top of the list, put
-    // the queue in the proper place in the list.
-    // Increment the iterator.
+    // While I haven't exceeded bandwidth or run out of ready queues,
+    // pick the queue with the oldest ready instruction and try to get a
+    // FU that can do what this op needs.
+    // If successful, the queue stays a candidate with its next oldest
+    // instruction.
+    // If not, drop the queue from the candidates for this cycle.
     // This will avoid trying to schedule a certain op class if there are no
     // FUs that handle it.
     int total_issued = 0;
-    ListOrderIt order_it = listOrder.begin();
-    ListOrderIt order_end_it = listOrder.end();
+    uint64_t candidates = readyQueues;
 
-    while (total_issued < totalWidth && order_it != order_end_it) {
-        OpClass op_class = (*order_it).queueType;
+    while (total_issued < totalWidth && candidates) {
+        OpClass op_class = oldestReadyQueue(candidates);
 
         assert(!readyInsts[op_class].empty());
 
@@ -814,19 +795,11 @@ InstructionQueue<Impl>::scheduleReadyInsts()
             intInstQueueReads++;
         }
 
-        assert(issuing_inst->seqNum == (*order_it).oldestInst);
+        assert(issuing_inst->seqNum == oldestReady[op_class]);
 
         if (issuing_inst->isSquashed()) {
-            readyInsts[op_class].pop();
-
-            if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
-            } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
-            }
-
-            listOrder.erase(order_it++);
+            popReadyInst(op_class);
+            candidates &= readyQueues;
 
             ++iqSquashedInstsIssued;
 
@@ -887,14 +860,8 @@ InstructionQueue<Impl>::scheduleReadyInsts()
                     tid, issuing_inst->pcState(),
                     issuing_inst->seqNum);
 
-            readyInsts[op_class].pop();
-
-            if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
-            } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
-            }
+            popReadyInst(op_class);
+            candidates &= readyQueues;
 
             issuing_inst->setIssued();
             ++total_issued;
@@ -913,12 +880,11 @@ InstructionQueue<Impl>::scheduleReadyInsts()
                 memDepUnit[tid].issue(issuing_inst);
             }
 
-            listOrder.erase(order_it++);
             statIssuedInstType[tid][op_class]++;
         } else {
             statFuBusy[op_class]++;
             fuBusy[tid]++;
-            ++order_it;
+            candidates &= ~(ULL(1) << op_class);
         }
     }
 
@@ -936,6 +902,13 @@ InstructionQueue<Impl>::scheduleReadyInsts()
     }
 }
 
+template <class Impl>
+void
+InstructionQueue<Impl>::skipTicks(Counter ticks)
+{
+    numIssuedDist.sample(0, ticks);
+}
+
 template <class Impl>
 void
 InstructionQueue<Impl>::scheduleNonSpec(const InstSeqNum &inst)
@@ -971,7 +944,7 @@ InstructionQueue<Impl>::commit(const InstSeqNum &inst, ThreadID tid)
     DPRINTF(IQ, "[tid:%i] Committing instructions older than [sn:%llu]\n",
             tid,inst);
 
-    ListIt iq_it = instList[tid].begin();
+    InstListIt iq_it = instList[tid].begin();
 
     while (iq_it != instList[tid].end() &&
            (*iq_it)->seqNum <= inst) {
@@ -1081,23 +1054,12 @@ template <class Impl>
 void
 InstructionQueue<Impl>::addReadyMemInst(const DynInstPtr &ready_inst)
 {
-    OpClass op_class = ready_inst->opClass();
-
-    readyInsts[op_class].push(ready_inst);
-
-    // Will need to reorder the list if either a queue is not on the list,
-    // or it has an older instruction than last time.
-    if (!queueOnList[op_class]) {
-        addToOrderList(op_class);
-    } else if (readyInsts[op_class].top()->seqNum  <
-               (*readyIt[op_class]).oldestInst) {
-        listOrder.erase(readyIt[op_class]);
-        addToOrderList(op_class);
-    }
+    pushReadyInst(ready_inst);
 
     DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
             "the ready list, PC %s opclass:%i [sn:%llu].\n",
-            ready_inst->pcState(), op_class, ready_inst->seqNum);
+            ready_inst->pcState(), ready_inst->opClass(),
+            ready_inst->seqNum);
 }
 
 template <class Impl>
@@ -1222,7 +1184,7 @@ void
 InstructionQueue<Impl>::doSquash(ThreadID tid)
 {
     // Start at the tail.
-    ListIt squash_it = instList[tid].end();
+    InstListIt squash_it = instList[tid].end();
     --squash_it;
 
     DPRINTF(IQ, "[tid:%i] Squashing until sequence number %i!\n",
@@ -1470,17 +1432,7 @@ InstructionQueue<Impl>::addIfReady(const DynInstPtr &inst)
                 "the ready list, PC %s opclass:%i [sn:%llu].\n",
                 inst->pcState(), op_class, inst->seqNum);
 
-        readyInsts[op_class].push(inst);
-
-        // Will need to reorder the list if either a queue is not on the list,
-        // or it has an older instruction than last time.
-        if (!queueOnList[op_class]) {
-            addToOrderList(op_class);
-        } else if (readyInsts[op_class].top()->seqNum  <
-                   (*readyIt[op_class]).oldestInst) {
-            listOrder.erase(readyIt[op_class]);
-            addToOrderList(op_class);
-        }
+        pushReadyInst(inst);
     }
 }
 
@@ -1516,18 +1468,11 @@ InstructionQueue<Impl>::dumpLists()
 
     cprintf("\n");
 
-    ListOrderIt list_order_it = listOrder.begin();
-    ListOrderIt list_order_end_it = listOrder.end();
-    int i = 1;
-
-    cprintf("List order: ");
+    cprintf("Oldest ready instructions: ");
 
-    while (list_order_it != list_order_end_it) {
-        cprintf("%i OpClass:%i [sn:%llu] ", i, (*list_order_it).queueType,
-                (*list_order_it).oldestInst);
-
-        ++list_order_it;
-        ++i;
+    for (int i = 0; i < Num_OpClasses; ++i) {
+        if (readyQueues & (ULL(1) << i))
+            cprintf("OpClass:%i [sn:%llu] ", i, oldestReady[i]);
     }
 
     cprintf("\n");
@@ -1541,7 +1486,7 @@ InstructionQueue<Impl>::dumpInsts()
     for (ThreadID tid = 0; tid < numThreads; ++tid) {
         int num = 0;
         int valid_num = 0;
-        ListIt inst_list_it = instList[tid].begin();
+        InstListIt inst_list_it = instList[tid].begin();
 
         while (inst_list_it != instList[tid].end()) {
             cprintf("Instruction:%i\n", num);
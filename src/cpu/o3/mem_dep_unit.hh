@@ -46,6 +46,7 @@
 #include <set>
 #include <unordered_map>
 
+#include "base/intrusive_list.hh"
 #include "base/statistics.hh"
 #include "cpu/inst_seq.hh"
 #include "debug/MemDepUnit.hh"
@@ -82,6 +83,7 @@ class MemDepUnit
     std::string _name;
 
   public:
+    typedef typename Impl::DynInst DynInst;
     typedef typename Impl::DynInstPtr DynInstPtr;
     typedef typename Impl::DynInstConstPtr DynInstConstPtr;
 
@@ -165,6 +167,19 @@ class MemDepUnit
   private:
     typedef typename std::list<DynInstPtr>::iterator ListIt;
 
+    /** Links of an instruction in the lists of the unit */
+    struct InstListHook
+    {
+        static IntrusiveListHook<DynInst> &
+        get(DynInst *inst)
+        {
+            return inst->memDepListHook;
+        }
+    };
+
+    typedef IntrusiveList<DynInst, InstListHook> InstList;
+    typedef typename InstList::iterator InstListIt;
+
     class MemDepEntry;
 
     typedef std::shared_ptr<MemDepEntry> MemDepEntryPtr;
@@ -209,7 +224,7 @@ class MemDepUnit
         DynInstPtr inst;
 
         /** The iterator to the instruction's location inside the list. */
-        ListIt listIt;
+        InstListIt listIt;
 
         /** A vector of any dependent instructions. */
         std::vector<MemDepEntryPtr> dependInsts;
@@ -245,7 +260,7 @@ class MemDepUnit
     MemDepHash memDepHash;
 
     /** A list of all instructions in the memory dependence unit. */
-    std::list<DynInstPtr> instList[Impl::MaxThreads];
+    InstList instList[Impl::MaxThreads];
 
     /** A list of all instructions that are going to be replayed. */
     std::list<DynInstPtr> instsToReplay;
@@ -71,7 +71,7 @@ MemDepUnit<MemDepPred, Impl>::~MemDepUnit()
 {
     for (ThreadID tid = 0; tid < Impl::MaxThreads; tid++) {
 
-        ListIt inst_list_it = instList[tid].begin();
+        InstListIt inst_list_it = instList[tid].begin();
 
         MemDepHashIt hash_it;
 
@@ -182,7 +182,7 @@ MemDepUnit<MemDepPred, Impl>::insert(const DynInstPtr &inst)
     MemDepEntry::memdep_insert++;
 #endif
 
-    instList[tid].push_back(inst);
+    instList[tid].push_back(inst.get());
 
     inst_entry->listIt = --(instList[tid].end());
 
@@ -280,7 +280,7 @@ MemDepUnit<MemDepPred, Impl>::insertNonSpec(const DynInstPtr &inst)
 #endif
 
     // Add the instruction to the list.
-    instList[tid].push_back(inst);
+    instList[tid].push_back(inst.get());
 
     inst_entry->listIt = --(instList[tid].end());
 
@@ -331,7 +331,7 @@ MemDepUnit<MemDepPred, Impl>::insertBarrier(const DynInstPtr &barr_inst)
 #endif
 
     // Add the instruction to the instruction list.
-    instList[tid].push_back(barr_inst);
+    instList[tid].push_back(barr_inst.get());
 
     inst_entry->listIt = --(instList[tid].end());
 }
@@ -496,7 +496,7 @@ MemDepUnit<MemDepPred, Impl>::squash(const InstSeqNum &squashed_num,
         }
     }
 
-    ListIt squash_it = instList[tid].end();
+    InstListIt squash_it = instList[tid].end();
     --squash_it;
 
     MemDepHashIt hash_it;
@@ -587,7 +587,7 @@ MemDepUnit<MemDepPred, Impl>::dumpLists()
         cprintf("Instruction list %i size: %i\n",
                 tid, instList[tid].size());
 
-        ListIt inst_list_it = instList[tid].begin();
+        InstListIt inst_list_it = instList[tid].begin();
         int num = 0;
 
         while (inst_list_it != instList[tid].end()) {
@@ -199,6 +199,16 @@ class DefaultRename
      */
     void tick();
 
+    /** Checks that an inactive rename has nothing left to do on its own,
+     * so that the CPU can skip its ticks.
+     */
+    bool canSkipTick() const { return !resumeSerialize && !resumeUnblocking; }
+
+    /** Counts ticks that the CPU skipped while rename was quiescent in
+     * the per-cycle stats, as tick() would have.
+     */
+    void skipTicks(Counter ticks);
+
     /** Debugging function used to dump history buffer of renamings. */
     void dumpHistory();
 
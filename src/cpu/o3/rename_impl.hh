@@ -485,6 +485,26 @@ DefaultRename<Impl>::tick()
 
 }
 
+template <class Impl>
+void
+DefaultRename<Impl>::skipTicks(Counter ticks)
+{
+    for (auto tid : *activeThreads) {
+        if (renameStatus[tid] == Blocked) {
+            renameBlockCycles += ticks;
+        } else if (renameStatus[tid] == Squashing) {
+            renameSquashCycles += ticks;
+        } else if (renameStatus[tid] == SerializeStall) {
+            renameSerializeStallCycles += ticks;
+        } else if (renameStatus[tid] == Running ||
+                   renameStatus[tid] == Idle) {
+            // Nothing comes from decode while rename is quiescent
+            assert(insts[tid].empty());
+            renameIdleCycles += ticks;
+        }
+    }
+}
+
 template<class Impl>
 void
 DefaultRename<Impl>::rename(bool &status_change, ThreadID tid)
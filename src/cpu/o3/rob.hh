@@ -46,6 +46,7 @@
 #include <vector>
 
 #include "arch/registers.hh"
+#include "base/intrusive_list.hh"
 #include "base/types.hh"
 #include "config/the_isa.hh"
 #include "enums/SMTQueuePolicy.hh"
@@ -61,10 +62,23 @@ class ROB
   public:
     //Typedefs from the Impl.
     typedef typename Impl::O3CPU O3CPU;
+    typedef typename Impl::DynInst DynInst;
     typedef typename Impl::DynInstPtr DynInstPtr;
 
     typedef std::pair<RegIndex, PhysRegIndex> UnmapInfo;
-    typedef typename std::list<DynInstPtr>::iterator InstIt;
+
+    /** Links of an instruction in the ROB list */
+    struct InstListHook
+    {
+        static IntrusiveListHook<DynInst> &
+        get(DynInst *inst)
+        {
+            return inst->robListHook;
+        }
+    };
+
+    typedef IntrusiveList<DynInst, InstListHook> InstList;
+    typedef typename InstList::iterator InstIt;
 
     /** Possible ROB statuses. */
     enum Status {
@@ -117,7 +131,7 @@ class ROB
      *  the ROB.
      *  @return Pointer to the DynInst that is at the head of the ROB.
      */
-    const DynInstPtr &readHeadInst(ThreadID tid);
+    DynInstPtr readHeadInst(ThreadID tid);
 
     /** Returns a pointer to the instruction with the given sequence if it is
      *  in the ROB.
@@ -280,7 +294,7 @@ class ROB
     unsigned maxEntries[Impl::MaxThreads];
 
     /** ROB List of Instructions */
-    std::list<DynInstPtr> instList[Impl::MaxThreads];
+    InstList instList[Impl::MaxThreads];
 
     /** Number of instructions that can be squashed in a single cycle. */
     unsigned squashWidth;
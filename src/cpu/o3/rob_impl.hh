@@ -212,7 +212,7 @@ ROB<Impl>::insertInst(const DynInstPtr &inst)
 
     ThreadID tid = inst->threadNumber;
 
-    instList[tid].push_back(inst);
+    instList[tid].push_back(inst.get());
 
     //Set Up head iterator if this is the 1st instruction in the ROB
     if (numInstsInROB == 0) {
@@ -503,7 +503,7 @@ ROB<Impl>::squash(InstSeqNum squash_num, ThreadID tid)
 }
 
 template <class Impl>
-const typename Impl::DynInstPtr&
+typename Impl::DynInstPtr
 ROB<Impl>::readHeadInst(ThreadID tid)
 {
     if (threadEntries[tid] != 0) {
@@ -59,6 +59,11 @@ class AtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
+    bb_cache = Param.Bool(False, "Execute pre-decoded basic blocks, "
+        "fetching through memory backdoors, for fast functional "
+        "simulation")
+    bb_cache_size = Param.Unsigned(65536, "Number of basic blocks cached "
+        "before the basic block cache is flushed")
 
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
@@ -39,3 +39,11 @@ class TimingSimpleCPU(BaseSimpleCPU):
     @classmethod
     def support_take_over(cls):
         return True
+
+    functional_warm = Param.Bool(False, "Serve memory accesses through "
+        "memory backdoors instead of the memory system, charging fixed "
+        "latencies")
+    functional_warm_fetch_latency = Param.Cycles(1, "Latency of an "
+        "instruction fetch in functional-warm mode")
+    functional_warm_data_latency = Param.Cycles(2, "Latency of a data "
+        "access in functional-warm mode")
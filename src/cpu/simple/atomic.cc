@@ -82,14 +82,22 @@ AtomicSimpleCPU::AtomicSimpleCPU(AtomicSimpleCPUParams *p)
       simulate_inst_stalls(p->simulate_inst_stalls),
       icachePort(name() + ".icache_port", this),
       dcachePort(name() + ".dcache_port", this),
-      dcache_access(false), dcache_latency(0),
+      dcache_access(false), dcache_latency(0), bbFetchLatency(0),
       ppCommit(nullptr)
 {
+    if (p->bb_cache) {
+        if (numThreads > 1)
+            warn("%s: The basic block cache does not support SMT.\n",
+                 name());
+        else
+            bbCache.reset(new BasicBlockCache(p->bb_cache_size));
+    }
+
     _status = Idle;
-    ifetch_req = std::make_shared<Request>();
-    data_read_req = std::make_shared<Request>();
-    data_write_req = std::make_shared<Request>();
-    data_amo_req = std::make_shared<Request>();
+    ifetch_req = Request::create();
+    data_read_req = Request::create();
+    data_write_req = Request::create();
+    data_amo_req = Request::create();
 }
 
 
@@ -150,6 +158,9 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // Memory may have been changed behind our back while drained.
+    flushBBCache();
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -208,6 +219,8 @@ AtomicSimpleCPU::takeOverFrom(BaseCPU *oldCPU)
 
     // The tick event should have been descheduled by drain()
     assert(!tickEvent.scheduled());
+
+    flushBBCache();
 }
 
 void
@@ -507,6 +520,9 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
             }
 
             if (do_access && !req->getFlags().isSet(Request::NO_ACCESS)) {
+                if (bbCache)
+                    bbCache->notifyWrite(req->getPaddr(), req->getSize());
+
                 Packet pkt(req, Packet::makeWriteCmd(req));
                 pkt.dataStatic(data);
 
@@ -601,6 +617,9 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
 
     // Now do the access.
     if (fault == NoFault && !req->getFlags().isSet(Request::NO_ACCESS)) {
+        if (bbCache)
+            bbCache->notifyWrite(req->getPaddr(), req->getSize());
+
         // We treat AMO accesses as Write accesses with SwapReq command
         // data will hold the return data of the AMO access
         Packet pkt(req, Packet::makeWriteCmd(req));
@@ -654,7 +673,8 @@ AtomicSimpleCPU::tick()
         updateCycleCounters(BaseCPU::CPU_STATE_ON);
 
         if (!curStaticInst || !curStaticInst->isDelayedCommit()) {
-            checkForInterrupts();
+            if (checkForInterrupts() && bbCache)
+                bbCache->endBlock();
             checkPcEventQueue();
         }
 
@@ -670,11 +690,35 @@ AtomicSimpleCPU::tick()
 
         bool needToFetch = !isRomMicroPC(pcState.microPC()) &&
                            !curMacroStaticInst;
-        if (needToFetch) {
+
+        // Instructions in a cached basic block are neither translated
+        // nor fetched, only the first instruction of a block is.
+        const BasicBlockCache::Entry *cached = nullptr;
+        if (needToFetch && bbCache)
+            cached = bbCache->next(pcState);
+
+        if (needToFetch && !cached) {
             ifetch_req->taskId(taskId());
             setupFetchRequest(ifetch_req);
             fault = thread->itb->translateAtomic(ifetch_req, thread->getTC(),
                                                  BaseTLB::Execute);
+
+            if (bbCache && fault == NoFault && t_info.fetchOffset == 0 &&
+                !bbCache->isRecording()) {
+                cached = bbCache->enter(ifetch_req->getPaddr(), pcState,
+                                        thread->decoder.decodeContext());
+                if (cached) {
+                    ++bbCacheHits;
+                } else {
+                    ++bbCacheMisses;
+                    // The decoder has been bypassed by previous blocks
+                    thread->decoder.reset();
+                    if (!ifetch_req->isUncacheable()) {
+                        bbCache->beginBlock(ifetch_req->getPaddr(),
+                            thread->decoder.decodeContext());
+                    }
+                }
+            }
         }
 
         if (fault == NoFault) {
@@ -682,7 +726,12 @@ AtomicSimpleCPU::tick()
             bool icache_access = false;
             dcache_access = false; // assume no dcache access
 
-            if (needToFetch) {
+            if (cached) {
+                icache_access = true;
+                icache_latency = bbFetchLatency;
+                ++bbCacheInsts;
+                thread->pcState(cached->decodedPC);
+            } else if (needToFetch) {
                 // This is commented out because the decoder would act like
                 // a tiny cache otherwise. It wouldn't be flushed when needed
                 // like the I cache. It should be flushed, and when that works
@@ -691,19 +740,18 @@ AtomicSimpleCPU::tick()
                 //if (decoder.needMoreBytes())
                 //{
                     icache_access = true;
-                    Packet ifetch_pkt = Packet(ifetch_req, MemCmd::ReadReq);
-                    ifetch_pkt.dataStatic(&inst);
-
-                    icache_latency = sendPacket(icachePort, &ifetch_pkt);
-
-                    assert(!ifetch_pkt.isError());
-
-                    // ifetch_req is initialized to read the instruction directly
-                    // into the CPU object's inst field.
+                    icache_latency = fetchInst();
                 //}
             }
 
-            preExecute();
+            preExecute(cached ? cached->inst : StaticInst::nullStaticInstPtr);
+
+            if (needToFetch && !cached && bbCache &&
+                bbCache->isRecording() && !t_info.stayAtPC) {
+                bbCache->addInst(pcState, thread->pcState(),
+                                 curMacroStaticInst ? curMacroStaticInst :
+                                 curStaticInst);
+            }
 
             Tick stall_ticks = 0;
             if (curStaticInst) {
@@ -728,6 +776,21 @@ AtomicSimpleCPU::tick()
                 }
 
                 postExecute();
+
+                if (bbCache) {
+                    if (t_info.miscRegWritten ||
+                        curStaticInst->isSerializeAfter() ||
+                        curStaticInst->isSquashAfter()) {
+                        // The instruction may have changed how the
+                        // following instructions decode, which the
+                        // blocks are tagged with.
+                        t_info.miscRegWritten = false;
+                        bbCache->endBlock();
+                    } else if (curStaticInst->isControl() &&
+                               bbCache->isRecording()) {
+                        bbCache->finishBlock();
+                    }
+                }
             }
 
             // @todo remove me after debugging with legion done
@@ -750,6 +813,12 @@ AtomicSimpleCPU::tick()
             }
 
         }
+
+        // Faults may switch to a mode in which instructions decode
+        // differently.
+        if (fault != NoFault && bbCache)
+            bbCache->endBlock();
+
         if (fault != NoFault || !t_info.stayAtPC)
             advancePC(fault);
     }
@@ -765,6 +834,88 @@ AtomicSimpleCPU::tick()
         reschedule(tickEvent, curTick() + latency, true);
 }
 
+Tick
+AtomicSimpleCPU::fetchInst()
+{
+    // ifetch_req is initialized to read the instruction directly
+    // into the CPU object's inst field.
+    if (bbCache && !ifetch_req->isUncacheable()) {
+        const Addr paddr = ifetch_req->getPaddr();
+        SimpleExecContext &t_info = *threadInfo[curThread];
+        if (bbCache->isRecording() &&
+            !bbCache->addFetch(paddr, sizeof(inst)) &&
+            t_info.fetchOffset == 0) {
+            // The block ended on an instruction boundary, so carry on
+            // recording a new one from this instruction.
+            bbCache->beginBlock(paddr,
+                                t_info.thread->decoder.decodeContext());
+            bbCache->addFetch(paddr, sizeof(inst));
+        }
+
+        const uint8_t *ptr = bbCache->hostPtr(paddr, sizeof(inst));
+        if (ptr) {
+            memcpy(&inst, ptr, sizeof(inst));
+            return bbFetchLatency;
+        }
+
+        Packet ifetch_pkt(ifetch_req, MemCmd::ReadReq);
+        ifetch_pkt.dataStatic(&inst);
+
+        MemBackdoorPtr backdoor = nullptr;
+        Tick latency = icachePort.sendAtomicBackdoor(&ifetch_pkt, backdoor);
+        assert(!ifetch_pkt.isError());
+
+        if (backdoor) {
+            bbCache->addBackdoor(backdoor);
+            bbFetchLatency = latency;
+        }
+        return latency;
+    }
+
+    Packet ifetch_pkt(ifetch_req, MemCmd::ReadReq);
+    ifetch_pkt.dataStatic(&inst);
+
+    Tick latency = sendPacket(icachePort, &ifetch_pkt);
+    assert(!ifetch_pkt.isError());
+
+    return latency;
+}
+
+void
+AtomicSimpleCPU::flushBBCache()
+{
+    if (bbCache) {
+        ++bbCacheFlushes;
+        bbCache->flush();
+    }
+}
+
+void
+AtomicSimpleCPU::regStats()
+{
+    BaseSimpleCPU::regStats();
+
+    bbCacheHits
+        .name(name() + ".bb_cache_hits")
+        .desc("Basic blocks executed out of the basic block cache")
+        ;
+
+    bbCacheMisses
+        .name(name() + ".bb_cache_misses")
+        .desc("Basic blocks missing in the basic block cache")
+        ;
+
+    bbCacheInsts
+        .name(name() + ".bb_cache_insts")
+        .desc("Instructions executed without being fetched and decoded")
+        ;
+
+    bbCacheFlushes
+        .name(name() + ".bb_cache_flushes")
+        .desc("Number of times the basic block cache was flushed")
+        ;
+}
+
 void
 AtomicSimpleCPU::regProbePoints()
 {
@@ -41,7 +41,10 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include <memory>
+
 #include "cpu/simple/base.hh"
+#include "cpu/simple/bb_cache.hh"
 #include "cpu/simple/exec_context.hh"
 #include "mem/request.hh"
 #include "params/AtomicSimpleCPU.hh"
@@ -55,6 +58,7 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     virtual ~AtomicSimpleCPU();
 
     void init() override;
+    void regStats() override;
 
   protected:
 
@@ -166,6 +170,30 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     bool dcache_access;
     Tick dcache_latency;
 
+    /** Pre-decoded basic blocks, if enabled. */
+    std::unique_ptr<BasicBlockCache> bbCache;
+    /** Latency reported when the current fetch backdoor was set up. */
+    Tick bbFetchLatency;
+
+    /** Blocks executed out of the basic block cache. */
+    Stats::Scalar bbCacheHits;
+    /** Blocks which were not cached and had to be decoded. */
+    Stats::Scalar bbCacheMisses;
+    /** Instructions not fetched and decoded thanks to the cache. */
+    Stats::Scalar bbCacheInsts;
+    /** Times the basic block cache was flushed. */
+    Stats::Scalar bbCacheFlushes;
+
+    /**
+     * Fetch the instruction bytes ifetch_req refers to into inst,
+     * through a memory backdoor if one covers them.
+     * @return The fetch latency.
+     */
+    Tick fetchInst();
+
+    /** Flush the basic block cache, if there is one. */
+    void flushBBCache();
+
     /** Probe Points. */
     ProbePointArg<std::pair<SimpleThread*, const StaticInstPtr>> *ppCommit;
 
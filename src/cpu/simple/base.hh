@@ -121,9 +121,15 @@ class BaseSimpleCPU : public BaseCPU
     Status _status;
 
   public:
-    void checkForInterrupts();
+    /** @return true if an interrupt was taken. */
+    bool checkForInterrupts();
     void setupFetchRequest(const RequestPtr &req);
-    void preExecute();
+    /**
+     * @param predecoded An instruction decoded earlier for the current
+     * PC, which is used instead of decoding the fetched bytes.
+     */
+    void preExecute(const StaticInstPtr &predecoded =
+                    StaticInst::nullStaticInstPtr);
     void postExecute();
     void advancePC(const Fault &fault);
 
@@ -0,0 +1,194 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/bb_cache.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#include "base/trace.hh"
+#include "debug/BasicBlockCache.hh"
+
+BasicBlockCache::BasicBlockCache(size_t max_blocks)
+    : maxBlocks(max_blocks), current(nullptr), currentPos(0),
+      recordingEnd(0)
+{
+}
+
+BasicBlockCache::~BasicBlockCache()
+{
+}
+
+const uint8_t *
+BasicBlockCache::hostPtr(Addr paddr, Addr size) const
+{
+    for (const auto *bd : backdoors) {
+        const AddrRange &range = bd->range();
+        if (range.contains(paddr) && range.contains(paddr + size - 1))
+            return bd->ptr() + (paddr - range.start());
+    }
+    return nullptr;
+}
+
+void
+BasicBlockCache::addBackdoor(MemBackdoorPtr backdoor)
+{
+    if (!backdoor->readable() ||
+        std::find(backdoors.begin(), backdoors.end(), backdoor) !=
+        backdoors.end()) {
+        return;
+    }
+
+    DPRINTF(BasicBlockCache, "Fetching %s through a backdoor.\n",
+            backdoor->range().to_string());
+    backdoors.push_back(backdoor);
+    backdoor->addInvalidationCallback(
+        [this](const MemBackdoor &bd) {
+            DPRINTF(BasicBlockCache, "Backdoor for %s invalidated.\n",
+                    bd.range().to_string());
+            backdoors.erase(std::remove(backdoors.begin(), backdoors.end(),
+                                        &bd),
+                            backdoors.end());
+            flush();
+        });
+}
+
+bool
+BasicBlockCache::matchesMemory(const Block &block) const
+{
+    const uint8_t *ptr = hostPtr(block.bytesAddr, block.bytes.size());
+    return ptr && std::memcmp(ptr, block.bytes.data(),
+                              block.bytes.size()) == 0;
+}
+
+const BasicBlockCache::Entry *
+BasicBlockCache::enter(Addr paddr, const TheISA::PCState &pc,
+                       uint64_t decode_context)
+{
+    Block *pred = current;
+    Block *block = nullptr;
+    current = nullptr;
+
+    // Blocks are usually entered from the same few predecessors, so
+    // try the ones this block was chained to before doing a lookup.
+    if (pred) {
+        for (auto *succ : pred->successors) {
+            if (succ && succ->paddr == paddr &&
+                succ->decodeContext == decode_context &&
+                succ->entries.front().pc == pc && matchesMemory(*succ)) {
+                block = succ;
+                break;
+            }
+        }
+    }
+
+    if (!block) {
+        Block **found = blockMap.find(paddr);
+        block = found ? *found : nullptr;
+        if (!block || block->decodeContext != decode_context ||
+            !(block->entries.front().pc == pc) || !matchesMemory(*block)) {
+            return nullptr;
+        }
+        if (pred) {
+            pred->successors[pred->nextSuccessor] = block;
+            pred->nextSuccessor ^= 1;
+        }
+    }
+
+    current = block;
+    currentPos = 1;
+    return &block->entries.front();
+}
+
+void
+BasicBlockCache::beginBlock(Addr paddr, uint64_t decode_context)
+{
+    recording.reset(new Block);
+    recording->paddr = paddr;
+    recording->bytesAddr = paddr;
+    recording->decodeContext = decode_context;
+    recording->successors.fill(nullptr);
+    recording->nextSuccessor = 0;
+    recordingEnd = paddr;
+}
+
+bool
+BasicBlockCache::addFetch(Addr paddr, Addr size)
+{
+    assert(recording);
+
+    // The bytes of a block have to be contiguous and on a single page
+    // for the translation of the first fetch to cover all of them.
+    if (paddr < recording->bytesAddr || paddr > recordingEnd ||
+        pageOf(paddr + size - 1) != pageOf(recording->bytesAddr) ||
+        recording->entries.size() >= MaxBlockInsts) {
+        finishBlock();
+        return false;
+    }
+
+    recordingEnd = std::max(recordingEnd, paddr + size);
+    return true;
+}
+
+void
+BasicBlockCache::addInst(const TheISA::PCState &pc,
+                         const TheISA::PCState &decoded_pc,
+                         const StaticInstPtr &inst)
+{
+    assert(recording);
+    recording->entries.push_back(Entry{pc, decoded_pc, inst});
+}
+
+void
+BasicBlockCache::finishBlock()
+{
+    std::unique_ptr<Block> block(std::move(recording));
+    if (!block || block->entries.empty())
+        return;
+
+    const Addr size = recordingEnd - block->bytesAddr;
+    const uint8_t *ptr = hostPtr(block->bytesAddr, size);
+    if (!ptr)
+        return;
+    block->bytes.assign(ptr, ptr + size);
+
+    if (blocks.size() >= maxBlocks)
+        flush();
+
+    DPRINTF(BasicBlockCache, "Block at %#x: %d instructions, %d bytes.\n",
+            block->paddr, block->entries.size(), size);
+    blockMap[block->paddr] = block.get();
+    blocks.push_back(std::move(block));
+}
+
+void
+BasicBlockCache::flush()
+{
+    DPRINTF(BasicBlockCache, "Flushing %d blocks.\n", blocks.size());
+    current = nullptr;
+    recording.reset();
+    blockMap.clear();
+    blocks.clear();
+}
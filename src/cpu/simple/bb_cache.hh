@@ -0,0 +1,232 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_BB_CACHE_HH__
+#define __CPU_SIMPLE_BB_CACHE_HH__
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "arch/isa_traits.hh"
+#include "arch/types.hh"
+#include "base/flat_hash_map.hh"
+#include "base/types.hh"
+#include "config/the_isa.hh"
+#include "cpu/static_inst.hh"
+#include "mem/backdoor.hh"
+
+/**
+ * A cache of basic blocks of pre-decoded instructions, used by the
+ * atomic CPU to fast-forward without translating, fetching and
+ * decoding every instruction.
+ *
+ * A block is a run of instructions recorded as they were fetched and
+ * decoded, all of which come from the same physical page. Blocks are
+ * indexed by the physical address of their first fetch, so a block is
+ * only entered after its first instruction has been translated, which
+ * takes care of remapped pages and of fetch permissions. The bytes an
+ * instruction was decoded from are read through a memory backdoor, and
+ * the block keeps a copy of them which is compared against memory
+ * whenever the block is entered. Code modified while a block is
+ * executing is therefore only noticed at the next block boundary,
+ * except for stores made by the CPU itself, which are reported through
+ * notifyWrite().
+ *
+ * Blocks are also tagged with the decoder context they were decoded
+ * in, see the decodeContext() of the ISA decoders, and only entered in
+ * the same context. When the context may change, e.g. on a fault, the
+ * CPU only has to end the current block.
+ */
+class BasicBlockCache
+{
+  public:
+    /** A pre-decoded instruction. */
+    struct Entry
+    {
+        /** PC state before the instruction was decoded. */
+        TheISA::PCState pc;
+        /** PC state as the decoder left it. */
+        TheISA::PCState decodedPC;
+        /** The decoded instruction. Macroops are kept whole. */
+        StaticInstPtr inst;
+    };
+
+    struct Block
+    {
+        /** Physical address of the first fetch of the block. */
+        Addr paddr;
+        /** Physical address of the bytes the block was decoded from. */
+        Addr bytesAddr;
+        /** Context of the decoder the block was decoded in. */
+        uint64_t decodeContext;
+        /** Copy of the bytes the block was decoded from. */
+        std::vector<uint8_t> bytes;
+        std::vector<Entry> entries;
+        /** Blocks recently entered from this one. */
+        std::array<Block *, 2> successors;
+        /** Next successor slot to replace. */
+        unsigned nextSuccessor;
+    };
+
+  protected:
+    /** All blocks, including blocks replaced in the map. */
+    std::vector<std::unique_ptr<Block>> blocks;
+    FlatHashMap<Addr, Block *> blockMap;
+    /** Number of blocks after which the cache is flushed. */
+    const size_t maxBlocks;
+    /** Maximum number of instructions in a block. */
+    static const size_t MaxBlockInsts = 64;
+
+    /** Block being executed, if any. */
+    Block *current;
+    /** Index of the next entry of the current block. */
+    size_t currentPos;
+
+    /** Block being recorded, if any. */
+    std::unique_ptr<Block> recording;
+    /** End of the bytes fetched for the block being recorded. */
+    Addr recordingEnd;
+
+    /** Backdoors instructions can be fetched through. */
+    std::vector<MemBackdoorPtr> backdoors;
+
+    static Addr pageOf(Addr addr) { return addr & ~(TheISA::PageBytes - 1); }
+
+    /** Check that a block still matches the memory it was decoded from. */
+    bool matchesMemory(const Block &block) const;
+
+  public:
+    BasicBlockCache(size_t max_blocks);
+    ~BasicBlockCache();
+
+    /**
+     * Look up a backdoor for a range of physical addresses.
+     * @return A host pointer to the data, or nullptr if no readable
+     * backdoor covers the whole range.
+     */
+    const uint8_t *hostPtr(Addr paddr, Addr size) const;
+
+    /**
+     * Remember a backdoor to fetch through. It is forgotten, and the
+     * cache flushed, when the backdoor is invalidated.
+     */
+    void addBackdoor(MemBackdoorPtr backdoor);
+
+    /**
+     * Get the next instruction of the block being executed.
+     * @param pc Current PC state of the thread.
+     * @return The entry, or nullptr if the thread left the block.
+     */
+    const Entry *
+    next(const TheISA::PCState &pc)
+    {
+        if (!current)
+            return nullptr;
+        if (currentPos < current->entries.size() &&
+            current->entries[currentPos].pc == pc) {
+            return &current->entries[currentPos++];
+        }
+        return nullptr;
+    }
+
+    /**
+     * Enter the block starting at an instruction boundary, if it is
+     * cached and still matches memory.
+     * @param paddr Physical address of the first fetch.
+     * @param pc Current PC state of the thread.
+     * @param decode_context Current context of the decoder.
+     * @return The first entry of the block, or nullptr on a miss.
+     */
+    const Entry *enter(Addr paddr, const TheISA::PCState &pc,
+                       uint64_t decode_context);
+
+    /** Stop executing out of the current block. */
+    void leave() { current = nullptr; }
+
+    /**
+     * Start recording a new block at the fetch address paddr, decoded
+     * in the given decoder context.
+     */
+    void beginBlock(Addr paddr, uint64_t decode_context);
+
+    bool isRecording() const { return recording != nullptr; }
+
+    /**
+     * Add a fetch to the block being recorded.
+     * @return false if the block cannot include the fetch, in which
+     * case it has been finished without the instruction being fetched.
+     */
+    bool addFetch(Addr paddr, Addr size);
+
+    /** Add a decoded instruction to the block being recorded. */
+    void addInst(const TheISA::PCState &pc,
+                 const TheISA::PCState &decoded_pc,
+                 const StaticInstPtr &inst);
+
+    /** Finish the block being recorded and make it available. */
+    void finishBlock();
+
+    /** Drop the block being recorded. */
+    void abortBlock() { recording.reset(); }
+
+    /**
+     * Stop executing the current block and finish the one being
+     * recorded, as the decoder context may change after this point.
+     */
+    void
+    endBlock()
+    {
+        leave();
+        if (recording)
+            finishBlock();
+    }
+
+    /**
+     * Report a store by the CPU, which stops the current block and
+     * drops the block being recorded if the store covers their page.
+     */
+    void
+    notifyWrite(Addr paddr, Addr size)
+    {
+        const Addr first = pageOf(paddr);
+        const Addr last = pageOf(paddr + size - 1);
+        if (current && pageOf(current->bytesAddr) >= first &&
+            pageOf(current->bytesAddr) <= last) {
+            current = nullptr;
+        }
+        if (recording && pageOf(recording->bytesAddr) >= first &&
+            pageOf(recording->bytesAddr) <= last) {
+            recording.reset();
+        }
+    }
+
+    /** Drop all blocks. */
+    void flush();
+
+    size_t size() const { return blocks.size(); }
+};
+
+#endif // __CPU_SIMPLE_BB_CACHE_HH__
@@ -72,6 +72,10 @@ class SimpleExecContext : public ExecContext {
     // Branch prediction
     TheISA::PCState predPC;
 
+    // Set whenever a miscellaneous register is written. Never cleared
+    // here; CPUs that care reset it themselves.
+    bool miscRegWritten;
+
     /** PER-THREAD STATS */
 
     // Number of simulated instructions
@@ -166,6 +170,7 @@ class SimpleExecContext : public ExecContext {
     /** Constructor */
     SimpleExecContext(BaseSimpleCPU* _cpu, SimpleThread* _thread)
         : cpu(_cpu), thread(_thread), fetchOffset(0), stayAtPC(false),
+        miscRegWritten(false),
         numInst(0), numOp(0), numLoad(0), lastIcacheStall(0), lastDcacheStall(0)
     { }
 
@@ -393,6 +398,7 @@ class SimpleExecContext : public ExecContext {
         numIntRegWrites++;
         const RegId& reg = si->destRegIdx(idx);
         assert(reg.isMiscReg());
+        miscRegWritten = true;
         thread->setMiscReg(reg.index(), val);
     }
 
@@ -415,6 +421,7 @@ class SimpleExecContext : public ExecContext {
     setMiscReg(int misc_reg, RegVal val) override
     {
         numIntRegWrites++;
+        miscRegWritten = true;
         thread->setMiscReg(misc_reg, val);
     }
 
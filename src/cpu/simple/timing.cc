@@ -76,6 +76,10 @@ TimingSimpleCPU::TimingCPUPort::TickEvent::schedule(PacketPtr _pkt, Tick t)
 TimingSimpleCPU::TimingSimpleCPU(TimingSimpleCPUParams *p)
     : BaseSimpleCPU(p), fetchTranslation(this), icachePort(this),
       dcachePort(this), ifetch_pkt(NULL), dcache_pkt(NULL), previousCycle(0),
+      warmMemory(p->functional_warm ? new BackdoorMemory(p->system) :
+                 nullptr),
+      warmFetchLatency(p->functional_warm_fetch_latency),
+      warmDataLatency(p->functional_warm_data_latency),
       fetchEvent([this]{ fetch(); }, name())
 {
     _status = Idle;
@@ -270,7 +274,7 @@ TimingSimpleCPU::handleReadPacket(PacketPtr pkt)
         new IprEvent(pkt, this, clockEdge(delay));
         _status = DcacheWaitResponse;
         dcache_pkt = NULL;
-    } else if (!dcachePort.sendTimingReq(pkt)) {
+    } else if (!sendDcacheReq(pkt)) {
         _status = DcacheRetry;
         dcache_pkt = pkt;
     } else {
@@ -428,7 +432,7 @@ TimingSimpleCPU::initiateMemRead(Addr addr, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, size, flags, dataMasterId(), pc, thread->contextId());
     if (!byte_enable.empty()) {
         req->setByteEnable(byte_enable);
@@ -478,7 +482,7 @@ TimingSimpleCPU::handleWritePacket()
         new IprEvent(dcache_pkt, this, clockEdge(delay));
         _status = DcacheWaitResponse;
         dcache_pkt = NULL;
-    } else if (!dcachePort.sendTimingReq(dcache_pkt)) {
+    } else if (!sendDcacheReq(dcache_pkt)) {
         _status = DcacheRetry;
     } else {
         _status = DcacheWaitResponse;
@@ -512,7 +516,7 @@ TimingSimpleCPU::writeMem(uint8_t *data, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, size, flags, dataMasterId(), pc, thread->contextId());
     if (!byte_enable.empty()) {
         req->setByteEnable(byte_enable);
@@ -570,7 +574,7 @@ TimingSimpleCPU::initiateMemAMO(Addr addr, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = make_shared<Request>(addr, size, flags,
+    RequestPtr req = Request::create(addr, size, flags,
                             dataMasterId(), pc, thread->contextId(),
                             std::move(amo_op));
 
@@ -668,7 +672,7 @@ TimingSimpleCPU::fetch()
 
     if (needToFetch) {
         _status = BaseSimpleCPU::Running;
-        RequestPtr ifetch_req = std::make_shared<Request>();
+        RequestPtr ifetch_req = Request::create();
         ifetch_req->taskId(taskId());
         ifetch_req->setContext(thread->contextId());
         setupFetchRequest(ifetch_req);
@@ -696,7 +700,7 @@ TimingSimpleCPU::sendFetch(const Fault &fault, const RequestPtr &req,
         ifetch_pkt->dataStatic(&inst);
         DPRINTF(SimpleCPU, " -- pkt addr: %#x\n", ifetch_pkt->getAddr());
 
-        if (!icachePort.sendTimingReq(ifetch_pkt)) {
+        if (!sendIcacheReq(ifetch_pkt)) {
             // Need to wait for retry
             _status = IcacheRetry;
         } else {
@@ -717,6 +721,32 @@ TimingSimpleCPU::sendFetch(const Fault &fault, const RequestPtr &req,
 }
 
 
+bool
+TimingSimpleCPU::sendIcacheReq(PacketPtr pkt)
+{
+    if (!warmMemory || !warmMemory->canAccess(pkt->req))
+        return icachePort.sendTimingReq(pkt);
+
+    warmMemory->access(pkt);
+    schedule(new EventFunctionWrapper([this, pkt]{ completeIfetch(pkt); },
+                                      name() + ".warmFetchEvent", true),
+             clockEdge(warmFetchLatency));
+    return true;
+}
+
+bool
+TimingSimpleCPU::sendDcacheReq(PacketPtr pkt)
+{
+    if (!warmMemory || !warmMemory->canAccess(pkt->req))
+        return dcachePort.sendTimingReq(pkt);
+
+    warmMemory->access(pkt);
+    schedule(new EventFunctionWrapper([this, pkt]{ completeDataAccess(pkt); },
+                                      name() + ".warmDataEvent", true),
+             clockEdge(warmDataLatency));
+    return true;
+}
+
 void
 TimingSimpleCPU::advanceInst(const Fault &fault)
 {
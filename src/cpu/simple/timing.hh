@@ -41,6 +41,9 @@
 #ifndef __CPU_SIMPLE_TIMING_HH__
 #define __CPU_SIMPLE_TIMING_HH__
 
+#include <memory>
+
+#include "cpu/backdoor_memory.hh"
 #include "cpu/simple/base.hh"
 #include "cpu/simple/exec_context.hh"
 #include "cpu/translation.hh"
@@ -149,6 +152,15 @@ class TimingSimpleCPU : public BaseSimpleCPU
     // This function always implicitly uses dcache_pkt.
     bool handleWritePacket();
 
+    /**
+     * Send a fetch or data packet, or perform it functionally in
+     * functional-warm mode, in which case the response arrives after
+     * the configured latency.
+     * @return Whether the packet was accepted.
+     */
+    bool sendIcacheReq(PacketPtr pkt);
+    bool sendDcacheReq(PacketPtr pkt);
+
     /**
      * A TimingCPUPort overrides the default behaviour of the
      * recvTiming and recvRetry and implements events for the
@@ -259,6 +271,11 @@ class TimingSimpleCPU : public BaseSimpleCPU
 
     Cycles previousCycle;
 
+    /** Memory accesses in functional-warm mode, if enabled. */
+    std::unique_ptr<BackdoorMemory> warmMemory;
+    const Cycles warmFetchLatency;
+    const Cycles warmDataLatency;
+
   protected:
 
      /** Return a reference to the data port. */
@@ -107,7 +107,7 @@ Check::initiatePrefetch()
     }
 
     // Prefetches are assumed to be 0 sized
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
             m_address, 0, flags, m_tester_ptr->masterId());
     req->setPC(m_pc);
     req->setContext(index);
@@ -146,7 +146,7 @@ Check::initiateFlush()
 
     Request::Flags flags;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
             m_address, CHECK_SIZE, flags, m_tester_ptr->masterId());
     req->setPC(m_pc);
 
@@ -180,7 +180,7 @@ Check::initiateAction()
     Addr writeAddr(m_address + m_store_count);
 
     // Stores are assumed to be 1 byte-sized
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         writeAddr, 1, flags, m_tester_ptr->masterId());
     req->setPC(m_pc);
 
@@ -245,7 +245,7 @@ Check::initiateCheck()
     }
 
     // Checks are sized depending on the number of bytes written
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
             m_address, CHECK_SIZE, flags, m_tester_ptr->masterId());
     req->setPC(m_pc);
 
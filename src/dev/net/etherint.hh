@@ -39,6 +39,8 @@
 #include "dev/net/etherpkt.hh"
 #include "mem/port.hh"
 
+class EventQueue;
+
 /*
  * Class representing the actual interface between two ethernet
  * components.  These components are intended to attach to another
@@ -73,6 +75,12 @@ class EtherInt : public Port
 
     bool askBusy() {return peer->isBusy(); }
     virtual bool isBusy() { return false; }
+
+    /**
+     * Event queue of the object this interface belongs to, nullptr if
+     * unknown.
+     */
+    virtual const EventQueue *eventQueue() const { return nullptr; }
 };
 
 #endif // __DEV_NET_ETHERINT_HH__
@@ -95,6 +95,27 @@ EtherLink::getPort(const std::string &if_name, PortID idx)
     return SimObject::getPort(if_name, idx);
 }
 
+void
+EtherLink::init()
+{
+    SimObject::init();
+
+    // Packets go from the device at one end to the link and then on to
+    // the device at the other end. Only hops between different event
+    // queues limit the quantum, devices that can't tell their queue are
+    // assumed to be on another one. Every packet spends at least a tick
+    // on the wire before the propagation delay.
+    const Tick delay = params()->delay + 1;
+    for (int i = 0; i < 2; i++) {
+        const EtherInt *src = interface[i]->getPeer();
+        const EtherInt *dst = interface[1 - i]->getPeer();
+        declareLinkLatency(link[i]->name(),
+                           src ? src->eventQueue() : nullptr,
+                           eventQueue(), delay);
+        declareLinkLatency(link[i]->name(), eventQueue(),
+                           dst ? dst->eventQueue() : nullptr, delay);
+    }
+}
 
 EtherLink::Interface::Interface(const string &name, Link *tx, Link *rx)
     : EtherInt(name), txlink(tx)
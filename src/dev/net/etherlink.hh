@@ -152,6 +152,8 @@ class EtherLink : public SimObject
     Port &getPort(const std::string &if_name,
                   PortID idx=InvalidPortID) override;
 
+    void init() override;
+
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
 
@@ -81,6 +81,8 @@ class EtherSwitch : public SimObject
          */
         void enqueue(EthPacketPtr packet, unsigned senderId);
         void sendDone() {}
+        const EventQueue *eventQueue() const override
+        { return parent->eventQueue(); }
         Tick switchingDelay();
 
         Interface* lookupDestPort(Net::EthAddr destAddr);
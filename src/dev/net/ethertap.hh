@@ -122,6 +122,8 @@ class EtherTapInt : public EtherInt
     bool recvPacket(EthPacketPtr pkt) override
         { return tap->recvSimulated(pkt); }
     void sendDone() override {}
+    const EventQueue *eventQueue() const override
+    { return tap->eventQueue(); }
 };
 
 
@@ -550,6 +550,8 @@ class IGbEInt : public EtherInt
 
     virtual bool recvPacket(EthPacketPtr pkt) { return dev->ethRxPkt(pkt); }
     virtual void sendDone() { dev->ethTxDone(); }
+    const EventQueue *eventQueue() const override
+    { return dev->eventQueue(); }
 };
 
 #endif //__DEV_NET_I8254XGBE_HH__
@@ -369,6 +369,8 @@ class NSGigEInt : public EtherInt
 
     virtual bool recvPacket(EthPacketPtr pkt) { return dev->recvPacket(pkt); }
     virtual void sendDone() { dev->transferDone(); }
+    const EventQueue *eventQueue() const override
+    { return dev->eventQueue(); }
 };
 
 #endif // __DEV_NET_NS_GIGE_HH__
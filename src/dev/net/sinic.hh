@@ -309,6 +309,8 @@ class Interface : public EtherInt
 
     virtual bool recvPacket(EthPacketPtr pkt) { return dev->recvPacket(pkt); }
     virtual void sendDone() { dev->transferDone(); }
+    const EventQueue *eventQueue() const override
+    { return dev->eventQueue(); }
 };
 
 } // namespace Sinic
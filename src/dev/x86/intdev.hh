@@ -85,7 +85,7 @@ template<class T>
 PacketPtr
 buildIntPacket(Addr addr, T payload)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, sizeof(T), Request::UNCACHEABLE, Request::intMasterId);
     PacketPtr pkt = new Packet(req, MemCmd::WriteReq);
     pkt->allocate();
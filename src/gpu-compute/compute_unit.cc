@@ -941,7 +941,7 @@ ComputeUnit::injectGlobalMemFence(GPUDynInstPtr gpuDynInst, bool kernelLaunch,
     assert(gpuDynInst->isGlobalSeg());
 
     if (!req) {
-        req = std::make_shared<Request>(
+        req = Request::create(
             0, 0, 0, masterId(), 0, gpuDynInst->wfDynId);
     }
     req->setPaddr(0);
@@ -1173,7 +1173,7 @@ ComputeUnit::DTLBPort::recvTimingResp(PacketPtr pkt)
             if (!stride)
                 break;
 
-            RequestPtr prefetch_req = std::make_shared<Request>(
+            RequestPtr prefetch_req = Request::create(
                 vaddr + stride * pf * TheISA::PageBytes,
                 sizeof(uint8_t), 0,
                 computeUnit->masterId(),
@@ -1795,7 +1795,7 @@ ComputeUnit::sendToLds(GPUDynInstPtr gpuDynInst)
 {
     // this is just a request to carry the GPUDynInstPtr
     // back and forth
-    RequestPtr newRequest = std::make_shared<Request>();
+    RequestPtr newRequest = Request::create();
     newRequest->setPaddr(0x0);
 
     // ReadReq is not evaluted by the LDS but the Packet ctor requires this
@@ -56,9 +56,12 @@ using namespace std;
 
 AbstractMemory::AbstractMemory(const Params *p) :
     ClockedObject(p), range(params()->range), pmemAddr(NULL),
+    dirtyPages(nullptr),
     backdoor(params()->range, nullptr,
              (MemBackdoor::Flags)(MemBackdoor::Readable |
                                   MemBackdoor::Writeable)),
+    readBackdoor(params()->range, nullptr, MemBackdoor::Readable),
+    untrackedBackdoor(false),
     confTableReported(p->conf_table_reported), inAddrMap(p->in_addr_map),
     kvmMap(p->kvm_map), _system(NULL),
     stats(*this)
@@ -101,16 +104,49 @@ AbstractMemory::initState()
 }
 
 void
-AbstractMemory::setBackingStore(uint8_t* pmem_addr)
+AbstractMemory::setBackingStore(uint8_t* pmem_addr,
+                                DirtyPageMap* dirty_pages)
 {
     // If there was an existing backdoor, let everybody know it's going away.
-    if (backdoor.ptr())
-        backdoor.invalidate();
+    revokeBackdoor();
 
     // The back door can't handle interleaved memory.
     backdoor.ptr(range.interleaved() ? nullptr : pmem_addr);
+    readBackdoor.ptr(backdoor.ptr());
 
     pmemAddr = pmem_addr;
+    dirtyPages = dirty_pages;
+}
+
+MemBackdoorPtr
+AbstractMemory::getBackdoor(bool writeable, bool tracked)
+{
+    if (!backdoor.ptr())
+        return nullptr;
+
+    if (!writeable)
+        return &readBackdoor;
+
+    if (!tracked)
+        untrackedBackdoor = true;
+    return &backdoor;
+}
+
+void
+AbstractMemory::markBackdoorWrites()
+{
+    if (untrackedBackdoor)
+        markDirty(range.start(), range.size());
+}
+
+void
+AbstractMemory::revokeBackdoor()
+{
+    if (backdoor.ptr()) {
+        backdoor.invalidate();
+        readBackdoor.invalidate();
+    }
+    untrackedBackdoor = false;
 }
 
 AbstractMemory::MemStats::MemStats(AbstractMemory &_mem)
@@ -392,6 +428,7 @@ AbstractMemory::access(PacketPtr pkt)
             if (pmemAddr) {
                 pkt->setData(host_addr);
                 (*(pkt->getAtomicOp()))(host_addr);
+                markDirty(pkt->getAddr(), pkt->getSize());
             }
         } else {
             std::vector<uint8_t> overwrite_val(pkt->getSize());
@@ -420,8 +457,10 @@ AbstractMemory::access(PacketPtr pkt)
                     panic("Invalid size for conditional read/write\n");
             }
 
-            if (overwrite_mem)
+            if (overwrite_mem) {
                 std::memcpy(host_addr, &overwrite_val[0], pkt->getSize());
+                markDirty(pkt->getAddr(), pkt->getSize());
+            }
 
             assert(!pkt->req->isInstFetch());
             TRACE_PACKET("Read/Write");
@@ -453,6 +492,7 @@ AbstractMemory::access(PacketPtr pkt)
         if (writeOK(pkt)) {
             if (pmemAddr) {
                 pkt->writeData(host_addr);
+                markDirty(pkt->getAddr(), pkt->getSize());
                 DPRINTF(MemoryAccess, "%s write due to %s\n",
                         __func__, pkt->print());
             }
@@ -486,6 +526,7 @@ AbstractMemory::functionalAccess(PacketPtr pkt)
     } else if (pkt->isWrite()) {
         if (pmemAddr) {
             pkt->writeData(host_addr);
+            markDirty(pkt->getAddr(), pkt->getSize());
         }
         TRACE_PACKET("Write");
         pkt->makeResponse();
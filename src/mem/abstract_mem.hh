@@ -47,6 +47,7 @@
 #define __MEM_ABSTRACT_MEMORY_HH__
 
 #include "mem/backdoor.hh"
+#include "mem/dirty_page_map.hh"
 #include "mem/port.hh"
 #include "params/AbstractMemory.hh"
 #include "sim/clocked_object.hh"
@@ -111,9 +112,19 @@ class AbstractMemory : public ClockedObject
     // Pointer to host memory used to implement this memory
     uint8_t* pmemAddr;
 
+    // Pages of the backing store written since the last checkpoint
+    DirtyPageMap* dirtyPages;
+
     // Backdoor to access this memory.
     MemBackdoor backdoor;
 
+    // Read-only backdoor, for users that never write through it.
+    MemBackdoor readBackdoor;
+
+    // Whether the backdoor was handed out to a user that writes
+    // through it without reporting its writes with markDirty().
+    bool untrackedBackdoor;
+
     // Enable specific memories to be reported to the configuration table
     const bool confTableReported;
 
@@ -224,8 +235,35 @@ class AbstractMemory : public ClockedObject
      * controller.
      *
      * @param pmem_addr Pointer to a segment of host memory
+     * @param dirty_pages Dirty page tracking of the backing store
+     */
+    void setBackingStore(uint8_t* pmem_addr,
+                         DirtyPageMap* dirty_pages = nullptr);
+
+    /**
+     * Get a backdoor to this memory, if it can have one. Writes through
+     * a writeable backdoor bypass the dirty page tracking, so unless the
+     * user reports them with markDirty(), the whole memory is considered
+     * dirty at the next checkpoint.
+     *
+     * @param writeable Whether the user may write through the backdoor
+     * @param tracked Whether the user reports its writes
+     * @return The backdoor, or nullptr if there is none
+     */
+    MemBackdoorPtr getBackdoor(bool writeable = true, bool tracked = false);
+
+    /**
+     * Account for the writes through the backdoor that were not
+     * reported, before writing a checkpoint.
      */
-    void setBackingStore(uint8_t* pmem_addr);
+    void markBackdoorWrites();
+
+    /**
+     * Invalidate the backdoors handed out to other objects, so that
+     * they have to ask for them again before writing behind the back of
+     * the dirty page tracking.
+     */
+    void revokeBackdoor();
 
     /**
      * Get the list of locked addresses to allow checkpointing.
@@ -277,6 +315,19 @@ class AbstractMemory : public ClockedObject
         return pmemAddr + addr - range.start();
     }
 
+    /**
+     * Record a write to the backing store for incremental checkpoints.
+     *
+     * @param addr Address in gem5's address space
+     * @param size Number of bytes written
+     */
+    void
+    markDirty(Addr addr, Addr size)
+    {
+        if (dirtyPages)
+            dirtyPages->mark(addr - range.start(), size);
+    }
+
     /**
      * Get the memory size.
      *
@@ -48,11 +48,13 @@
 #include <cassert>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "base/types.hh"
 #include "debug/Drain.hh"
+#include "mem/cache/queue_block_index.hh"
 #include "mem/cache/queue_entry.hh"
 #include "mem/packet.hh"
 #include "sim/core.hh"
@@ -97,6 +99,9 @@ class Queue : public Drainable
     /** Holds non allocated entries. */
     typename Entry::List freeList;
 
+    /** Index of the allocated entries by block. */
+    QueueBlockIndex<Entry> blockIndex;
+
     typename Entry::Iterator addToReadyList(Entry* entry)
     {
         if (readyList.empty() ||
@@ -128,8 +133,8 @@ class Queue : public Drainable
      */
     Queue(const std::string &_label, int num_entries, int reserve) :
         label(_label), numEntries(num_entries + reserve),
-        numReserve(reserve), entries(numEntries), _numInService(0),
-        allocated(0)
+        numReserve(reserve), entries(numEntries),
+        blockIndex(numEntries), _numInService(0), allocated(0)
     {
         for (int i = 0; i < numEntries; ++i) {
             freeList.push_back(&entries[i]);
@@ -162,7 +167,10 @@ class Queue : public Drainable
     Entry* findMatch(Addr blk_addr, bool is_secure,
                      bool ignore_uncacheable = true) const
     {
-        for (const auto& entry : allocatedList) {
+        // The entries of the block are in allocation order, like in
+        // allocatedList
+        const QueueEntry *entry = blockIndex.find(blk_addr, is_secure);
+        for (; entry; entry = entry->nextInBlock) {
             // we ignore any entries allocated for uncacheable
             // accesses and simply ignore them when matching, in the
             // cache we never check for matches when adding new
@@ -171,7 +179,7 @@ class Queue : public Drainable
             // serving an uncacheable access
             if (!(ignore_uncacheable && entry->isUncacheable()) &&
                 entry->matchBlockAddr(blk_addr, is_secure)) {
-                return entry;
+                return static_cast<Entry *>(const_cast<QueueEntry *>(entry));
             }
         }
         return nullptr;
@@ -199,6 +207,25 @@ class Queue : public Drainable
      * @return A pointer to the earliest matching entry.
      */
     Entry* findPending(const QueueEntry* entry) const
+    {
+        // The entries that are not in service are the ones in the
+        // readyList. Usually there is at most one of them for the block,
+        // if there are more, the readyList tells which one is first.
+        Entry *pending = nullptr;
+        const QueueEntry *block_entry =
+            blockIndex.find(entry->blkAddr, entry->isSecure);
+        for (; block_entry; block_entry = block_entry->nextInBlock) {
+            if (block_entry->inService || !block_entry->conflictAddr(entry))
+                continue;
+            if (pending)
+                return findPendingInReadyList(entry);
+            pending = static_cast<Entry *>(
+                const_cast<QueueEntry *>(block_entry));
+        }
+        return pending;
+    }
+
+    Entry* findPendingInReadyList(const QueueEntry* entry) const
     {
         for (const auto& ready_entry : readyList) {
             if (ready_entry->conflictAddr(entry)) {
@@ -234,6 +261,7 @@ class Queue : public Drainable
     void deallocate(Entry *entry)
     {
         allocatedList.erase(entry->allocIter);
+        blockIndex.erase(entry);
         freeList.push_front(entry);
         allocated--;
         if (entry->inService) {
@@ -0,0 +1,144 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ * Index of the entries of a cache queue by block address
+ */
+
+#ifndef __MEM_CACHE_QUEUE_BLOCK_INDEX_HH__
+#define __MEM_CACHE_QUEUE_BLOCK_INDEX_HH__
+
+#include <cassert>
+#include <cstddef>
+
+#include "base/flat_hash_map.hh"
+#include "base/types.hh"
+
+/**
+ * Index of the allocated entries of a Queue by block, so that looking
+ * up an address doesn't need to walk all the entries. A hash map from
+ * the blocks with entries to the first of the block's entries. The
+ * others follow in insertion order through their nextInBlock member.
+ *
+ * @tparam Entry The type of the entries, with blkAddr, isSecure and
+ *         nextInBlock members. nextInBlock may point to a base class
+ *         of Entry.
+ */
+template <class Entry>
+class QueueBlockIndex
+{
+  private:
+    /** Type of the links between the entries of a block */
+    typedef decltype(Entry::nextInBlock) Link;
+
+    struct Block
+    {
+        Addr blkAddr;
+        bool isSecure;
+
+        bool
+        operator==(const Block &other) const
+        {
+            return blkAddr == other.blkAddr && isSecure == other.isSecure;
+        }
+    };
+
+    struct BlockHash
+    {
+        size_t
+        operator()(const Block &block) const
+        {
+            return block.blkAddr ^ block.isSecure;
+        }
+    };
+
+    /** First entry of each block */
+    FlatHashMap<Block, Entry *, BlockHash> heads;
+
+  public:
+    /**
+     * @param num_entries Largest number of entries to index, the index
+     *        never grows past them.
+     */
+    explicit QueueBlockIndex(int num_entries) : heads(num_entries) {}
+
+    /**
+     * Get the first entry of a block, the others follow through their
+     * nextInBlock member.
+     *
+     * @return The entry inserted first, nullptr if there is none.
+     */
+    Entry *
+    find(Addr blk_addr, bool is_secure) const
+    {
+        Entry *const *head = heads.find(Block{blk_addr, is_secure});
+        return head ? *head : nullptr;
+    }
+
+    /** Add an entry after the other entries of its block. */
+    void
+    insert(Entry *entry)
+    {
+        entry->nextInBlock = nullptr;
+
+        Entry *&head = heads[Block{entry->blkAddr, entry->isSecure}];
+        if (!head) {
+            head = entry;
+            return;
+        }
+
+        Link last = head;
+        while (last->nextInBlock)
+            last = last->nextInBlock;
+        last->nextInBlock = entry;
+    }
+
+    /** Remove an entry, which must be in the index. */
+    void
+    erase(Entry *entry)
+    {
+        const Block block{entry->blkAddr, entry->isSecure};
+        Entry **head = heads.find(block);
+        assert(head && *head);
+
+        if (*head != entry) {
+            Link prev = *head;
+            while (prev->nextInBlock != entry) {
+                assert(prev->nextInBlock);
+                prev = prev->nextInBlock;
+            }
+            prev->nextInBlock = entry->nextInBlock;
+            entry->nextInBlock = nullptr;
+            return;
+        }
+
+        *head = static_cast<Entry *>(entry->nextInBlock);
+        entry->nextInBlock = nullptr;
+        if (!*head)
+            heads.erase(block);
+    }
+};
+
+#endif //__MEM_CACHE_QUEUE_BLOCK_INDEX_HH__
@@ -0,0 +1,155 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "mem/cache/queue_block_index.hh"
+
+namespace
+{
+
+struct Entry
+{
+    Addr blkAddr;
+    bool isSecure;
+    Entry *nextInBlock;
+
+    Entry(Addr blk_addr, bool is_secure = false)
+        : blkAddr(blk_addr), isSecure(is_secure), nextInBlock(nullptr)
+    {}
+};
+
+typedef QueueBlockIndex<Entry> Index;
+
+/** Entries of a block in the order of the index */
+std::vector<Entry *>
+entries(const Index &index, Addr blk_addr, bool is_secure = false)
+{
+    std::vector<Entry *> result;
+    for (Entry *e = index.find(blk_addr, is_secure); e; e = e->nextInBlock)
+        result.push_back(e);
+    return result;
+}
+
+} // anonymous namespace
+
+TEST(QueueBlockIndexTest, EntriesInInsertionOrder)
+{
+    Index index(8);
+    Entry first(0x40), other(0x80), second(0x40), third(0x40);
+
+    index.insert(&first);
+    index.insert(&other);
+    index.insert(&second);
+    index.insert(&third);
+    EXPECT_EQ(std::vector<Entry *>({&first, &second, &third}),
+              entries(index, 0x40));
+    EXPECT_EQ(std::vector<Entry *>({&other}), entries(index, 0x80));
+    EXPECT_EQ(nullptr, index.find(0xc0, false));
+
+    // Removing an entry that isn't the first of its block keeps the
+    // block in its slot
+    index.erase(&second);
+    EXPECT_EQ(std::vector<Entry *>({&first, &third}), entries(index, 0x40));
+    index.erase(&first);
+    EXPECT_EQ(std::vector<Entry *>({&third}), entries(index, 0x40));
+    index.erase(&third);
+    EXPECT_EQ(nullptr, index.find(0x40, false));
+    EXPECT_EQ(&other, index.find(0x80, false));
+}
+
+TEST(QueueBlockIndexTest, SecureAndNonSecure)
+{
+    Index index(8);
+    Entry non_secure(0x40, false), secure(0x40, true);
+
+    index.insert(&non_secure);
+    index.insert(&secure);
+    EXPECT_EQ(std::vector<Entry *>({&non_secure}),
+              entries(index, 0x40, false));
+    EXPECT_EQ(std::vector<Entry *>({&secure}), entries(index, 0x40, true));
+
+    index.erase(&non_secure);
+    EXPECT_EQ(nullptr, index.find(0x40, false));
+    EXPECT_EQ(&secure, index.find(0x40, true));
+
+    index.insert(&non_secure);
+    index.erase(&secure);
+    EXPECT_EQ(&non_secure, index.find(0x40, false));
+    EXPECT_EQ(nullptr, index.find(0x40, true));
+}
+
+TEST(QueueBlockIndexTest, Random)
+{
+    const int num_entries = 32;
+    Index index(num_entries);
+    std::mt19937 rng(1);
+
+    // A few blocks, secure and not, so that there are both collisions
+    // and several entries per block
+    std::vector<Entry> pool;
+    for (int i = 0; i < num_entries; ++i)
+        pool.emplace_back(Addr(rng() % 24) * 64, rng() % 2);
+
+    std::vector<Entry *> inserted;
+    std::vector<Entry *> free_entries;
+    for (auto &entry : pool)
+        free_entries.push_back(&entry);
+
+    for (int step = 0; step < 20000; ++step) {
+        const bool insert = free_entries.size() &&
+            (inserted.empty() || rng() % 2);
+        if (insert) {
+            const size_t i = rng() % free_entries.size();
+            Entry *entry = free_entries[i];
+            free_entries.erase(free_entries.begin() + i);
+            index.insert(entry);
+            inserted.push_back(entry);
+        } else {
+            const size_t i = rng() % inserted.size();
+            Entry *entry = inserted[i];
+            inserted.erase(inserted.begin() + i);
+            index.erase(entry);
+            free_entries.push_back(entry);
+        }
+
+        // Entries of each block in insertion order
+        std::map<std::pair<Addr, bool>, std::vector<Entry *>> expected;
+        for (auto entry : inserted)
+            expected[{entry->blkAddr, entry->isSecure}].push_back(entry);
+        for (Addr blk = 0; blk < 24 * 64; blk += 64) {
+            for (bool secure : {false, true}) {
+                auto it = expected.find({blk, secure});
+                ASSERT_EQ(it == expected.end() ?
+                          std::vector<Entry *>() : it->second,
+                          entries(index, blk, secure));
+            }
+        }
+    }
+}
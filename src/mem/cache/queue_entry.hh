@@ -63,6 +63,8 @@ class QueueEntry : public Packet::SenderState
      */
     template <class Entry>
     friend class Queue;
+    template <class Entry>
+    friend class QueueBlockIndex;
 
   protected:
 
@@ -72,6 +74,9 @@ class QueueEntry : public Packet::SenderState
     /** True if the entry is uncacheable */
     bool _isUncacheable;
 
+    /** Next allocated entry for the same block, see QueueBlockIndex */
+    QueueEntry *nextInBlock;
+
   public:
     /**
      * A queue entry is holding packets that will be serviced as soon as
@@ -117,7 +122,7 @@ class QueueEntry : public Packet::SenderState
     bool isSecure;
 
     QueueEntry()
-        : readyTime(0), _isUncacheable(false),
+        : readyTime(0), _isUncacheable(false), nextInBlock(nullptr),
           inService(false), order(0), blkAddr(0), blkSize(0), isSecure(false)
     {}
 
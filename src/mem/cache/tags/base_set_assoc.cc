@@ -48,11 +48,16 @@
 #include <string>
 
 #include "base/intmath.hh"
+#include "mem/cache/tags/find_way.hh"
+
+const Addr BaseSetAssoc::InvalidKey;
 
 BaseSetAssoc::BaseSetAssoc(const Params *p)
     :BaseTags(p), allocAssoc(p->assoc), blks(p->size / p->block_size),
      sequentialAccess(p->sequential_access),
-     replacementPolicy(p->replacement_policy)
+     replacementPolicy(p->replacement_policy), assoc(p->assoc),
+     setAssocIndexing(dynamic_cast<const SetAssociative *>(indexingPolicy)),
+     tagKeys(numBlocks, InvalidKey)
 {
     // Check parameters
     if (blkSize < 4 || !isPowerOf2(blkSize)) {
@@ -89,6 +94,30 @@ BaseSetAssoc::invalidate(CacheBlk *blk)
 
     // Invalidate replacement data
     replacementPolicy->invalidate(blk->replacementData);
+
+    tagKeys[blkIndex(blk)] = InvalidKey;
+}
+
+CacheBlk *
+BaseSetAssoc::findBlock(Addr addr, bool is_secure) const
+{
+    if (!setAssocIndexing) {
+        return BaseTags::findBlock(addr, is_secure);
+    }
+
+    // The ways of a set are contiguous in tagKeys, and their blocks are
+    // at the same positions in blks
+    const size_t first = size_t(setAssocIndexing->extractSet(addr)) * assoc;
+    const unsigned way = findWay(&tagKeys[first], assoc,
+                                 lookupKey(extractTag(addr), is_secure));
+    if (way == assoc) {
+        return nullptr;
+    }
+
+    CacheBlk *blk = const_cast<CacheBlk *>(&blks[first + way]);
+    assert(blk->isValid() && blk->tag == extractTag(addr) &&
+           blk->isSecure() == is_secure);
+    return blk;
 }
 
 BaseSetAssoc *
@@ -59,6 +59,7 @@
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/cache/tags/base.hh"
 #include "mem/cache/tags/indexing_policies/base.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
 #include "mem/packet.hh"
 #include "params/BaseSetAssoc.hh"
 
@@ -68,6 +69,11 @@
  *
  * The BaseSetAssoc placement policy divides the cache into s sets of w
  * cache lines (ways).
+ *
+ * When the indexing policy maps an address to the same set in every way,
+ * lookups do not walk the blocks: the tag, valid and secure state of each
+ * block is mirrored in a flat array where the ways of a set are contiguous,
+ * so a whole set can be compared with a few vector instructions.
  */
 class BaseSetAssoc : public BaseTags
 {
@@ -84,6 +90,48 @@ class BaseSetAssoc : public BaseTags
     /** Replacement policy */
     BaseReplacementPolicy *replacementPolicy;
 
+    /** The associativity of the cache. */
+    const unsigned assoc;
+
+    /**
+     * The indexing policy as a set associative one, or nullptr if the
+     * ways of an address may belong to different sets (e.g., skewed).
+     */
+    const SetAssociative *setAssocIndexing;
+
+    /**
+     * Lookup key of every block, indexed like blks, so that the ways of a
+     * set are contiguous. Valid blocks hold their tag with the secure bit
+     * appended, and invalid blocks hold InvalidKey.
+     */
+    std::vector<Addr> tagKeys;
+
+    /** Key of an invalid block; no valid tag can produce it. */
+    static const Addr InvalidKey = MaxAddr;
+
+    /**
+     * Build the lookup key of a block.
+     *
+     * @param tag The tag of the block.
+     * @param is_secure True if the block is in the secure memory space.
+     * @return The key to store in and compare against tagKeys.
+     */
+    static Addr lookupKey(Addr tag, bool is_secure)
+    {
+        return (tag << 1) | (is_secure ? 1 : 0);
+    }
+
+    /**
+     * Get the position of a block in blks and tagKeys.
+     *
+     * @param blk The block.
+     * @return The index of the block.
+     */
+    size_t blkIndex(const CacheBlk *blk) const
+    {
+        return blk - blks.data();
+    }
+
   public:
     /** Convenience typedef. */
      typedef BaseSetAssocParams Params;
@@ -111,6 +159,17 @@ class BaseSetAssoc : public BaseTags
      */
     void invalidate(CacheBlk *blk) override;
 
+    /**
+     * Find a block by comparing the keys of all the ways of its set at
+     * once. Falls back to BaseTags::findBlock() when the indexing policy
+     * is not set associative.
+     *
+     * @param addr The address to find.
+     * @param is_secure True if the target memory space is secure.
+     * @return Pointer to the cache block if found.
+     */
+    CacheBlk *findBlock(Addr addr, bool is_secure) const override;
+
     /**
      * Access block and update replacement data. May not succeed, in which case
      * nullptr is returned. This has all the implications of a cache access and
@@ -191,6 +250,7 @@ class BaseSetAssoc : public BaseTags
     {
         // Insert block
         BaseTags::insertBlock(pkt, blk);
+        tagKeys[blkIndex(blk)] = lookupKey(blk->tag, blk->isSecure());
 
         // Increment tag counter
         stats.tagsInUse++;
@@ -0,0 +1,138 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Search of the lookup keys of the ways of a cache set.
+ */
+
+#ifndef __MEM_CACHE_TAGS_FIND_WAY_HH__
+#define __MEM_CACHE_TAGS_FIND_WAY_HH__
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+
+#define FIND_WAY_HAS_AVX2 1
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "base/bitfield.hh"
+#include "base/types.hh"
+
+/**
+ * Compare the keys of the ways one by one.
+ *
+ * @param keys The keys of the ways of the set.
+ * @param way The first way to compare.
+ * @param assoc The number of ways.
+ * @param key The key to look for.
+ * @return The first matching way, or assoc if there is none.
+ */
+inline unsigned
+findWayScalar(const Addr *keys, unsigned way, unsigned assoc, Addr key)
+{
+    for (; way < assoc; ++way) {
+        if (keys[way] == key) {
+            return way;
+        }
+    }
+    return assoc;
+}
+
+#if defined(__SSE2__)
+/**
+ * Compare the keys of two ways at a time, and the remaining way one by
+ * one. SSE2 has no 64-bit compare, so the 32-bit halves are compared
+ * and a way only matches if both of them do.
+ */
+inline unsigned
+findWaySse2(const Addr *keys, unsigned assoc, Addr key)
+{
+    const __m128i needle = _mm_set1_epi64x(key);
+    unsigned way = 0;
+    for (; way + 2 <= assoc; way += 2) {
+        const __m128i ways = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(keys + way));
+        const __m128i half_eq = _mm_cmpeq_epi32(ways, needle);
+        const __m128i eq = _mm_and_si128(half_eq,
+            _mm_shuffle_epi32(half_eq, _MM_SHUFFLE(2, 3, 0, 1)));
+        const int match = _mm_movemask_pd(_mm_castsi128_pd(eq));
+        if (match) {
+            return way + ctz32(match);
+        }
+    }
+    return findWayScalar(keys, way, assoc, key);
+}
+#endif
+
+#if defined(FIND_WAY_HAS_AVX2)
+/**
+ * Compare the keys of four ways at a time, and the remaining ways one
+ * by one. This is compiled for AVX2 whatever the flags of the build,
+ * so that it can be tested, but it may only run on hosts with AVX2.
+ */
+__attribute__((target("avx2"))) inline unsigned
+findWayAvx2(const Addr *keys, unsigned assoc, Addr key)
+{
+    const __m256i needle = _mm256_set1_epi64x(key);
+    unsigned way = 0;
+    for (; way + 4 <= assoc; way += 4) {
+        const __m256i ways = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(keys + way));
+        const int match = _mm256_movemask_pd(_mm256_castsi256_pd(
+            _mm256_cmpeq_epi64(ways, needle)));
+        if (match) {
+            return way + ctz32(match);
+        }
+    }
+    return findWayScalar(keys, way, assoc, key);
+}
+#endif
+
+/**
+ * Find the way of a set that holds a key, with the widest compares the
+ * build targets.
+ *
+ * @param keys The keys of the ways of the set.
+ * @param assoc The number of ways.
+ * @param key The key to look for.
+ * @return The first matching way, or assoc if there is none.
+ */
+inline unsigned
+findWay(const Addr *keys, unsigned assoc, Addr key)
+{
+#if defined(__AVX2__)
+    return findWayAvx2(keys, assoc, key);
+#elif defined(__SSE2__)
+    return findWaySse2(keys, assoc, key);
+#else
+    return findWayScalar(keys, 0, assoc, key);
+#endif
+}
+
+#endif // __MEM_CACHE_TAGS_FIND_WAY_HH__
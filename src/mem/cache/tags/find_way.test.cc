@@ -0,0 +1,199 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mem/cache/tags/find_way.hh"
+
+namespace
+{
+
+/** Key of an invalid way, as in BaseSetAssoc */
+const Addr InvalidKey = MaxAddr;
+
+Addr
+lookupKey(Addr tag, bool is_secure)
+{
+    return (tag << 1) | (is_secure ? 1 : 0);
+}
+
+unsigned
+referenceFindWay(const Addr *keys, unsigned assoc, Addr key)
+{
+    for (unsigned way = 0; way < assoc; ++way) {
+        if (keys[way] == key)
+            return way;
+    }
+    return assoc;
+}
+
+typedef std::function<unsigned(const Addr *, unsigned, Addr)> FindWay;
+
+/** The implementations that can run on this host */
+std::vector<std::pair<std::string, FindWay>>
+implementations()
+{
+    std::vector<std::pair<std::string, FindWay>> impls;
+    impls.emplace_back("scalar", [](const Addr *keys, unsigned assoc,
+                                    Addr key) {
+        return findWayScalar(keys, 0, assoc, key);
+    });
+#if defined(__SSE2__)
+    impls.emplace_back("sse2", findWaySse2);
+#endif
+#if defined(FIND_WAY_HAS_AVX2)
+    if (__builtin_cpu_supports("avx2"))
+        impls.emplace_back("avx2", findWayAvx2);
+#endif
+    impls.emplace_back("findWay", findWay);
+    return impls;
+}
+
+/**
+ * Check every implementation against the reference for a set, looking
+ * for each of its keys and for keys close to them.
+ */
+void
+checkSet(const std::vector<Addr> &set)
+{
+    const unsigned assoc = set.size();
+
+    // Sets start at any multiple of assoc in the tag array, so also
+    // search keys that are not aligned to the vector size
+    for (unsigned offset = 0; offset < 4; ++offset) {
+        std::vector<Addr> storage(offset, 0);
+        storage.insert(storage.end(), set.begin(), set.end());
+        const Addr *keys = storage.data() + offset;
+
+        std::vector<Addr> needles = { InvalidKey, 0 };
+        for (auto key : set) {
+            needles.push_back(key);
+            // Same tag in the other security state
+            needles.push_back(key ^ 1);
+            // Keys that only differ in one of the 32-bit halves
+            needles.push_back(key ^ (Addr(1) << 40));
+            needles.push_back(key ^ (Addr(1) << 8));
+        }
+
+        for (const auto &impl : implementations()) {
+            for (auto needle : needles) {
+                EXPECT_EQ(referenceFindWay(keys, assoc, needle),
+                          impl.second(keys, assoc, needle))
+                    << impl.first << ", assoc " << assoc << ", key "
+                    << std::hex << needle;
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST(FindWayTest, Empty)
+{
+    for (const auto &impl : implementations())
+        EXPECT_EQ(0, impl.second(nullptr, 0, lookupKey(1, false)));
+}
+
+TEST(FindWayTest, EveryWay)
+{
+    // The match is found whichever way it is in, whether in the vector
+    // part or in the scalar tail
+    for (unsigned assoc : {1, 3, 5, 7, 16}) {
+        std::vector<Addr> set;
+        for (unsigned way = 0; way < assoc; ++way)
+            set.push_back(lookupKey(0x1000 + way, way % 2));
+        for (const auto &impl : implementations()) {
+            for (unsigned way = 0; way < assoc; ++way) {
+                EXPECT_EQ(way, impl.second(set.data(), assoc, set[way]))
+                    << impl.first << ", assoc " << assoc;
+            }
+            EXPECT_EQ(assoc, impl.second(set.data(), assoc,
+                                         lookupKey(0x2000, false)))
+                << impl.first << ", assoc " << assoc;
+        }
+        checkSet(set);
+    }
+}
+
+TEST(FindWayTest, SecureBit)
+{
+    // Only the secure bit tells the keys apart
+    for (unsigned assoc : {1, 3, 5, 7, 16}) {
+        std::vector<Addr> set(assoc, InvalidKey);
+        set[assoc - 1] = lookupKey(0xabcd, true);
+        if (assoc > 1)
+            set[assoc / 2] = lookupKey(0x1234, false);
+
+        for (const auto &impl : implementations()) {
+            EXPECT_EQ(assoc - 1, impl.second(set.data(), assoc,
+                                             lookupKey(0xabcd, true)))
+                << impl.first << ", assoc " << assoc;
+            EXPECT_EQ(assoc, impl.second(set.data(), assoc,
+                                         lookupKey(0xabcd, false)))
+                << impl.first << ", assoc " << assoc;
+        }
+        checkSet(set);
+    }
+}
+
+TEST(FindWayTest, InvalidWays)
+{
+    // No valid key matches the key of the invalid ways
+    for (unsigned assoc : {1, 3, 5, 7, 16}) {
+        std::vector<Addr> set(assoc, InvalidKey);
+        for (const auto &impl : implementations()) {
+            EXPECT_EQ(assoc, impl.second(set.data(), assoc,
+                                         lookupKey(MaxAddr >> 1, false)))
+                << impl.first << ", assoc " << assoc;
+        }
+        checkSet(set);
+    }
+}
+
+TEST(FindWayTest, Random)
+{
+    std::mt19937_64 rng(1);
+    for (unsigned assoc : {1, 3, 5, 7, 16}) {
+        for (int i = 0; i < 200; ++i) {
+            // Few distinct tags with high and low bits, some invalid ways
+            // and some tags in both security states
+            std::vector<Addr> set;
+            for (unsigned way = 0; way < assoc; ++way) {
+                if (rng() % 4 == 0) {
+                    set.push_back(InvalidKey);
+                } else {
+                    const Addr tag = (rng() % 8) << 33 | (rng() % 8);
+                    set.push_back(lookupKey(tag, rng() % 2));
+                }
+            }
+            checkSet(set);
+        }
+    }
+}
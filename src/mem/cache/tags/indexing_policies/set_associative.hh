@@ -78,7 +78,7 @@ class ReplaceableEntry;
  */
 class SetAssociative : public BaseIndexingPolicy
 {
-  protected:
+  public:
     /**
      * Apply a hash function to calculate address set.
      *
@@ -87,7 +87,6 @@ class SetAssociative : public BaseIndexingPolicy
      */
     virtual uint32_t extractSet(const Addr addr) const;
 
-  public:
     /**
      * Convenience typedef.
      */
@@ -64,6 +64,7 @@ WriteQueue::allocate(Addr blk_addr, unsigned blk_size, PacketPtr pkt,
 
     entry->allocate(blk_addr, blk_size, pkt, when_ready, order);
     entry->allocIter = allocatedList.insert(allocatedList.end(), entry);
+    blockIndex.insert(entry);
     entry->readyIter = addToReadyList(entry);
 
     allocated += 1;
@@ -138,6 +138,12 @@ CoherentXBar::init()
         snoopFilter->setSlavePorts(slavePorts);
 }
 
+Cycles
+CoherentXBar::minForwardLatency() const
+{
+    return std::min(BaseXBar::minForwardLatency(), snoopResponseLatency);
+}
+
 bool
 CoherentXBar::recvTimingReq(PacketPtr pkt, PortID slave_port_id)
 {
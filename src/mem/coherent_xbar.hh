@@ -417,6 +417,8 @@ class CoherentXBar : public BaseXBar
     Stats::Scalar snoopTraffic;
     Stats::Distribution snoopFanout;
 
+    Cycles minForwardLatency() const override;
+
   public:
 
     virtual void init();
@@ -0,0 +1,122 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_DIRTY_PAGE_MAP_HH__
+#define __MEM_DIRTY_PAGE_MAP_HH__
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/types.hh"
+
+/**
+ * Bitmap recording which pages of a backing store have been written
+ * since the last checkpoint, so that incremental checkpoints only
+ * have to store those pages. Writes through the memory port interface
+ * are tracked exactly, as are the writes reported by the users of
+ * memory backdoors. Other backdoor writes can only be accounted for by
+ * marking the whole memory, and writes by a virtualised guest cannot
+ * be tracked at all.
+ */
+class DirtyPageMap
+{
+  public:
+    /** Granularity of the tracking, independent of the host page size. */
+    static const unsigned PageShift = 12;
+    static const Addr PageBytes = ULL(1) << PageShift;
+
+    /** Number of pages covered by one word of the bitmap. */
+    static const unsigned PagesPerWord = 64;
+
+    explicit DirtyPageMap(Addr size)
+        : _numPages(divCeil(size, PageBytes)),
+          bits(divCeil(_numPages, PagesPerWord)),
+          tracked(true)
+    {}
+
+    /**
+     * Mark the pages touched by a write.
+     *
+     * @param offset Offset of the write in the backing store
+     * @param size Number of bytes written
+     */
+    void
+    mark(Addr offset, Addr size)
+    {
+        if (!size)
+            return;
+
+        const Addr last = (offset + size - 1) >> PageShift;
+        for (Addr page = offset >> PageShift; page <= last; ++page) {
+            std::atomic<uint64_t> &word = bits[page / PagesPerWord];
+            const uint64_t bit = ULL(1) << (page % PagesPerWord);
+            // most writes hit a page that is already dirty, avoid the
+            // locked read-modify-write for those
+            if (!(word.load(std::memory_order_relaxed) & bit))
+                word.fetch_or(bit, std::memory_order_relaxed);
+        }
+    }
+
+    /** Give up on tracking, every page is considered dirty from now on. */
+    void disableTracking() { tracked = false; }
+
+    /** Are writes to the store being tracked at all? */
+    bool isTracked() const { return tracked; }
+
+    /**
+     * Get the dirty bits of a group of PagesPerWord pages.
+     *
+     * @param index Index of the group, i.e. first page / PagesPerWord
+     * @return Bit i is set if page index * PagesPerWord + i is dirty
+     */
+    uint64_t
+    word(Addr index) const
+    {
+        if (!tracked)
+            return ~ULL(0);
+        return bits[index].load(std::memory_order_relaxed);
+    }
+
+    /** Start tracking afresh, typically after writing a checkpoint. */
+    void
+    clear()
+    {
+        for (auto &w : bits)
+            w.store(0, std::memory_order_relaxed);
+    }
+
+    Addr numPages() const { return _numPages; }
+
+    Addr numWords() const { return bits.size(); }
+
+  private:
+    const Addr _numPages;
+    std::vector<std::atomic<uint64_t>> bits;
+    bool tracked;
+};
+
+#endif //__MEM_DIRTY_PAGE_MAP_HH__
@@ -0,0 +1,106 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "mem/dirty_page_map.hh"
+
+namespace
+{
+
+/** Indices of the dirty pages of a map */
+std::vector<Addr>
+dirtyPages(const DirtyPageMap &map)
+{
+    std::vector<Addr> pages;
+    for (Addr page = 0; page < map.numPages(); page++) {
+        if (map.word(page / DirtyPageMap::PagesPerWord) &
+            (ULL(1) << (page % DirtyPageMap::PagesPerWord))) {
+            pages.push_back(page);
+        }
+    }
+    return pages;
+}
+
+} // anonymous namespace
+
+TEST(DirtyPageMapTest, Size)
+{
+    DirtyPageMap map(DirtyPageMap::PageBytes * 100 + 1);
+    EXPECT_EQ(map.numPages(), 101);
+    EXPECT_EQ(map.numWords(), 2);
+    EXPECT_TRUE(dirtyPages(map).empty());
+}
+
+TEST(DirtyPageMapTest, ZeroSizeMarksNothing)
+{
+    DirtyPageMap map(DirtyPageMap::PageBytes * 200);
+
+    map.mark(0, 0);
+    map.mark(DirtyPageMap::PageBytes * 3, 0);
+    map.mark(DirtyPageMap::PageBytes * 200 - 1, 0);
+    EXPECT_TRUE(dirtyPages(map).empty());
+}
+
+TEST(DirtyPageMapTest, WritesWithinAPage)
+{
+    DirtyPageMap map(DirtyPageMap::PageBytes * 200);
+
+    map.mark(0, 1);
+    map.mark(DirtyPageMap::PageBytes * 5, DirtyPageMap::PageBytes);
+    map.mark(DirtyPageMap::PageBytes * 64 - 1, 1);
+    map.mark(DirtyPageMap::PageBytes * 200 - 8, 8);
+    EXPECT_EQ(dirtyPages(map), std::vector<Addr>({ 0, 5, 63, 199 }));
+}
+
+TEST(DirtyPageMapTest, WritesStraddlingPages)
+{
+    DirtyPageMap map(DirtyPageMap::PageBytes * 200);
+
+    // Two bytes across the boundary of pages 1 and 2
+    map.mark(DirtyPageMap::PageBytes * 2 - 1, 2);
+    // A page worth of bytes that isn't page aligned
+    map.mark(DirtyPageMap::PageBytes * 10 + 8, DirtyPageMap::PageBytes);
+    // Across the boundary of two bitmap words
+    map.mark(DirtyPageMap::PageBytes * 63 + 16, DirtyPageMap::PageBytes * 2);
+    EXPECT_EQ(dirtyPages(map),
+              std::vector<Addr>({ 1, 2, 10, 11, 63, 64, 65 }));
+}
+
+TEST(DirtyPageMapTest, ClearAndDisable)
+{
+    DirtyPageMap map(DirtyPageMap::PageBytes * 100);
+
+    map.mark(DirtyPageMap::PageBytes * 7, 1);
+    map.clear();
+    EXPECT_TRUE(dirtyPages(map).empty());
+
+    EXPECT_TRUE(map.isTracked());
+    map.disableTracking();
+    EXPECT_FALSE(map.isTracked());
+    EXPECT_EQ(dirtyPages(map).size(), 100);
+}
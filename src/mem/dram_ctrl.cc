@@ -2816,6 +2816,8 @@ DRAMCtrl::DRAMStats::regStats()
 void
 DRAMCtrl::DRAMStats::resetStats()
 {
+    Stats::Group::resetStats();
+
     dram.lastStatsResetTick = curTick();
 }
 
@@ -58,6 +58,12 @@
 #include "base/trace.hh"
 #include "mem/packet_access.hh"
 
+FreeListPool packetPool("packet", sizeof(Packet));
+// Large enough for cache lines of up to 256 bytes, anything larger
+// comes from the heap.
+FreeListPool packetDataPool("packet_data", 256);
+FreeListPool requestPool("request", 2 * sizeof(Request));
+
 // The one downside to bitsets is that static initializers can get ugly.
 #define SET1(a1)                     (1 << (a1))
 #define SET2(a1, a2)                 (SET1(a1) | SET1(a2))
@@ -55,6 +55,7 @@
 #include "base/cast.hh"
 #include "base/compiler.hh"
 #include "base/flags.hh"
+#include "base/free_list_pool.hh"
 #include "base/logging.hh"
 #include "base/printable.hh"
 #include "base/types.hh"
@@ -67,6 +68,12 @@ typedef uint8_t* PacketDataPtr;
 typedef std::list<PacketPtr> PacketList;
 typedef uint64_t PacketId;
 
+/** Pool Packet objects are allocated from. */
+extern FreeListPool packetPool;
+
+/** Pool for the data of packets that allocate() their own storage. */
+extern FreeListPool packetDataPool;
+
 class MemCmd
 {
     friend class Packet;
@@ -297,6 +304,9 @@ class Packet : public Printable
         /// the packet is destroyed. The pointer is assumed to be pointing
         /// to an array, and delete [] is consequently called
         DYNAMIC_DATA           = 0x00002000,
+        /// The data pointer points to a buffer from packetDataPool
+        /// which is returned to the pool when the packet is destroyed.
+        POOLED_DATA            = 0x00004000,
 
         /// suppress the error if this packet encounters a functional
         /// access failure.
@@ -923,6 +933,24 @@ class Packet : public Printable
         deleteData();
     }
 
+    /**
+     * Packets are allocated from packetPool rather than the heap since
+     * a new packet is created for nearly every memory access.
+     * @{
+     */
+    static void *
+    operator new(size_t size)
+    {
+        return packetPool.allocate(size);
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        packetPool.release(p, size);
+    }
+    /** @} */
+
     /**
      * Take a request packet and modify it in place to be suitable for
      * returning as a response to that request.
@@ -1033,7 +1061,7 @@ class Packet : public Printable
     void
     dataStatic(T *p)
     {
-        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA));
         data = (PacketDataPtr)p;
         flags.set(STATIC_DATA);
     }
@@ -1050,7 +1078,7 @@ class Packet : public Printable
     void
     dataStaticConst(const T *p)
     {
-        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA));
         data = const_cast<PacketDataPtr>(p);
         flags.set(STATIC_DATA);
     }
@@ -1071,7 +1099,7 @@ class Packet : public Printable
     void
     dataDynamic(T *p)
     {
-        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA));
         data = (PacketDataPtr)p;
         flags.set(DYNAMIC_DATA);
     }
@@ -1083,7 +1111,7 @@ class Packet : public Printable
     T*
     getPtr()
     {
-        assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA));
         assert(!isMaskedWrite());
         return (T*)data;
     }
@@ -1092,7 +1120,7 @@ class Packet : public Printable
     const T*
     getConstPtr() const
     {
-        assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA));
         return (const T*)data;
     }
 
@@ -1216,8 +1244,10 @@ class Packet : public Printable
     {
         if (flags.isSet(DYNAMIC_DATA))
             delete [] data;
+        else if (flags.isSet(POOLED_DATA))
+            packetDataPool.release(data, getSize());
 
-        flags.clear(STATIC_DATA|DYNAMIC_DATA);
+        flags.clear(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA);
         data = NULL;
     }
 
@@ -1228,9 +1258,10 @@ class Packet : public Printable
         // if either this command or the response command has a data
         // payload, actually allocate space
         if (hasData() || hasRespData()) {
-            assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
-            flags.set(DYNAMIC_DATA);
-            data = new uint8_t[getSize()];
+            assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA));
+            flags.set(POOLED_DATA);
+            data = static_cast<uint8_t *>(
+                packetDataPool.allocate(getSize()));
         }
     }
 
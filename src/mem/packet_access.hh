@@ -48,7 +48,7 @@ template <typename T>
 inline T
 Packet::getRaw() const
 {
-    assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA));
+    assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA));
     assert(sizeof(T) <= size);
     return *(T*)data;
 }
@@ -57,7 +57,7 @@ template <typename T>
 inline void
 Packet::setRaw(T v)
 {
-    assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA));
+    assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA));
     assert(sizeof(T) <= size);
     *(T*)data = v;
 }
@@ -39,22 +39,33 @@
 
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/user.h>
 #include <unistd.h>
 #include <zlib.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <string>
+#include <thread>
 
 #include "base/trace.hh"
+#include "config/use_zstd.hh"
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
 #include "mem/abstract_mem.hh"
 
+#if USE_ZSTD
+#include <zstd.h>
+
+#endif
+
 /**
  * On Linux, MAP_NORESERVE allow us to simulate a very large memory
  * without committing to actually providing the swap space on the
@@ -69,10 +80,187 @@
 
 using namespace std;
 
+namespace
+{
+
+/**
+ * Header of a chunked store file, followed by the path of the base
+ * store file if the checkpoint is incremental. A relative base path is
+ * relative to the directory of the store file.
+ */
+struct StoreHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t compression;
+    uint64_t pageBytes;
+    uint64_t rangeSize;
+    uint32_t chainDepth;
+    uint32_t baseLength;
+};
+
+/**
+ * Header of a chunk of up to DirtyPageMap::PagesPerWord pages, followed
+ * by the compressed contents of the pages present in the chunk.
+ */
+struct ChunkHeader
+{
+    uint64_t index;
+    uint64_t mask;
+    uint64_t compressedSize;
+};
+
+/** Uncompressed size of a full chunk. */
+const Addr chunkBytes = DirtyPageMap::PagesPerWord * DirtyPageMap::PageBytes;
+
+/** Memory the chunks being compressed at the same time may take. */
+const Addr maxWindowBytes = ULL(64) << 20;
+
+const char storeMagic[8] = {'g', 'e', 'm', '5', 'p', 'm', 'e', 'm'};
+const uint32_t storeVersion = 1;
+
+enum StoreCompression : uint32_t
+{
+    CompressZlib = 1,
+    CompressZstd = 2,
+};
+
+#if USE_ZSTD
+const StoreCompression storeCompression = CompressZstd;
+#else
+const StoreCompression storeCompression = CompressZlib;
+#endif
+
+bool
+isZero(const uint8_t *data, size_t len)
+{
+    return data[0] == 0 && memcmp(data, data + 1, len - 1) == 0;
+}
+
+/** Number of bytes of a page, the last page of a store may be partial. */
+Addr
+pageBytes(Addr page, Addr size)
+{
+    return min(DirtyPageMap::PageBytes, size - page * DirtyPageMap::PageBytes);
+}
+
+void
+compressChunk(const vector<uint8_t> &raw, vector<uint8_t> &out)
+{
+#if USE_ZSTD
+    out.resize(ZSTD_compressBound(raw.size()));
+    size_t len = ZSTD_compress(out.data(), out.size(), raw.data(),
+                               raw.size(), 1);
+    panic_if(ZSTD_isError(len), "Failed to compress memory chunk: %s\n",
+             ZSTD_getErrorName(len));
+#else
+    uLongf len = compressBound(raw.size());
+    out.resize(len);
+    panic_if(compress2(out.data(), &len, raw.data(), raw.size(),
+                       Z_BEST_SPEED) != Z_OK,
+             "Failed to compress memory chunk\n");
+#endif
+    out.resize(len);
+}
+
+void
+decompressChunk(uint32_t compression, const vector<uint8_t> &in,
+                vector<uint8_t> &raw, const string &filename)
+{
+    size_t len = 0;
+    if (compression == CompressZlib) {
+        uLongf zlen = raw.size();
+        if (uncompress(raw.data(), &zlen, in.data(), in.size()) == Z_OK)
+            len = zlen;
+    } else if (compression == CompressZstd) {
+#if USE_ZSTD
+        len = ZSTD_decompress(raw.data(), raw.size(), in.data(), in.size());
+        if (ZSTD_isError(len))
+            len = 0;
+#else
+        fatal("Physical memory checkpoint file '%s' is compressed with "
+              "zstd, rebuild with USE_ZSTD to restore it\n", filename);
+#endif
+    }
+
+    fatal_if(len != raw.size(),
+             "Corrupt chunk in physical memory checkpoint file '%s'\n",
+             filename);
+}
+
+/**
+ * Express path relative to dir, so that a chain of checkpoints can be
+ * moved around as long as their directories stay side by side.
+ */
+string
+relativePath(const string &dir, const string &path)
+{
+    char buf[PATH_MAX];
+    if (!realpath(dir.c_str(), buf))
+        return path;
+    string from(buf);
+    if (!realpath(path.c_str(), buf))
+        return path;
+    string to(buf);
+
+    // strip the common leading directories
+    size_t common = 0;
+    for (size_t i = 0; i < from.size() && i < to.size() && from[i] == to[i];
+         ++i) {
+        if (from[i] == '/')
+            common = i + 1;
+    }
+    if (from.size() < to.size() && to[from.size()] == '/' &&
+        to.compare(0, from.size(), from) == 0) {
+        common = from.size() + 1;
+    }
+
+    string rel;
+    if (common < from.size()) {
+        rel = "../";
+        for (size_t i = common; i < from.size(); ++i)
+            if (from[i] == '/')
+                rel += "../";
+    }
+    return rel + to.substr(common);
+}
+
+/** Check whether two paths name the same existing file. */
+bool
+sameFile(const string &a, const string &b)
+{
+    struct stat st_a, st_b;
+    if (stat(a.c_str(), &st_a) != 0 || stat(b.c_str(), &st_b) != 0)
+        return false;
+    return st_a.st_dev == st_b.st_dev && st_a.st_ino == st_b.st_ino;
+}
+
+/**
+ * Move a newly written checkpoint file into place. Writing a separate
+ * file rather than truncating the old one keeps intact any mapping of
+ * the old file, e.g. the backing store after restoring a raw store.
+ */
+void
+replaceFile(const string &tmp_path, const string &filepath)
+{
+    if (rename(tmp_path.c_str(), filepath.c_str()) != 0)
+        fatal("Can't rename physical memory checkpoint file '%s' to '%s'\n",
+              tmp_path, filepath);
+}
+
+} // anonymous namespace
+
 PhysicalMemory::PhysicalMemory(const string& _name,
                                const vector<AbstractMemory*>& _memories,
-                               bool mmap_using_noreserve) :
-    _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve)
+                               bool mmap_using_noreserve,
+                               bool uncompressed_checkpoints,
+                               unsigned checkpoint_chain_length,
+                               unsigned compression_threads) :
+    _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
+    uncompressedCheckpoints(uncompressed_checkpoints),
+    checkpointChainLength(checkpoint_chain_length),
+    compressionThreads(compression_threads ? compression_threads :
+                       max(thread::hardware_concurrency(), 1U))
 {
     if (mmap_using_noreserve)
         warn("Not reserving swap space. May cause SIGSEGV on actual usage\n");
@@ -177,6 +365,8 @@ PhysicalMemory::PhysicalMemory(const string& _name,
                            f->isConfReported(), f->isInAddrMap(),
                            f->isKvmMap());
     }
+
+    storeChain.resize(backingStore.size());
 }
 
 void
@@ -219,7 +409,7 @@ PhysicalMemory::createBackingStore(AddrRange range,
     for (const auto& m : _memories) {
         DPRINTF(AddrRanges, "Mapping memory %s to backing store\n",
                 m->name());
-        m->setBackingStore(pmem);
+        m->setBackingStore(pmem, backingStore.back().dirtyPages.get());
     }
 }
 
@@ -236,6 +426,13 @@ PhysicalMemory::isMemAddr(Addr addr) const
     return addrMap.contains(addr) != addrMap.end();
 }
 
+AbstractMemory *
+PhysicalMemory::findMemory(Addr addr) const
+{
+    const auto& m = addrMap.contains(addr);
+    return m != addrMap.end() ? m->second : nullptr;
+}
+
 AddrRangeList
 PhysicalMemory::getConfAddrRanges() const
 {
@@ -303,6 +500,9 @@ PhysicalMemory::serialize(CheckpointOut &cp) const
             lal_addr.push_back(l.addr);
             lal_cid.push_back(l.contextId);
         }
+
+        // the pages written through backdoors we can't see into
+        m->markBackdoorWrites();
     }
 
     SERIALIZE_CONTAINER(lal_addr);
@@ -318,6 +518,11 @@ PhysicalMemory::serialize(CheckpointOut &cp) const
         ScopedCheckpointSection sec(cp, csprintf("store%d", store_id));
         serializeStore(cp, store_id++, s.range, s.pmem);
     }
+
+    // the stores are now clean, make sure anything that could write
+    // to them behind our back asks again first
+    for (auto& m : memories)
+        m->revokeBackdoor();
 }
 
 void
@@ -328,42 +533,199 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
     // memories that are not part of the address map can overlap
     string filename = name() + ".store" + to_string(store_id) + ".pmem";
     long range_size = range.size();
-
-    DPRINTF(Checkpoint, "Serializing physical memory %s with size %d\n",
-            filename, range_size);
+    string format = uncompressedCheckpoints ? "raw" : "chunked";
+
+    DirtyPageMap &dirty_pages = *backingStore[store_id].dirtyPages;
+    const string dir = CheckpointIn::dir();
+    const string filepath = dir + "/" + filename;
+    vector<string> &chain = storeChain[store_id];
+
+    // only write what changed since the previous checkpoint if we
+    // know what changed, the chain leading up to it is not too long
+    // already, and the new file doesn't replace one of the chain,
+    // e.g. when checkpointing into the directory restored from
+    const bool replaces_chain = any_of(chain.begin(), chain.end(),
+        [&filepath](const string &f) { return sameFile(f, filepath); });
+    const bool incremental = !uncompressedCheckpoints &&
+        !chain.empty() && dirty_pages.isTracked() &&
+        chain.size() - 1 < checkpointChainLength && !replaces_chain;
+    const string base = incremental ? relativePath(dir, chain.back()) : "";
+    const unsigned chain_depth = incremental ? chain.size() : 0;
+
+    DPRINTF(Checkpoint, "Serializing physical memory %s with size %d%s\n",
+            filename, range_size,
+            incremental ? csprintf(" based on %s", base) : "");
 
     SERIALIZE_SCALAR(store_id);
     SERIALIZE_SCALAR(filename);
     SERIALIZE_SCALAR(range_size);
+    SERIALIZE_SCALAR(format);
 
     // write memory file
-    string filepath = CheckpointIn::dir() + "/" + filename.c_str();
-    gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
-    if (compressed_mem == NULL)
+    if (uncompressedCheckpoints) {
+        serializeRawStore(filepath, pmem, range_size);
+        // raw stores cannot be the base of a chunked one
+        chain.clear();
+    } else {
+        serializeChunkedStore(filepath, base, chain_depth, incremental,
+                              pmem, range_size, dirty_pages);
+        // this checkpoint is the base of the next one
+        if (!incremental)
+            chain.clear();
+        chain.push_back(filepath);
+    }
+
+    dirty_pages.clear();
+}
+
+void
+PhysicalMemory::serializeChunkedStore(const string &filepath,
+                                      const string &base,
+                                      unsigned chain_depth, bool incremental,
+                                      uint8_t* pmem, Addr range_size,
+                                      const DirtyPageMap &dirty_pages) const
+{
+    // write a new file, see replaceFile()
+    const string tmp_path = filepath + ".tmp";
+    ofstream out(tmp_path, ios::binary);
+    if (!out)
         fatal("Can't open physical memory checkpoint file '%s'\n",
-              filename);
+              tmp_path);
+
+    StoreHeader header;
+    memcpy(header.magic, storeMagic, sizeof(header.magic));
+    header.version = storeVersion;
+    header.compression = storeCompression;
+    header.pageBytes = DirtyPageMap::PageBytes;
+    header.rangeSize = range_size;
+    header.chainDepth = chain_depth;
+    header.baseLength = base.size();
+    out.write((const char *)&header, sizeof(header));
+    out.write(base.data(), base.size());
+
+    // Compress windows of chunks in parallel, and write them out in
+    // order once the whole window is done. Threads take every n-th
+    // chunk so that clusters of dirty chunks are spread evenly. The
+    // window is kept to a bounded amount of memory, as long as there
+    // is at least a chunk per thread.
+    const Addr num_chunks = dirty_pages.numWords();
+    const Addr num_pages = dirty_pages.numPages();
+    const Addr window = max<Addr>(compressionThreads,
+        min<Addr>(compressionThreads * 64, maxWindowBytes / chunkBytes));
+    vector<uint64_t> masks(window);
+    vector<vector<uint8_t>> chunks(window);
+
+    for (Addr first = 0; first < num_chunks; first += window) {
+        const Addr n = min(window, num_chunks - first);
+
+        auto work = [&](unsigned thread_id) {
+            vector<uint8_t> raw;
+            for (Addr i = thread_id; i < n; i += compressionThreads) {
+                const Addr index = first + i;
+                uint64_t mask =
+                    incremental ? dirty_pages.word(index) : ~ULL(0);
+                raw.clear();
+                for (unsigned p = 0; p < DirtyPageMap::PagesPerWord; ++p) {
+                    const Addr page = index * DirtyPageMap::PagesPerWord + p;
+                    if (page >= num_pages) {
+                        mask &= (ULL(1) << p) - 1;
+                        break;
+                    }
+                    if (!(mask & (ULL(1) << p)))
+                        continue;
+
+                    const uint8_t *data =
+                        pmem + page * DirtyPageMap::PageBytes;
+                    const Addr bytes = pageBytes(page, range_size);
+                    // a full checkpoint leaves out zero pages, an
+                    // incremental one needs them to overwrite the base
+                    if (!incremental && isZero(data, bytes)) {
+                        mask &= ~(ULL(1) << p);
+                        continue;
+                    }
+                    raw.insert(raw.end(), data, data + bytes);
+                }
 
-    uint64_t pass_size = 0;
+                masks[i] = mask;
+                if (mask)
+                    compressChunk(raw, chunks[i]);
+            }
+        };
+
+        vector<thread> workers;
+        for (unsigned t = 1; t < min<Addr>(compressionThreads, n); ++t)
+            workers.emplace_back(work, t);
+        work(0);
+        for (auto &w : workers)
+            w.join();
+
+        for (Addr i = 0; i < n; ++i) {
+            if (!masks[i])
+                continue;
+            ChunkHeader chunk;
+            chunk.index = first + i;
+            chunk.mask = masks[i];
+            chunk.compressedSize = chunks[i].size();
+            out.write((const char *)&chunk, sizeof(chunk));
+            out.write((const char *)chunks[i].data(), chunks[i].size());
+        }
+    }
 
-    // gzwrite fails if (int)len < 0 (gzwrite returns int)
-    for (uint64_t written = 0; written < range.size();
-         written += pass_size) {
-        pass_size = (uint64_t)INT_MAX < (range.size() - written) ?
-            (uint64_t)INT_MAX : (range.size() - written);
+    out.close();
+    if (out.fail())
+        fatal("Write failed on physical memory checkpoint file '%s'\n",
+              tmp_path);
+    replaceFile(tmp_path, filepath);
+}
 
-        if (gzwrite(compressed_mem, pmem + written,
-                    (unsigned int) pass_size) != (int) pass_size) {
-            fatal("Write failed on physical memory checkpoint file '%s'\n",
-                  filename);
+void
+PhysicalMemory::serializeRawStore(const string &filepath, uint8_t* pmem,
+                                  Addr range_size) const
+{
+    // write a new file, see replaceFile()
+    const string tmp_path = filepath + ".tmp";
+    int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              tmp_path);
+
+    // Size the file up front and only write the pages that are not
+    // zero, leaving holes for the rest, so that sparse memories stay
+    // sparse on disk.
+    if (ftruncate(fd, range_size) != 0)
+        fatal("Write failed on physical memory checkpoint file '%s'\n",
+              tmp_path);
+
+    const Addr num_pages = divCeil(range_size, DirtyPageMap::PageBytes);
+    Addr page = 0;
+    while (page < num_pages) {
+        // find the next run of non-zero pages
+        while (page < num_pages &&
+               isZero(pmem + page * DirtyPageMap::PageBytes,
+                      pageBytes(page, range_size))) {
+            ++page;
+        }
+        Addr start = page * DirtyPageMap::PageBytes;
+        while (page < num_pages &&
+               !isZero(pmem + page * DirtyPageMap::PageBytes,
+                       pageBytes(page, range_size))) {
+            ++page;
+        }
+        Addr end = min(page * DirtyPageMap::PageBytes, range_size);
+
+        while (start < end) {
+            ssize_t written = pwrite(fd, pmem + start, end - start, start);
+            if (written <= 0)
+                fatal("Write failed on physical memory checkpoint file "
+                      "'%s'\n", tmp_path);
+            start += written;
         }
     }
 
-    // close the compressed stream and check that the exit status
-    // is zero
-    if (gzclose(compressed_mem))
+    if (close(fd) != 0)
         fatal("Close failed on physical memory checkpoint file '%s'\n",
-              filename);
-
+              tmp_path);
+    replaceFile(tmp_path, filepath);
 }
 
 void
@@ -394,8 +756,6 @@ PhysicalMemory::unserialize(CheckpointIn &cp)
 void
 PhysicalMemory::unserializeStore(CheckpointIn &cp)
 {
-    const uint32_t chunk_size = 16384;
-
     unsigned int store_id;
     UNSERIALIZE_SCALAR(store_id);
 
@@ -403,11 +763,6 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     string filepath = cp.getCptDir() + "/" + filename;
 
-    // mmap memoryfile
-    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'", filename);
-
     // we've already got the actual backing store mapped
     uint8_t* pmem = backingStore[store_id].pmem;
     AddrRange range = backingStore[store_id].range;
@@ -422,11 +777,158 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Memory range size has changed! Saw %lld, expected %lld\n",
               range_size, range.size());
 
+    // checkpoints predating the chunked format are a single gzip
+    // stream of the whole store
+    string format = "gzip";
+    UNSERIALIZE_OPT_SCALAR(format);
+
+    storeChain[store_id].clear();
+    if (format == "chunked") {
+        vector<string> &chain = storeChain[store_id];
+        unserializeChunkedStore(filepath, pmem, range_size, chain);
+        reverse(chain.begin(), chain.end());
+    } else if (format == "raw") {
+        unserializeRawStore(filepath, pmem, range_size);
+    } else if (format == "gzip") {
+        unserializeGzipStore(filepath, pmem, range_size);
+    } else {
+        fatal("Unknown format '%s' of physical memory checkpoint file "
+              "'%s'\n", format, filename);
+    }
+
+    // the store now matches the checkpoint
+    backingStore[store_id].dirtyPages->clear();
+}
+
+void
+PhysicalMemory::unserializeChunkedStore(const string &filepath,
+                                        uint8_t* pmem, Addr range_size,
+                                        vector<string> &chain)
+{
+    for (const auto &f : chain) {
+        fatal_if(sameFile(f, filepath), "Physical memory checkpoint file "
+                 "'%s' is based on itself\n", filepath);
+    }
+    chain.push_back(filepath);
+
+    ifstream in(filepath, ios::binary);
+    if (!in)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              filepath);
+
+    StoreHeader header;
+    in.read((char *)&header, sizeof(header));
+    if (!in || memcmp(header.magic, storeMagic, sizeof(header.magic)) ||
+        header.version != storeVersion) {
+        fatal("'%s' is not a physical memory checkpoint file\n", filepath);
+    }
+    if (header.pageBytes != DirtyPageMap::PageBytes ||
+        header.rangeSize != range_size) {
+        fatal("Physical memory checkpoint file '%s' does not match the "
+              "memory layout\n", filepath);
+    }
+
+    string base(header.baseLength, '\0');
+    in.read(&base[0], base.size());
+
+    if (!base.empty()) {
+        if (base[0] != '/')
+            base = filepath.substr(0, filepath.rfind('/') + 1) + base;
+        DPRINTF(Checkpoint, "Restoring base %s of %s\n", base, filepath);
+        unserializeChunkedStore(base, pmem, range_size, chain);
+    }
+
+    const Addr num_pages = divCeil(range_size, DirtyPageMap::PageBytes);
+    ChunkHeader chunk;
+    vector<uint8_t> compressed;
+    vector<uint8_t> raw;
+    while (in.read((char *)&chunk, sizeof(chunk))) {
+        compressed.resize(chunk.compressedSize);
+        in.read((char *)compressed.data(), compressed.size());
+
+        Addr raw_size = 0;
+        for (unsigned p = 0; p < DirtyPageMap::PagesPerWord; ++p) {
+            const Addr page = chunk.index * DirtyPageMap::PagesPerWord + p;
+            if (!(chunk.mask & (ULL(1) << p)))
+                continue;
+            if (!in || page >= num_pages)
+                fatal("Corrupt chunk in physical memory checkpoint file "
+                      "'%s'\n", filepath);
+            raw_size += pageBytes(page, range_size);
+        }
+        raw.resize(raw_size);
+        decompressChunk(header.compression, compressed, raw, filepath);
+
+        const uint8_t *data = raw.data();
+        for (unsigned p = 0; p < DirtyPageMap::PagesPerWord; ++p) {
+            if (!(chunk.mask & (ULL(1) << p)))
+                continue;
+            const Addr page = chunk.index * DirtyPageMap::PagesPerWord + p;
+            const Addr bytes = pageBytes(page, range_size);
+            uint8_t *dest = pmem + page * DirtyPageMap::PageBytes;
+            // Only copy pages that are non-zero, or overwrite non-zero
+            // data of a base checkpoint, so we don't give the VM
+            // system hell
+            if (!isZero(data, bytes) || !isZero(dest, bytes))
+                memcpy(dest, data, bytes);
+            data += bytes;
+        }
+    }
+
+    if (!in.eof())
+        fatal("Read failed on physical memory checkpoint file '%s'\n",
+              filepath);
+}
+
+void
+PhysicalMemory::unserializeRawStore(const string &filepath, uint8_t* pmem,
+                                    Addr range_size)
+{
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              filepath);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size != range_size)
+        fatal("Physical memory checkpoint file '%s' does not match the "
+              "memory layout\n", filepath);
+
+    // Replace the backing store with a private mapping of the file in
+    // place, so that the memories keep pointing at the right host
+    // memory. Pages are read on first touch, written pages are copied,
+    // and untouched ones are shared with anybody else mapping the
+    // same checkpoint.
+    int map_flags = MAP_PRIVATE | MAP_FIXED;
+    if (mmapUsingNoReserve)
+        map_flags |= MAP_NORESERVE;
+
+    if (mmap(pmem, range_size, PROT_READ | PROT_WRITE, map_flags, fd, 0) ==
+        MAP_FAILED) {
+        perror("mmap");
+        fatal("Could not mmap physical memory checkpoint file '%s'\n",
+              filepath);
+    }
+
+    close(fd);
+}
+
+void
+PhysicalMemory::unserializeGzipStore(const string &filepath, uint8_t* pmem,
+                                     Addr range_size)
+{
+    const uint32_t chunk_size = 16384;
+
+    // mmap memoryfile
+    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'", filepath);
+
     uint64_t curr_size = 0;
     long* temp_page = new long[chunk_size];
     long* pmem_current;
     uint32_t bytes_read;
-    while (curr_size < range.size()) {
+    while (curr_size < range_size) {
         bytes_read = gzread(compressed_mem, temp_page, chunk_size);
         if (bytes_read == 0)
             break;
@@ -448,5 +950,5 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
 
     if (gzclose(compressed_mem))
         fatal("Close failed on physical memory checkpoint file '%s'\n",
-              filename);
+              filepath);
 }
@@ -38,7 +38,10 @@
 #ifndef __MEM_PHYSICAL_HH__
 #define __MEM_PHYSICAL_HH__
 
+#include <memory>
+
 #include "base/addr_range_map.hh"
+#include "mem/dirty_page_map.hh"
 #include "mem/packet.hh"
 
 /**
@@ -60,7 +63,8 @@ class BackingStoreEntry
     BackingStoreEntry(AddrRange range, uint8_t* pmem,
                       bool conf_table_reported, bool in_addr_map, bool kvm_map)
         : range(range), pmem(pmem), confTableReported(conf_table_reported),
-          inAddrMap(in_addr_map), kvmMap(kvm_map)
+          inAddrMap(in_addr_map), kvmMap(kvm_map),
+          dirtyPages(std::make_shared<DirtyPageMap>(range.size()))
         {}
 
     /**
@@ -89,6 +93,12 @@ class BackingStoreEntry
       * acceleration.
       */
      bool kvmMap;
+
+     /**
+      * Pages written since the last checkpoint of this store, shared
+      * with the memories it backs.
+      */
+     std::shared_ptr<DirtyPageMap> dirtyPages;
 };
 
 /**
@@ -116,7 +126,7 @@ class PhysicalMemory : public Serializable
     std::string _name;
 
     // Global address map
-    AddrRangeMap<AbstractMemory*, 1> addrMap;
+    AddrRangeMap<AbstractMemory*> addrMap;
 
     // All address-mapped memories
     std::vector<AbstractMemory*> memories;
@@ -131,6 +141,20 @@ class PhysicalMemory : public Serializable
     // system
     std::vector<BackingStoreEntry> backingStore;
 
+    // Write checkpoints that can be mapped rather than read on restore
+    const bool uncompressedCheckpoints;
+
+    // Number of incremental checkpoints to write after a full one
+    const unsigned checkpointChainLength;
+
+    // Number of threads used to compress memory checkpoints
+    const unsigned compressionThreads;
+
+    // Store files of the chain of checkpoints leading up to the last
+    // checkpoint written or restored, starting with the full one. The
+    // last file serves as base of the next incremental checkpoint.
+    mutable std::vector<std::vector<std::string>> storeChain;
+
     // Prevent copying
     PhysicalMemory(const PhysicalMemory&);
 
@@ -155,10 +179,20 @@ class PhysicalMemory : public Serializable
 
     /**
      * Create a physical memory object, wrapping a number of memories.
+     *
+     * @param uncompressed_checkpoints Write checkpoints that are
+     *        mapped into the backing store on restore
+     * @param checkpoint_chain_length Incremental checkpoints to write
+     *        between full ones, 0 to always write full checkpoints
+     * @param compression_threads Threads compressing checkpoints, 0
+     *        to use one per host core
      */
     PhysicalMemory(const std::string& _name,
                    const std::vector<AbstractMemory*>& _memories,
-                   bool mmap_using_noreserve);
+                   bool mmap_using_noreserve,
+                   bool uncompressed_checkpoints,
+                   unsigned checkpoint_chain_length,
+                   unsigned compression_threads);
 
     /**
      * Unmap all the backing store we have used.
@@ -180,6 +214,15 @@ class PhysicalMemory : public Serializable
      */
     bool isMemAddr(Addr addr) const;
 
+    /**
+     * Find the memory holding a physical address in the global
+     * address map.
+     *
+     * @param addr A physical address
+     * @return The memory, or nullptr if there is none
+     */
+    AbstractMemory *findMemory(Addr addr) const;
+
     /**
      * Get the memory ranges for all memories that are to be reported
      * to the configuration table. The ranges are merged before they
@@ -242,7 +285,11 @@ class PhysicalMemory : public Serializable
     void serialize(CheckpointOut &cp) const override;
 
     /**
-     * Serialize a specific store.
+     * Serialize a specific store. The store is written in chunks of
+     * DirtyPageMap::PagesPerWord pages that are compressed in
+     * parallel. If the previous checkpoint of the store can be used
+     * as a base, only the pages written since are stored, together
+     * with a reference to that base.
      *
      * @param store_id Unique identifier of this backing store
      * @param range The address range of this backing store
@@ -260,9 +307,56 @@ class PhysicalMemory : public Serializable
 
     /**
      * Unserialize a specific backing store, identified by a section.
+     * Incremental checkpoints are restored by first restoring the
+     * chain of checkpoints they are based on.
      */
     void unserializeStore(CheckpointIn &cp);
 
+  private:
+
+    /**
+     * Write a store as a sequence of compressed chunks, optionally
+     * leaving out the pages that are clean with respect to a base.
+     */
+    void serializeChunkedStore(const std::string &filepath,
+                               const std::string &base,
+                               unsigned chain_depth, bool incremental,
+                               uint8_t* pmem, Addr range_size,
+                               const DirtyPageMap &dirty_pages) const;
+
+    /**
+     * Write a store as an uncompressed image, with holes for the zero
+     * pages where the file system supports them.
+     */
+    void serializeRawStore(const std::string &filepath, uint8_t* pmem,
+                           Addr range_size) const;
+
+    /**
+     * Restore a store from a chunked checkpoint file, including the
+     * checkpoints it is based on.
+     *
+     * @param chain Files depending on this one, to which the file and
+     *              the ones it is based on are added
+     */
+    void unserializeChunkedStore(const std::string &filepath,
+                                 uint8_t* pmem, Addr range_size,
+                                 std::vector<std::string> &chain);
+
+    /**
+     * Restore a store by mapping an uncompressed checkpoint file copy
+     * on write in place of the backing store. Pages are only read
+     * when first touched.
+     */
+    void unserializeRawStore(const std::string &filepath, uint8_t* pmem,
+                             Addr range_size);
+
+    /**
+     * Restore a store from a checkpoint file holding a single gzip
+     * stream of the whole store.
+     */
+    void unserializeGzipStore(const std::string &filepath, uint8_t* pmem,
+                              Addr range_size);
+
 };
 
 #endif //__MEM_PHYSICAL_HH__
@@ -91,10 +91,16 @@ MasterPort::getAddrRanges() const
     return _slavePort->getAddrRanges();
 }
 
+SimObject &
+MasterPort::getPeerOwner() const
+{
+    return _slavePort->owner;
+}
+
 void
 MasterPort::printAddr(Addr a)
 {
-    auto req = std::make_shared<Request>(
+    auto req = Request::create(
         a, 1, 0, Request::funcMasterId);
 
     Packet pkt(req, MemCmd::PrintReq);
@@ -131,6 +137,12 @@ SlavePort::slaveBind(MasterPort& master_port)
     Port::bind(master_port);
 }
 
+SimObject &
+SlavePort::getPeerOwner() const
+{
+    return _masterPort->owner;
+}
+
 Tick
 SlavePort::recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &backdoor)
 {
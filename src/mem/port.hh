@@ -111,6 +111,11 @@ class MasterPort : public Port, public AtomicRequestProtocol,
      */
     AddrRangeList getAddrRanges() const;
 
+    /**
+     * Get the SimObject owning the connected slave port.
+     */
+    SimObject &getPeerOwner() const;
+
     /**
      * Inject a PrintReq for the given address to print the state of
      * that address throughout the memory system.  For debugging.
@@ -275,6 +280,11 @@ class SlavePort : public Port, public AtomicResponseProtocol,
      */
     bool isSnooping() const { return _masterPort->isSnooping(); }
 
+    /**
+     * Get the SimObject owning the connected master port.
+     */
+    SimObject &getPeerOwner() const;
+
     /**
      * Called by the owner to send a range change
      */
@@ -50,9 +50,12 @@
 
 #include <cassert>
 #include <climits>
+#include <memory>
+#include <utility>
 
 #include "base/amo.hh"
 #include "base/flags.hh"
+#include "base/free_list_pool.hh"
 #include "base/logging.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
@@ -83,6 +86,9 @@ class ThreadContext;
 typedef std::shared_ptr<Request> RequestPtr;
 typedef uint16_t MasterID;
 
+/** Pool the requests and their shared_ptr control blocks come from. */
+extern FreeListPool requestPool;
+
 class Request
 {
   public:
@@ -410,6 +416,21 @@ class Request
 
     ~Request() {}
 
+    /**
+     * Create a new request. This is equivalent to
+     * std::make_shared<Request>() with the same arguments, but takes
+     * the memory for the request and its reference count from
+     * requestPool instead of the heap.
+     */
+    template <typename... Args>
+    static RequestPtr
+    create(Args&&... args)
+    {
+        return std::allocate_shared<Request>(
+            FreeListAllocator<Request, requestPool>(),
+            std::forward<Args>(args)...);
+    }
+
     /**
      * Set up Context numbers.
      */
@@ -483,8 +504,8 @@ class Request
         assert(privateFlags.isSet(VALID_VADDR));
         assert(privateFlags.noneSet(VALID_PADDR));
         assert(split_addr > _vaddr && split_addr < _vaddr + _size);
-        req1 = std::make_shared<Request>(*this);
-        req2 = std::make_shared<Request>(*this);
+        req1 = create(*this);
+        req2 = create(*this);
         req1->_size = split_addr - _vaddr;
         req2->_vaddr = split_addr;
         req2->_size = _size - req1->_size;
@@ -68,7 +68,14 @@ class Consumer
         m_scheduled_wakeups.insert(time);
     }
 
-    void scheduleEventAbsolute(Tick timeAbs);
+    /**
+     * Schedule a wakeup at an absolute time. Consumers that batch their
+     * wakeups with others (e.g., the garnet routers) override this.
+     */
+    virtual void scheduleEventAbsolute(Tick timeAbs);
+
+    //! Event queue on which the consumer is woken up.
+    EventQueue *eventQueue() const { return em->eventQueue(); }
 
   protected:
     void scheduleEvent(Cycles timeDelta);
@@ -40,6 +40,7 @@
 
 #include "mem/ruby/network/MessageBuffer.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "base/cprintf.hh"
@@ -57,7 +58,7 @@ MessageBuffer::MessageBuffer(const Params *p)
     m_max_size(p->buffer_size), m_time_last_time_size_checked(0),
     m_time_last_time_enqueue(0), m_time_last_time_pop(0),
     m_last_arrival_time(0), m_strict_fifo(p->ordered),
-    m_randomization(p->randomization)
+    m_randomization(p->randomization), m_min_latency(p->min_latency)
 {
     m_msg_counter = 0;
     m_consumer = NULL;
@@ -67,7 +68,6 @@ MessageBuffer::MessageBuffer(const Params *p)
     m_msgs_this_cycle = 0;
     m_priority_rank = 0;
 
-    m_stall_msg_map.clear();
     m_input_link_id = 0;
     m_vnet_id = 0;
 
@@ -82,7 +82,7 @@ MessageBuffer::getSize(Tick curTime)
 {
     if (m_time_last_time_size_checked != curTime) {
         m_time_last_time_size_checked = curTime;
-        m_size_last_time_size_checked = m_prio_heap.size();
+        m_size_last_time_size_checked = numMessages();
     }
 
     return m_size_last_time_size_checked;
@@ -106,7 +106,7 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
 
     if (m_time_last_time_pop < current_time) {
         // no pops this cycle - heap and stall queue size is correct
-        current_size = m_prio_heap.size();
+        current_size = numMessages();
         current_stall_size = m_stall_map_size;
     } else {
         if (m_time_last_time_enqueue < current_time) {
@@ -129,7 +129,7 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
         DPRINTF(RubyQueue, "n: %d, current_size: %d, heap size: %d, "
                 "m_max_size: %d\n",
                 n, current_size + current_stall_size,
-                m_prio_heap.size(), m_max_size);
+                numMessages(), m_max_size);
         m_not_avail_count++;
         return false;
     }
@@ -139,7 +139,7 @@ const Message*
 MessageBuffer::peek() const
 {
     DPRINTF(RubyQueue, "Peeking at head of queue.\n");
-    const Message* msg_ptr = m_prio_heap.front().get();
+    const Message* msg_ptr = head().get();
     assert(msg_ptr);
 
     DPRINTF(RubyQueue, "Message: %s\n", (*msg_ptr));
@@ -173,6 +173,7 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
     // Calculate the arrival time of the message, that is, the first
     // cycle the message can be dequeued.
     assert(delta > 0);
+    assert(delta >= m_min_latency);
     Tick arrival_time = 0;
 
     // random delays are inserted if either RubySystem level randomization flag
@@ -190,6 +191,8 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
         } else {
             arrival_time = current_time + random_time();
         }
+        // never undercut the latency declared as lookahead
+        arrival_time = std::max(arrival_time, current_time + m_min_latency);
     }
 
     // Check the arrival time
@@ -219,9 +222,8 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
     msg_ptr->setLastEnqueueTime(arrival_time);
     msg_ptr->setMsgCounter(m_msg_counter);
 
-    // Insert the message into the priority heap
-    m_prio_heap.push_back(message);
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), greater<MsgPtr>());
+    // Insert the message into the queue
+    insertMessage(message);
     // Increment the number of messages statistic
     m_buf_msgs++;
 
@@ -241,7 +243,7 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     assert(isReady(current_time));
 
     // get MsgPtr of the message about to be dequeued
-    MsgPtr message = m_prio_heap.front();
+    MsgPtr message = head();
 
     // get the delay cycles
     message->updateDelayedTicks(current_time);
@@ -252,13 +254,12 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     // record previous size and time so the current buffer size isn't
     // adjusted until schd cycle
     if (m_time_last_time_pop < current_time) {
-        m_size_at_cycle_start = m_prio_heap.size();
+        m_size_at_cycle_start = numMessages();
         m_stalled_at_cycle_start = m_stall_map_size;
         m_time_last_time_pop = current_time;
     }
 
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), greater<MsgPtr>());
-    m_prio_heap.pop_back();
+    popHead();
     if (decrement_messages) {
         // If the message will be removed from the queue, decrement the
         // number of message in the queue.
@@ -288,6 +289,7 @@ MessageBuffer::unregisterDequeueCallback()
 void
 MessageBuffer::clear()
 {
+    m_fifo.clear();
     m_prio_heap.clear();
 
     m_msg_counter = 0;
@@ -303,52 +305,73 @@ MessageBuffer::recycle(Tick current_time, Tick recycle_latency)
 {
     DPRINTF(RubyQueue, "Recycling.\n");
     assert(isReady(current_time));
-    MsgPtr node = m_prio_heap.front();
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), greater<MsgPtr>());
+    MsgPtr node = popHead();
 
     Tick future_time = current_time + recycle_latency;
     node->setLastEnqueueTime(future_time);
 
-    m_prio_heap.back() = node;
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), greater<MsgPtr>());
+    insertMessage(node);
     m_consumer->scheduleEventAbsolute(future_time);
 }
 
 void
-MessageBuffer::reanalyzeList(list<MsgPtr> &lt, Tick schdTick)
+MessageBuffer::insertMessage(const MsgPtr &message)
+{
+    if (m_fifo.empty() || !(m_fifo.back() > message)) {
+        m_fifo.push_back(message);
+    } else {
+        m_prio_heap.push_back(message);
+        push_heap(m_prio_heap.begin(), m_prio_heap.end(), greater<MsgPtr>());
+    }
+}
+
+MsgPtr
+MessageBuffer::popHead()
+{
+    MsgPtr message;
+    if (headInHeap()) {
+        pop_heap(m_prio_heap.begin(), m_prio_heap.end(), greater<MsgPtr>());
+        message = std::move(m_prio_heap.back());
+        m_prio_heap.pop_back();
+    } else {
+        message = std::move(m_fifo.front());
+        m_fifo.pop_front();
+    }
+    return message;
+}
+
+void
+MessageBuffer::reanalyzeList(StallMsgList &lt, Tick schdTick)
 {
-    while (!lt.empty()) {
-        MsgPtr m = lt.front();
+    for (auto &m : lt) {
         assert(m->getLastEnqueueTime() <= schdTick);
 
-        m_prio_heap.push_back(m);
-        push_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                  greater<MsgPtr>());
+        insertMessage(m);
 
         m_consumer->scheduleEventAbsolute(schdTick);
 
         DPRINTF(RubyQueue, "Requeue arrival_time: %lld, Message: %s\n",
             schdTick, *(m.get()));
-
-        lt.pop_front();
     }
+    lt.clear();
 }
 
 void
 MessageBuffer::reanalyzeMessages(Addr addr, Tick current_time)
 {
     DPRINTF(RubyQueue, "ReanalyzeMessages %#x\n", addr);
-    assert(m_stall_msg_map.count(addr) > 0);
+    StallMsgList *msgs = m_stall_msg_map.find(addr);
+    assert(msgs);
 
     //
-    // Put all stalled messages associated with this address back on the
-    // prio heap.  The reanalyzeList call will make sure the consumer is
+    // Put all stalled messages associated with this address back in the
+    // queue.  The reanalyzeList call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle
     //
-    m_stall_map_size -= m_stall_msg_map[addr].size();
+    m_stall_map_size -= msgs->size();
     assert(m_stall_map_size >= 0);
-    reanalyzeList(m_stall_msg_map[addr], current_time);
+    reanalyzeList(*msgs, current_time);
     m_stall_msg_map.erase(addr);
 }
 
@@ -358,17 +381,17 @@ MessageBuffer::reanalyzeAllMessages(Tick current_time)
     DPRINTF(RubyQueue, "ReanalyzeAllMessages\n");
 
     //
-    // Put all stalled messages associated with this address back on the
-    // prio heap.  The reanalyzeList call will make sure the consumer is
+    // Put all stalled messages associated with this address back in the
+    // queue.  The reanalyzeList call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle.
     //
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end(); ++map_iter) {
-        m_stall_map_size -= map_iter->second.size();
+    m_stall_msg_map.forEach([this, current_time](Addr addr,
+                                                StallMsgList &msgs) {
+        m_stall_map_size -= msgs.size();
         assert(m_stall_map_size >= 0);
-        reanalyzeList(map_iter->second, current_time);
-    }
+        reanalyzeList(msgs, current_time);
+    });
     m_stall_msg_map.clear();
 }
 
@@ -378,7 +401,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
     DPRINTF(RubyQueue, "Stalling due to %#x\n", addr);
     assert(isReady(current_time));
     assert(getOffset(addr) == 0);
-    MsgPtr message = m_prio_heap.front();
+    MsgPtr message = head();
 
     // Since the message will just be moved to stall map, indicate that the
     // buffer should not decrement the m_buf_msgs statistic
@@ -402,16 +425,17 @@ MessageBuffer::print(ostream& out) const
         ccprintf(out, " consumer-yes ");
     }
 
-    vector<MsgPtr> copy(m_prio_heap);
-    sort_heap(copy.begin(), copy.end(), greater<MsgPtr>());
+    vector<MsgPtr> copy(m_fifo.begin(), m_fifo.end());
+    copy.insert(copy.end(), m_prio_heap.begin(), m_prio_heap.end());
+    sort(copy.begin(), copy.end(), greater<MsgPtr>());
     ccprintf(out, "%s] %s", copy, name());
 }
 
 bool
 MessageBuffer::isReady(Tick current_time) const
 {
-    return ((m_prio_heap.size() > 0) &&
-        (m_prio_heap.front()->getLastEnqueueTime() <= current_time));
+    return ((numMessages() > 0) &&
+        (head()->getLastEnqueueTime() <= current_time));
 }
 
 void
@@ -457,34 +481,32 @@ MessageBuffer::functionalAccess(Packet *pkt, bool is_read)
 
     uint32_t num_functional_accesses = 0;
 
-    // Check the priority heap and write any messages that may
-    // correspond to the address in the packet.
-    for (unsigned int i = 0; i < m_prio_heap.size(); ++i) {
-        Message *msg = m_prio_heap[i].get();
+    bool read_done = false;
+    auto access = [&](const MsgPtr &msg) {
+        if (read_done)
+            return;
         if (is_read && msg->functionalRead(pkt))
-            return 1;
+            read_done = true;
         else if (!is_read && msg->functionalWrite(pkt))
             num_functional_accesses++;
-    }
+    };
+
+    // Check the queue and write any messages that may
+    // correspond to the address in the packet.
+    for (const auto &msg : m_fifo)
+        access(msg);
+    for (const auto &msg : m_prio_heap)
+        access(msg);
 
     // Check the stall queue and write any messages that may
     // correspond to the address in the packet.
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end();
-         ++map_iter) {
-
-        for (std::list<MsgPtr>::iterator it = (map_iter->second).begin();
-            it != (map_iter->second).end(); ++it) {
-
-            Message *msg = (*it).get();
-            if (is_read && msg->functionalRead(pkt))
-                return 1;
-            else if (!is_read && msg->functionalWrite(pkt))
-                num_functional_accesses++;
-        }
-    }
+    m_stall_msg_map.forEach([&access](Addr addr,
+                                      StallMsgList &msgs) {
+        for (const auto &msg : msgs)
+            access(msg);
+    });
 
-    return num_functional_accesses;
+    return read_done ? 1 : num_functional_accesses;
 }
 
 MessageBuffer *
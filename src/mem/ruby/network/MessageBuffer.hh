@@ -48,11 +48,13 @@
 
 #include <algorithm>
 #include <cassert>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <string>
 #include <vector>
 
+#include "base/flat_hash_map.hh"
 #include "base/trace.hh"
 #include "debug/RubyQueue.hh"
 #include "mem/packet.hh"
@@ -80,10 +82,7 @@ class MessageBuffer : public SimObject
     void
     delayHead(Tick current_time, Tick delta)
     {
-        MsgPtr m = m_prio_heap.front();
-        std::pop_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                      std::greater<MsgPtr>());
-        m_prio_heap.pop_back();
+        MsgPtr m = popHead();
         enqueue(m, current_time, delta);
     }
 
@@ -99,6 +98,18 @@ class MessageBuffer : public SimObject
                   *consumer, *this, *m_consumer);
         }
         m_consumer = consumer;
+
+        // Messages are reference counted without atomics, which is only
+        // safe if the quantum keeps the sender and the consumer of a
+        // buffer from touching a message at the same time. A buffer
+        // without a min_latency can't bound the quantum, so it must not
+        // cross event queues.
+        if (consumer->eventQueue() != eventQueue() && m_min_latency == 0) {
+            fatal("MessageBuffer %s crosses event queues but has no "
+                  "min_latency.\n", name());
+        }
+        declareLinkLatency(name(), eventQueue(), consumer->eventQueue(),
+                           m_min_latency);
     }
 
     Consumer* getConsumer() { return m_consumer; }
@@ -109,7 +120,7 @@ class MessageBuffer : public SimObject
     //! message queue.  The function assumes that the queue is nonempty.
     const Message* peek() const;
 
-    const MsgPtr &peekMsgPtr() const { return m_prio_heap.front(); }
+    const MsgPtr &peekMsgPtr() const { return head(); }
 
     void enqueue(MsgPtr message, Tick curTime, Tick delta);
 
@@ -121,8 +132,8 @@ class MessageBuffer : public SimObject
     void unregisterDequeueCallback();
 
     void recycle(Tick current_time, Tick recycle_latency);
-    bool isEmpty() const { return m_prio_heap.size() == 0; }
-    bool isStallMapEmpty() { return m_stall_msg_map.size() == 0; }
+    bool isEmpty() const { return numMessages() == 0; }
+    bool isStallMapEmpty() { return m_stall_msg_map.empty(); }
     unsigned int getStallMapSize() { return m_stall_msg_map.size(); }
 
     unsigned int getSize(Tick curTime);
@@ -160,7 +171,31 @@ class MessageBuffer : public SimObject
     }
 
   private:
-    void reanalyzeList(std::list<MsgPtr> &, Tick);
+    /** Number of messages in the queue, not counting stalled ones */
+    size_t numMessages() const { return m_fifo.size() + m_prio_heap.size(); }
+
+    /** Is the head of the queue in m_prio_heap, rather than m_fifo? */
+    bool
+    headInHeap() const
+    {
+        return !m_prio_heap.empty() &&
+            (m_fifo.empty() || m_fifo.front() > m_prio_heap.front());
+    }
+
+    const MsgPtr &
+    head() const
+    {
+        return headInHeap() ? m_prio_heap.front() : m_fifo.front();
+    }
+
+    /** Put a message in the queue, in order of its arrival time */
+    void insertMessage(const MsgPtr &message);
+    /** Remove the message at the head of the queue */
+    MsgPtr popHead();
+
+    typedef std::vector<MsgPtr> StallMsgList;
+
+    void reanalyzeList(StallMsgList &, Tick);
 
     uint32_t functionalAccess(Packet *pkt, bool is_read);
 
@@ -168,28 +203,36 @@ class MessageBuffer : public SimObject
     // Data Members (m_ prefix)
     //! Consumer to signal a wakeup(), can be NULL
     Consumer* m_consumer;
+
+    /**
+     * The queued messages, ordered by arrival time and then enqueue
+     * order, are split over two containers. Messages mostly arrive in
+     * order, each no earlier than the previous one, and those are
+     * appended to m_fifo, which stays sorted, in constant time. Only
+     * the messages that would go before the tail of m_fifo (with
+     * randomization, recycled messages, reanalyzed stalled messages,
+     * etc.) are pushed on m_prio_heap. The head of the queue is the
+     * earlier of the fronts of the two.
+     */
+    std::deque<MsgPtr> m_fifo;
     std::vector<MsgPtr> m_prio_heap;
 
     std::function<void()> m_dequeue_callback;
 
-    // use a std::map for the stalled messages as this container is
-    // sorted and ensures a well-defined iteration order
-    typedef std::map<Addr, std::list<MsgPtr> > StallMsgMapType;
-
     /**
      * A map from line addresses to lists of stalled messages for that line.
      * If this buffer allows the receiver to stall messages, on a stall
-     * request, the stalled message is removed from the m_prio_heap and placed
+     * request, the stalled message is removed from the queue and placed
      * in the m_stall_msg_map. Messages are held there until the receiver
      * requests they be reanalyzed, at which point they are moved back to
-     * m_prio_heap.
+     * the queue.
      *
      * NOTE: The stall map holds messages in the order in which they were
-     * initially received, and when a line is unblocked, the messages are
-     * moved back to the m_prio_heap in the same order. This prevents starving
-     * older requests with younger ones.
+     * initially received. Messages moved back to the queue keep their
+     * arrival time and enqueue order, so older requests still go before
+     * younger ones, whatever the order in which the lines are reanalyzed.
      */
-    StallMsgMapType m_stall_msg_map;
+    FlatHashMap<Addr, StallMsgList> m_stall_msg_map;
 
     /**
      * Current size of the stall map.
@@ -226,6 +269,8 @@ class MessageBuffer : public SimObject
     int m_priority_rank;
     const bool m_strict_fifo;
     const bool m_randomization;
+    //! Smallest delay of any enqueued message, 0 if not declared
+    const Tick m_min_latency;
 
     int m_input_link_id;
     int m_vnet_id;
@@ -39,6 +39,11 @@ class MessageBuffer(SimObject):
                                        enqueue times (enforced to have \
                                        random delays if RubySystem \
                                        randomization flag is True)")
+    # A buffer whose consumer runs on another event queue bounds the
+    # multi-eventq quantum by its min_latency. Such a buffer must set it,
+    # a buffer left at 0 can only be used within an event queue.
+    min_latency = Param.Tick(0, "Smallest delay of any message enqueued \
+                                 into this buffer (0 if unknown)")
 
     master = MasterPort("Master port to MessageBuffer receiver")
     slave = SlavePort("Slave port from MessageBuffer sender")
@@ -30,6 +30,8 @@
 
 #include "mem/ruby/network/garnet2.0/Credit.hh"
 
+FreeListPool creditPool("garnet_credit", sizeof(Credit));
+
 // Credit Signal for buffers inside VC
 // Carries m_vc (inherits from flit.hh)
 // and m_is_free_signal (whether VC is free or not)
@@ -38,6 +38,9 @@
 #include "mem/ruby/network/garnet2.0/CommonTypes.hh"
 #include "mem/ruby/network/garnet2.0/flit.hh"
 
+// Pool the credits are allocated from
+extern FreeListPool creditPool;
+
 // Credit Signal for buffers inside VC
 // Carries m_vc (inherits from flit.hh)
 // and m_is_free_signal (whether VC is free or not)
@@ -48,6 +51,20 @@ class Credit : public flit
     Credit() {};
     Credit(int vc, bool is_free_signal, Cycles curTime);
 
+    // Credits are returned for every flit, they have a pool of their
+    // own rather than sharing the one of the flits
+    static void *
+    operator new(size_t size)
+    {
+        return creditPool.allocate(size);
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        creditPool.release(p, size);
+    }
+
     bool is_free_signal() { return m_is_free_signal; }
 
   private:
@@ -54,8 +54,11 @@ class CrossbarSwitch : public Consumer
     update_sw_winner(int inport, flit *t_flit)
     {
         switchBuffers[inport].insert(t_flit);
+        m_num_flits++;
     }
 
+    inline bool is_empty() { return m_num_flits == 0; }
+
     inline double get_crossbar_activity() { return m_crossbar_activity; }
 
     uint32_t functionalWrite(Packet *pkt);
@@ -66,6 +69,8 @@ class CrossbarSwitch : public Consumer
     int m_num_vcs;
     double m_crossbar_activity;
     std::vector<flitBuffer> switchBuffers;
+    // Number of flits in switchBuffers
+    int m_num_flits;
 };
 
 #endif // __MEM_RUBY_NETWORK_GARNET2_0_CROSSBARSWITCH_HH__
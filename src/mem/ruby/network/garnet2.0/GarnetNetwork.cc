@@ -33,6 +33,8 @@
 #include <cassert>
 
 #include "base/cast.hh"
+#include "base/cprintf.hh"
+#include "base/logging.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/network/MessageBuffer.hh"
 #include "mem/ruby/network/garnet2.0/CommonTypes.hh"
@@ -78,10 +80,28 @@ GarnetNetwork::GarnetNetwork(const Params *p)
     for (vector<BasicRouter*>::const_iterator i =  p->routers.begin();
          i != p->routers.end(); ++i) {
         Router* router = safe_cast<Router*>(*i);
+        // Routers, and their partitions, are looked up by id
+        fatal_if(router->get_id() != (int)m_routers.size(),
+                 "%s: router %s has id %d, expected %d.\n", name(),
+                 router->name(), router->get_id(), m_routers.size());
         m_routers.push_back(router);
 
         // initialize the router's network pointers
         router->init_net_ptr(this);
+
+        // Routers on the same event queue form a partition
+        Partition *partition = nullptr;
+        for (auto &part : m_partitions) {
+            if (part->eventq == router->eventQueue())
+                partition = part.get();
+        }
+        if (!partition) {
+            m_partitions.emplace_back(new Partition(
+                csprintf("%s.partition%d", name(), m_partitions.size()),
+                router->eventQueue()));
+            partition = m_partitions.back().get();
+        }
+        m_router_partition.push_back(partition);
     }
 
     // record the network interfaces
@@ -138,6 +158,49 @@ GarnetNetwork::init()
     }
 }
 
+GarnetNetwork::Partition::Partition(const std::string &name,
+                                    EventQueue *eventq)
+    : eventq(eventq),
+      wakeupEvent([this]{ wakeupRouters(); }, name + ".wakeupEvent")
+{
+}
+
+void
+GarnetNetwork::Partition::scheduleWakeup(Router *router, Tick time)
+{
+    wakeups[time].push_back(router);
+
+    if (!wakeupEvent.scheduled())
+        eventq->schedule(&wakeupEvent, time);
+    else if (time < wakeupEvent.when())
+        eventq->reschedule(&wakeupEvent, time);
+}
+
+void
+GarnetNetwork::Partition::wakeupRouters()
+{
+    auto it = wakeups.begin();
+    assert(it != wakeups.end() && it->first == curTick());
+
+    // The routers can schedule more wakeups (even for this tick) while
+    // the batch is woken up
+    batch.swap(it->second);
+    wakeups.erase(it);
+
+    for (auto router : batch)
+        router->wakeup();
+    batch.clear();
+
+    if (!wakeups.empty() && !wakeupEvent.scheduled())
+        eventq->schedule(&wakeupEvent, wakeups.begin()->first);
+}
+
+void
+GarnetNetwork::scheduleRouterWakeup(Router *router, Tick time)
+{
+    m_router_partition[router->get_id()]->scheduleWakeup(router, time);
+}
+
 /*
  * This function creates a link from the Network Interface (NI)
  * into the Network.
@@ -431,6 +494,11 @@ GarnetNetwork::functionalWrite(Packet *pkt)
 {
     uint32_t num_functional_writes = 0;
 
+    // Flits between partitions are in events on their way to the other
+    // partition's queue, and the other threads keep running
+    warn_if_once(m_partitions.size() > 1, "Functional writes to a "
+                 "partitioned garnet network may miss flits in flight.\n");
+
     for (unsigned int i = 0; i < m_routers.size(); i++) {
         num_functional_writes += m_routers[i]->functionalWrite(pkt);
     }
@@ -32,6 +32,8 @@
 #define __MEM_RUBY_NETWORK_GARNET2_0_GARNETNETWORK_HH__
 
 #include <iostream>
+#include <map>
+#include <memory>
 #include <vector>
 
 #include "mem/ruby/network/Network.hh"
@@ -83,6 +85,20 @@ class GarnetNetwork : public Network
     int getNumRouters();
     int get_router_id(int ni);
 
+    /**
+     * Wake up a router at the given time. The wakeups of all routers
+     * for a cycle are done by a single event, and there are no events
+     * at all for the cycles in which no router has flits or credits
+     * coming in or waiting for switch allocation.
+     *
+     * Routers can be spread over several event queues (by setting their
+     * eventq_index) to simulate the network with multiple threads. The
+     * routers of each queue form a partition of the network with its
+     * own wakeup event.
+     */
+    void scheduleRouterWakeup(Router *router, Tick time);
+    int getNumPartitions() const { return m_partitions.size(); }
+
 
     // Methods used by Topology to setup the network
     void makeExtOutLink(SwitchID src, NodeID dest, BasicLink* link,
@@ -192,6 +208,29 @@ class GarnetNetwork : public Network
     std::vector<NetworkLink *> m_networklinks; // All flit links in the network
     std::vector<CreditLink *> m_creditlinks; // All credit links in the network
     std::vector<NetworkInterface *> m_nis;   // All NI's in Network
+
+    /**
+     * The routers of a partition of the network. A partition is only
+     * ever used by the thread of its event queue.
+     */
+    struct Partition
+    {
+        Partition(const std::string &name, EventQueue *eventq);
+
+        void scheduleWakeup(Router *router, Tick time);
+        void wakeupRouters();
+
+        EventQueue *const eventq;
+        // Routers to wake up, by time
+        std::map<Tick, std::vector<Router *>> wakeups;
+        // Batch of routers being woken up
+        std::vector<Router *> batch;
+        EventFunctionWrapper wakeupEvent;
+    };
+
+    std::vector<std::unique_ptr<Partition>> m_partitions;
+    // Partition of each router, by id, which is also its index in m_routers
+    std::vector<Partition *> m_router_partition;
 };
 
 inline std::ostream&
@@ -107,9 +107,17 @@ class InputUnit : public Consumer
     inline flit*
     getTopFlit(int vc)
     {
+        m_num_flits--;
+        m_router->flit_departed();
         return virtualChannels[vc].getTopFlit();
     }
 
+    // Number of flits buffered in the VCs of this input unit
+    inline int get_num_flits() { return m_num_flits; }
+
+    // Are there flits on their way to this input unit?
+    inline bool has_incoming_flit() { return !m_in_link->isEmpty(); }
+
     inline bool
     need_stage(int vc, flit_stage stage, Cycles time)
     {
@@ -154,6 +162,7 @@ class InputUnit : public Consumer
     NetworkLink *m_in_link;
     CreditLink *m_credit_link;
     flitBuffer creditQueue;
+    int m_num_flits;
 
     // Input Virtual channels
     std::vector<VirtualChannel> virtualChannels;
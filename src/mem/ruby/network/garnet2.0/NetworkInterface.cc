@@ -77,6 +77,10 @@ void
 NetworkInterface::addInPort(NetworkLink *in_link,
                               CreditLink *credit_link)
 {
+    fatal_if(credit_link->eventQueue() != eventQueue(),
+             "%s must be on the event queue of %s.\n",
+             credit_link->name(), name());
+
     inNetLink = in_link;
     in_link->setLinkConsumer(this);
     outCreditLink = credit_link;
@@ -88,6 +92,10 @@ NetworkInterface::addOutPort(NetworkLink *out_link,
                              CreditLink *credit_link,
                              SwitchID router_id)
 {
+    fatal_if(out_link->eventQueue() != eventQueue(),
+             "%s must be on the event queue of %s.\n",
+             out_link->name(), name());
+
     inCreditLink = credit_link;
     credit_link->setLinkConsumer(this);
 
@@ -66,6 +66,9 @@ class NetworkInterface : public ClockedObject, public Consumer
                  std::vector<MessageBuffer *> &outNode);
 
     void print(std::ostream& out) const;
+
+    // Both bases have the same event queue
+    using ClockedObject::eventQueue;
     int get_vnet(int vc);
     int get_router_id() { return m_router_id; }
     void init_net_ptr(GarnetNetwork *net_ptr) { m_net_ptr = net_ptr; }
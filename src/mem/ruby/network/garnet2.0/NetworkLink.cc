@@ -37,16 +37,24 @@ NetworkLink::NetworkLink(const Params *p)
     : ClockedObject(p), Consumer(this), m_id(p->link_id),
       m_type(NUM_LINK_TYPES_),
       m_latency(p->link_latency),
-      linkBuffer(), link_consumer(nullptr),
+      linkBuffer(), link_consumer(nullptr), link_consumer_info(0),
+      link_crosses_queues(false),
       link_srcQueue(nullptr), m_link_utilized(0),
       m_vc_load(p->vcs_per_vnet * p->virt_nets)
 {
 }
 
 void
-NetworkLink::setLinkConsumer(Consumer *consumer)
+NetworkLink::setLinkConsumer(Consumer *consumer, int event_info)
 {
     link_consumer = consumer;
+    link_consumer_info = event_info;
+
+    link_crosses_queues = consumer->eventQueue() != eventQueue();
+    if (link_crosses_queues) {
+        declareLinkLatency(name(), eventQueue(), consumer->eventQueue(),
+                           clockPeriod() * m_latency);
+    }
 }
 
 void
@@ -62,16 +70,37 @@ NetworkLink::wakeup()
     if (link_srcQueue->isReady(curCycle())) {
         flit *t_flit = link_srcQueue->getTopFlit();
         t_flit->set_time(curCycle() + m_latency);
-        linkBuffer.insert(t_flit);
-        link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
         m_link_utilized++;
         m_vc_load[t_flit->get_vc()]++;
+
+        if (link_crosses_queues) {
+            // The link buffer belongs to the thread of the consumer
+            auto *deliver_event = new EventFunctionWrapper(
+                [this, t_flit]{ deliver(t_flit); },
+                "NetworkLink deliver", true, Deliver_Pri);
+            link_consumer->eventQueue()->schedule(deliver_event,
+                                                  clockEdge(m_latency));
+        } else {
+            linkBuffer.insert(t_flit);
+            link_consumer->storeEventInfo(link_consumer_info);
+            link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
+        }
     }
 }
 
+void
+NetworkLink::deliver(flit *t_flit)
+{
+    linkBuffer.insert(t_flit);
+    link_consumer->storeEventInfo(link_consumer_info);
+    link_consumer->scheduleEventAbsolute(curTick());
+}
+
 void
 NetworkLink::resetStats()
 {
+    ClockedObject::resetStats();
+
     for (int i = 0; i < m_vc_load.size(); i++) {
         m_vc_load[i] = 0;
     }
@@ -50,11 +50,25 @@ class NetworkLink : public ClockedObject, public Consumer
     NetworkLink(const Params *p);
     ~NetworkLink() = default;
 
-    void setLinkConsumer(Consumer *consumer);
+    /**
+     * Set the consumer of the link. The consumer is told the event info
+     * (see Consumer::storeEventInfo()) with every flit sent to it.
+     *
+     * The link has to be on the event queue of the source of its flits,
+     * but the consumer can be on another one (e.g., for a partitioned
+     * network). Flits are then handed over to the consumer by an event
+     * on its queue, and the link latency is declared as a lookahead
+     * for the synchronization of the queues.
+     */
+    void setLinkConsumer(Consumer *consumer, int event_info = 0);
     void setSourceQueue(flitBuffer *src_queue);
     void setType(link_type type) { m_type = type; }
     link_type getType() { return m_type; }
     void print(std::ostream& out) const {}
+
+    // Both bases have the same event queue
+    using ClockedObject::eventQueue;
+
     int get_id() const { return m_id; }
     void wakeup();
 
@@ -62,6 +76,7 @@ class NetworkLink : public ClockedObject, public Consumer
     const std::vector<unsigned int> & getVcLoad() const { return m_vc_load; }
 
     inline bool isReady(Cycles curTime) { return linkBuffer.isReady(curTime); }
+    inline bool isEmpty() { return linkBuffer.isEmpty(); }
 
     inline flit* peekLink() { return linkBuffer.peekTopFlit(); }
     inline flit* consumeLink() { return linkBuffer.getTopFlit(); }
@@ -70,12 +85,20 @@ class NetworkLink : public ClockedObject, public Consumer
     void resetStats();
 
   private:
+    // Hand a flit over to a consumer on another event queue
+    void deliver(flit *t_flit);
+
+    // Flits from another queue arrive before the consumer wakes up
+    static const Event::Priority Deliver_Pri = Event::Default_Pri - 1;
+
     const int m_id;
     link_type m_type;
     const Cycles m_latency;
 
     flitBuffer linkBuffer;
     Consumer *link_consumer;
+    int link_consumer_info;
+    bool link_crosses_queues;
     flitBuffer *link_srcQueue;
 
     // Statistical variables
@@ -129,6 +129,13 @@ OutputUnit::wakeup()
     }
 }
 
+// Are there credits on their way to this output unit?
+bool
+OutputUnit::has_incoming_credit()
+{
+    return !m_credit_link->isEmpty();
+}
+
 flitBuffer*
 OutputUnit::getOutQueue()
 {
@@ -31,6 +31,9 @@
 
 #include "mem/ruby/network/garnet2.0/Router.hh"
 
+#include <algorithm>
+
+#include "base/logging.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet2.0/CreditLink.hh"
 #include "mem/ruby/network/garnet2.0/GarnetNetwork.hh"
@@ -44,7 +47,8 @@ Router::Router(const Params *p)
   : BasicRouter(p), Consumer(this), m_latency(p->latency),
     m_virtual_networks(p->virt_nets), m_vc_per_vnet(p->vcs_per_vnet),
     m_num_vcs(m_virtual_networks * m_vc_per_vnet), m_network_ptr(nullptr),
-    routingUnit(this), switchAllocator(this), crossbarSwitch(this)
+    routingUnit(this), switchAllocator(this), crossbarSwitch(this),
+    m_num_flits(0), m_scheduled_wakeup(MaxTick), m_last_wakeup(MaxTick)
 {
     m_input_unit.clear();
     m_output_unit.clear();
@@ -59,14 +63,38 @@ Router::init()
     crossbarSwitch.init();
 }
 
+/*
+ * The router only checks the ports that have flits or credits coming in,
+ * and only runs switch allocation and traversal if there are flits in
+ * the input VCs and in the crossbar. The ports are still checked in the
+ * order of their ids, as that can affect routing decisions.
+ */
+
 void
 Router::wakeup()
 {
+    // The router can be in the same batch more than once
+    if (m_last_wakeup == curTick())
+        return;
+    m_last_wakeup = curTick();
+
     DPRINTF(RubyNetwork, "Router %d woke up\n", m_id);
 
     // check for incoming flits
-    for (int inport = 0; inport < m_input_unit.size(); inport++) {
-        m_input_unit[inport]->wakeup();
+    if (!m_pending_inports.empty()) {
+        std::sort(m_pending_inports.begin(), m_pending_inports.end());
+        for (int inport : m_pending_inports) {
+            m_input_unit[inport]->wakeup();
+        }
+        auto it = std::remove_if(
+            m_pending_inports.begin(), m_pending_inports.end(),
+            [this](int inport) {
+                if (m_input_unit[inport]->has_incoming_flit())
+                    return false;
+                m_inport_pending[inport] = false;
+                return true;
+            });
+        m_pending_inports.erase(it, m_pending_inports.end());
     }
 
     // check for incoming credits
@@ -75,15 +103,59 @@ Router::wakeup()
     //     credit traversal (1-cycle) + SA (1-cycle) + Link Traversal (1-cycle)
     // if we want the credit update to take place after SA, this loop should
     // be moved after the SA request
-    for (int outport = 0; outport < m_output_unit.size(); outport++) {
-        m_output_unit[outport]->wakeup();
+    if (!m_pending_outports.empty()) {
+        std::sort(m_pending_outports.begin(), m_pending_outports.end());
+        for (int outport : m_pending_outports) {
+            m_output_unit[outport]->wakeup();
+        }
+        auto it = std::remove_if(
+            m_pending_outports.begin(), m_pending_outports.end(),
+            [this](int outport) {
+                if (m_output_unit[outport]->has_incoming_credit())
+                    return false;
+                m_outport_pending[outport] = false;
+                return true;
+            });
+        m_pending_outports.erase(it, m_pending_outports.end());
     }
 
     // Switch Allocation
-    switchAllocator.wakeup();
+    if (m_num_flits > 0)
+        switchAllocator.wakeup();
 
     // Switch Traversal
-    crossbarSwitch.wakeup();
+    if (!crossbarSwitch.is_empty())
+        crossbarSwitch.wakeup();
+}
+
+void
+Router::storeEventInfo(int info)
+{
+    if (info >= 0) {
+        if (!m_inport_pending[info]) {
+            m_inport_pending[info] = true;
+            m_pending_inports.push_back(info);
+        }
+    } else {
+        int outport = -1 - info;
+        if (!m_outport_pending[outport]) {
+            m_outport_pending[outport] = true;
+            m_pending_outports.push_back(outport);
+        }
+    }
+}
+
+void
+Router::scheduleEventAbsolute(Tick time)
+{
+    // Routers usually get several wakeups for the same cycle, e.g.,
+    // from flits coming in on different ports. Later duplicates are
+    // dropped by wakeup().
+    if (time == m_scheduled_wakeup)
+        return;
+
+    m_scheduled_wakeup = time;
+    m_network_ptr->scheduleRouterWakeup(this, time);
 }
 
 void
@@ -93,12 +165,18 @@ Router::addInPort(PortDirection inport_dirn,
     int port_num = m_input_unit.size();
     InputUnit *input_unit = new InputUnit(port_num, inport_dirn, this);
 
+    // The router sends credits over the link
+    fatal_if(credit_link->eventQueue() != eventQueue(),
+             "%s must be on the event queue of %s.\n",
+             credit_link->name(), name());
+
     input_unit->set_in_link(in_link);
     input_unit->set_credit_link(credit_link);
-    in_link->setLinkConsumer(this);
+    in_link->setLinkConsumer(this, port_num);
     credit_link->setSourceQueue(input_unit->getCreditQueue());
 
     m_input_unit.push_back(std::shared_ptr<InputUnit>(input_unit));
+    m_inport_pending.push_back(false);
 
     routingUnit.addInDirection(inport_dirn, port_num);
 }
@@ -112,12 +190,18 @@ Router::addOutPort(PortDirection outport_dirn,
     int port_num = m_output_unit.size();
     OutputUnit *output_unit = new OutputUnit(port_num, outport_dirn, this);
 
+    // The router sends flits over the link
+    fatal_if(out_link->eventQueue() != eventQueue(),
+             "%s must be on the event queue of %s.\n",
+             out_link->name(), name());
+
     output_unit->set_out_link(out_link);
     output_unit->set_credit_link(credit_link);
-    credit_link->setLinkConsumer(this);
+    credit_link->setLinkConsumer(this, creditEventInfo(port_num));
     out_link->setSourceQueue(output_unit->getOutQueue());
 
     m_output_unit.push_back(std::shared_ptr<OutputUnit>(output_unit));
+    m_outport_pending.push_back(false);
 
     routingUnit.addRoute(routing_table_entry);
     routingUnit.addWeight(link_weight);
@@ -215,6 +299,8 @@ Router::collateStats()
 void
 Router::resetStats()
 {
+    BasicRouter::resetStats();
+
     for (int j = 0; j < m_virtual_networks; j++) {
         for (int i = 0; i < m_input_unit.size(); i++) {
             m_input_unit[i]->resetStats();
@@ -64,6 +64,28 @@ class Router : public BasicRouter, public Consumer
     void wakeup();
     void print(std::ostream& out) const {};
 
+    // Both bases have the same event queue
+    using BasicRouter::eventQueue;
+
+    /**
+     * The links into the router tell it which port a flit or a credit
+     * is coming in on, so a wakeup only looks at those ports.
+     * Non-negative infos are inports receiving flits, negative ones are
+     * outports receiving credits (see creditEventInfo()).
+     */
+    void storeEventInfo(int info);
+    static int creditEventInfo(int outport) { return -1 - outport; }
+
+    /**
+     * Router wakeups aren't events of their own, they are batched per
+     * cycle for all the routers of the network by GarnetNetwork.
+     */
+    void scheduleEventAbsolute(Tick time) override;
+
+    // Flits entering and leaving the input VCs
+    void flit_arrived() { m_num_flits++; }
+    void flit_departed() { m_num_flits--; }
+
     void init();
     void addInPort(PortDirection inport_dirn, NetworkLink *link,
                    CreditLink *credit_link);
@@ -140,6 +162,19 @@ class Router : public BasicRouter, public Consumer
     std::vector<std::shared_ptr<InputUnit>> m_input_unit;
     std::vector<std::shared_ptr<OutputUnit>> m_output_unit;
 
+    // Ports with flits or credits on their way in, see storeEventInfo()
+    std::vector<int> m_pending_inports;
+    std::vector<int> m_pending_outports;
+    std::vector<bool> m_inport_pending;
+    std::vector<bool> m_outport_pending;
+
+    // Number of flits in the input VCs
+    int m_num_flits;
+
+    // Last wakeup handed to the network, and the last one done
+    Tick m_scheduled_wakeup;
+    Tick m_last_wakeup;
+
     // Statistical variables required for power computations
     Stats::Scalar m_buffer_reads;
     Stats::Scalar m_buffer_writes;
@@ -46,6 +46,7 @@ SwitchAllocator::SwitchAllocator(Router *router)
 
     m_input_arbiter_activity = 0;
     m_output_arbiter_activity = 0;
+    m_num_requests = 0;
 }
 
 void
@@ -87,9 +88,13 @@ void
 SwitchAllocator::wakeup()
 {
     arbitrate_inports(); // First stage of allocation
-    arbitrate_outports(); // Second stage of allocation
 
-    clear_request_vector();
+    // Nothing to do for the outports if all the flits are blocked
+    if (m_num_requests > 0) {
+        arbitrate_outports(); // Second stage of allocation
+        clear_request_vector();
+    }
+
     check_for_wakeup();
 }
 
@@ -109,10 +114,13 @@ SwitchAllocator::arbitrate_inports()
     // Select a VC from each input in a round robin manner
     // Independent arbiter at each input port
     for (int inport = 0; inport < m_num_inports; inport++) {
+        auto input_unit = m_router->getInputUnit(inport);
+        if (input_unit->get_num_flits() == 0)
+            continue;
+
         int invc = m_round_robin_invc[inport];
 
         for (int invc_iter = 0; invc_iter < m_num_vcs; invc_iter++) {
-            auto input_unit = m_router->getInputUnit(inport);
 
             if (input_unit->need_stage(invc, SA_, m_router->curCycle())) {
                 // This flit is in SA stage
@@ -127,6 +135,7 @@ SwitchAllocator::arbitrate_inports()
 
                 if (make_request) {
                     m_input_arbiter_activity++;
+                    m_num_requests++;
                     m_port_requests[outport][inport] = true;
                     m_vc_winners[outport][inport]= invc;
 
@@ -353,8 +362,12 @@ SwitchAllocator::check_for_wakeup()
     Cycles nextCycle = m_router->curCycle() + Cycles(1);
 
     for (int i = 0; i < m_num_inports; i++) {
+        auto input_unit = m_router->getInputUnit(i);
+        if (input_unit->get_num_flits() == 0)
+            continue;
+
         for (int j = 0; j < m_num_vcs; j++) {
-            if (m_router->getInputUnit(i)->need_stage(j, SA_, nextCycle)) {
+            if (input_unit->need_stage(j, SA_, nextCycle)) {
                 m_router->schedule_wakeup(Cycles(1));
                 return;
             }
@@ -381,6 +394,7 @@ SwitchAllocator::clear_request_vector()
             m_port_requests[i][j] = false;
         }
     }
+    m_num_requests = 0;
 }
 
 void
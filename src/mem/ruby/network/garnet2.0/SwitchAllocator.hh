@@ -77,6 +77,8 @@ class SwitchAllocator : public Consumer
     double m_input_arbiter_activity, m_output_arbiter_activity;
 
     Router *m_router;
+    // Number of requests made by SA-I this cycle
+    int m_num_requests;
     std::vector<int> m_round_robin_invc;
     std::vector<int> m_round_robin_inport;
     std::vector<std::vector<bool>> m_port_requests;
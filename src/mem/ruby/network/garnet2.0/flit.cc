@@ -30,6 +30,8 @@
 
 #include "mem/ruby/network/garnet2.0/flit.hh"
 
+FreeListPool flitPool("garnet_flit", sizeof(flit));
+
 // Constructor for the flit
 flit::flit(int id, int  vc, int vnet, RouteInfo route, int size,
     MsgPtr msg_ptr, Cycles curTime)
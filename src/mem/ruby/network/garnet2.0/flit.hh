@@ -34,16 +34,37 @@
 #include <cassert>
 #include <iostream>
 
+#include "base/free_list_pool.hh"
 #include "base/types.hh"
 #include "mem/ruby/network/garnet2.0/CommonTypes.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 
+// Pool the flits are allocated from
+extern FreeListPool flitPool;
+
 class flit
 {
   public:
     flit() {}
     flit(int id, int vc, int vnet, RouteInfo route, int size,
          MsgPtr msg_ptr, Cycles curTime);
+    // Virtual so that deleting a Credit through a flit pointer hands it
+    // back to the pool of the credits
+    virtual ~flit() {}
+
+    // A flit is created and deleted for every flit sent through the
+    // network, recycle their memory
+    static void *
+    operator new(size_t size)
+    {
+        return flitPool.allocate(size);
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        flitPool.release(p, size);
+    }
 
     int get_outport() {return m_outport; }
     int get_size() { return m_size; }
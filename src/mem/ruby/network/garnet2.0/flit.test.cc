@@ -0,0 +1,107 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+#include "mem/ruby/network/garnet2.0/Credit.hh"
+#include "mem/ruby/network/garnet2.0/flit.hh"
+
+/*
+ * The route of a flit holds a NetDest, which refers to the machine types
+ * generated for the protocol. The tests behave as if the system had no
+ * machine of any type.
+ */
+int
+MachineType_base_level(const MachineType &obj)
+{
+    return obj;
+}
+
+MachineType
+MachineType_from_base_level(int type)
+{
+    return MachineType(type);
+}
+
+int
+MachineType_base_number(const MachineType &obj)
+{
+    return 0;
+}
+
+int
+MachineType_base_count(const MachineType &obj)
+{
+    return 0;
+}
+
+static_assert(std::has_virtual_destructor<flit>::value,
+              "Credits are deleted through flit pointers");
+
+/**
+ * A credit deleted through a flit pointer must go back to the pool of the
+ * credits, where the next credit picks it up, not to the one of the flits.
+ */
+TEST(GarnetFlitPoolTest, CreditDeletedAsFlitGoesBackToCreditPool)
+{
+    Credit *credit = new Credit(0, true, Cycles(1));
+    void *addr = credit;
+    flit *base = credit;
+    delete base;
+
+    flit *other = new flit();
+    EXPECT_NE(addr, static_cast<void *>(other));
+
+    const Counter credit_hits = creditPool.hits();
+    Credit *reused = new Credit(1, false, Cycles(2));
+    EXPECT_EQ(addr, static_cast<void *>(reused));
+    EXPECT_EQ(credit_hits + 1, creditPool.hits());
+    EXPECT_EQ(1, reused->get_vc());
+    EXPECT_FALSE(reused->is_free_signal());
+
+    delete reused;
+    delete other;
+}
+
+/** A flit goes back to the pool of the flits, not to the one of credits. */
+TEST(GarnetFlitPoolTest, FlitGoesBackToFlitPool)
+{
+    flit *f = new flit();
+    void *addr = f;
+    delete f;
+
+    Credit *credit = new Credit(0, true, Cycles(1));
+    EXPECT_NE(addr, static_cast<void *>(credit));
+
+    const Counter flit_hits = flitPool.hits();
+    flit *reused = new flit();
+    EXPECT_EQ(addr, static_cast<void *>(reused));
+    EXPECT_EQ(flit_hits + 1, flitPool.hits());
+
+    delete reused;
+    delete credit;
+}
@@ -141,6 +141,8 @@ Switch::regStats()
 void
 Switch::resetStats()
 {
+    BasicRouter::resetStats();
+
     perfectSwitch.clearStats();
     for (auto& throttle : throttles) {
         throttle.clearStats();
@@ -85,6 +85,8 @@ AbstractController::init()
 void
 AbstractController::resetStats()
 {
+    ClockedObject::resetStats();
+
     m_delayHistogram.reset();
     uint32_t size = Network::getNumberOfVirtualNetworks();
     for (uint32_t i = 0; i < size; i++) {
@@ -222,7 +224,7 @@ AbstractController::serviceMemoryQueue()
     }
 
     RequestPtr req
-        = std::make_shared<Request>(mem_msg->m_addr, req_size, 0, m_masterId);
+        = Request::create(mem_msg->m_addr, req_size, 0, m_masterId);
     PacketPtr pkt;
     if (mem_msg->getType() == MemoryRequestType_MEMORY_WB) {
         pkt = Packet::createWrite(req);
@@ -322,7 +324,7 @@ AbstractController::recvTimingResp(PacketPtr pkt)
     assert(getMemRespQueue());
     assert(pkt->isResponse());
 
-    std::shared_ptr<MemoryMsg> msg = std::make_shared<MemoryMsg>(clockEdge());
+    RefCountingPtr<MemoryMsg> msg(new MemoryMsg(clockEdge()));
     (*msg).m_addr = pkt->getAddr();
     (*msg).m_Sender = m_machineID;
 
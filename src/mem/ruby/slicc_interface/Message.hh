@@ -33,14 +33,37 @@
 #include <memory>
 #include <stack>
 
+#include "base/free_list_pool.hh"
+#include "base/refcnt.hh"
 #include "mem/packet.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/protocol/MessageSizeType.hh"
 
 class Message;
-typedef std::shared_ptr<Message> MsgPtr;
+typedef RefCountingPtr<Message> MsgPtr;
 
-class Message
+/**
+ * Pool all Ruby messages are allocated from. When the network is
+ * partitioned over several event queues, messages are created and
+ * destroyed by the threads of different queues; see FreeListPool for
+ * how blocks released by one thread get back to the others.
+ */
+extern FreeListPool rubyMessagePool;
+
+/**
+ * Base class of all the Ruby messages. Messages are created for every
+ * coherence request and response, so they carry their own (non-atomic)
+ * reference count instead of a shared_ptr control block, and they are
+ * allocated from rubyMessagePool. The pool is shared by all message
+ * types, and messages of similar sizes recycle each other's blocks.
+ *
+ * The count is only safe without atomics because a message is used by
+ * one event queue at a time: messages only cross event queues through
+ * message buffers whose latency is at least the synchronization quantum
+ * (see declareLinkLatency()), so the sending thread is done with them
+ * before the receiving one sees them.
+ */
+class Message : public RefCounted
 {
   public:
     Message(Tick curTime)
@@ -50,14 +73,45 @@ class Message
     { }
 
     Message(const Message &other)
-        : m_time(other.m_time),
+        : RefCounted(),
+          m_time(other.m_time),
           m_LastEnqueueTime(other.m_LastEnqueueTime),
           m_DelayedTicks(other.m_DelayedTicks),
           m_msg_counter(other.m_msg_counter)
     { }
 
+    Message &
+    operator=(const Message &other)
+    {
+        // The reference count belongs to this object, leave it alone
+        m_time = other.m_time;
+        m_LastEnqueueTime = other.m_LastEnqueueTime;
+        m_DelayedTicks = other.m_DelayedTicks;
+        m_msg_counter = other.m_msg_counter;
+        return *this;
+    }
+
     virtual ~Message() { }
 
+    /**
+     * Messages come from rubyMessagePool. The destructor is virtual, so
+     * the size passed to operator delete is the size of the actual
+     * message type.
+     * @{
+     */
+    static void *
+    operator new(size_t size)
+    {
+        return rubyMessagePool.allocate(size);
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        rubyMessagePool.release(p, size);
+    }
+    /** @} */
+
     virtual MsgPtr clone() const = 0;
     virtual void print(std::ostream& out) const = 0;
 
@@ -41,6 +41,8 @@
 
 using namespace std;
 
+const Addr CacheMemory::m_invalid_tag;
+
 ostream&
 operator<<(ostream& out, const CacheMemory& obj)
 {
@@ -86,6 +88,7 @@ CacheMemory::init()
 
     m_cache.resize(m_cache_num_sets,
                     std::vector<AbstractCacheEntry*>(m_cache_assoc, nullptr));
+    m_tags.resize(m_cache_num_sets * m_cache_assoc, m_invalid_tag);
     replacement_data.resize(m_cache_num_sets,
                                std::vector<ReplData>(m_cache_assoc, nullptr));
     // instantiate all the replacement_data here
@@ -122,13 +125,10 @@ CacheMemory::addressToCacheSet(Addr address) const
 int
 CacheMemory::findTagInSet(int64_t cacheSet, Addr tag) const
 {
-    assert(tag == makeLineAddress(tag));
-    // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        if (m_cache[cacheSet][it->second]->m_Permission !=
-            AccessPermission_NotPresent)
-            return it->second;
+    int loc = findTagInSetIgnorePermissions(cacheSet, tag);
+    if (loc != -1 &&
+        m_cache[cacheSet][loc]->m_Permission != AccessPermission_NotPresent)
+        return loc;
     return -1; // Not found
 }
 
@@ -140,9 +140,31 @@ CacheMemory::findTagInSetIgnorePermissions(int64_t cacheSet,
 {
     assert(tag == makeLineAddress(tag));
     // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        return it->second;
+    int loc = -1; // Not found
+    const Addr *tags = &m_tags[cacheSet * m_cache_assoc];
+    for (int i = 0; i < m_cache_assoc; i++) {
+        if (tags[i] == tag) {
+            loc = i;
+            break;
+        }
+    }
+#ifdef DEBUG
+    // The tag array must find the same way as a walk of the entries
+    assert(loc == findEntryInSet(cacheSet, tag));
+#endif
+    return loc;
+}
+
+// Walks the entries of a set instead of the tag array, this is only used
+// to check that m_tags is in sync with the entries.
+int
+CacheMemory::findEntryInSet(int64_t cacheSet, Addr tag) const
+{
+    const std::vector<AbstractCacheEntry*> &set = m_cache[cacheSet];
+    for (int i = 0; i < m_cache_assoc; i++) {
+        if (set[i] && set[i]->m_Address == tag)
+            return i;
+    }
     return -1; // Not found
 }
 
@@ -289,7 +311,7 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
             DPRINTF(RubyCache, "Allocate clearing lock for addr: %x\n",
                     address);
             set[i]->m_locked = -1;
-            m_tag_index[address] = i;
+            m_tags[cacheSet * m_cache_assoc + i] = address;
             set[i]->setPosition(cacheSet, i);
             // Call reset function here to set initial value for different
             // replacement policies.
@@ -313,7 +335,7 @@ CacheMemory::deallocate(Addr address)
         m_replacementPolicy_ptr->invalidate(replacement_data[cacheSet][loc]);
         delete m_cache[cacheSet][loc];
         m_cache[cacheSet][loc] = NULL;
-        m_tag_index.erase(address);
+        m_tags[cacheSet * m_cache_assoc + loc] = m_invalid_tag;
     }
 }
 
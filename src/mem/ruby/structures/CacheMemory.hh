@@ -31,7 +31,6 @@
 #define __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -163,6 +162,7 @@ class CacheMemory : public SimObject
     // returns -1 if the tag is not found.
     int findTagInSet(int64_t line, Addr tag) const;
     int findTagInSetIgnorePermissions(int64_t cacheSet, Addr tag) const;
+    int findEntryInSet(int64_t cacheSet, Addr tag) const;
 
     // Private copy constructor and assignment operator
     CacheMemory(const CacheMemory& obj);
@@ -174,9 +174,20 @@ class CacheMemory : public SimObject
 
     // The first index is the # of cache lines.
     // The second index is the the amount associativity.
-    std::unordered_map<Addr, int> m_tag_index;
     std::vector<std::vector<AbstractCacheEntry*> > m_cache;
 
+    /**
+     * Address of the entry held by every way, indexed by
+     * set * m_cache_assoc + way so that the ways of a set are contiguous.
+     * Ways without an entry hold m_invalid_tag. Tag lookups only scan the
+     * ways of one set here, and never dereference the entries of the ways
+     * that do not match.
+     */
+    std::vector<Addr> m_tags;
+
+    /** Tag of an empty way; it is never a line address. */
+    static const Addr m_invalid_tag = MaxAddr;
+
     /**
      * We use BaseReplacementPolicy from Classic system here, hence we can use
      * different replacement policies from Classic system in Ruby system.
@@ -204,6 +204,8 @@ GPUCoalescer::wakeup()
 void
 GPUCoalescer::resetStats()
 {
+    RubyPort::resetStats();
+
     m_latencyHist.reset();
     m_missLatencyHist.reset();
     for (int i = 0; i < RubyRequestType_NUM; i++) {
@@ -918,9 +920,9 @@ GPUCoalescer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
             accessMask[tmpOffset + j] = true;
         }
     }
-    std::shared_ptr<RubyRequest> msg;
+    RefCountingPtr<RubyRequest> msg;
     if (pkt->isAtomicOp()) {
-        msg = std::make_shared<RubyRequest>(clockEdge(), pkt->getAddr(),
+        msg = new RubyRequest(clockEdge(), pkt->getAddr(),
                               pkt->getPtr<uint8_t>(),
                               pkt->getSize(), pc, secondary_type,
                               RubyAccessMode_Supervisor, pkt,
@@ -929,7 +931,7 @@ GPUCoalescer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
                               dataBlock, atomicOps,
                               accessScope, accessSegment);
     } else {
-        msg = std::make_shared<RubyRequest>(clockEdge(), pkt->getAddr(),
+        msg = new RubyRequest(clockEdge(), pkt->getAddr(),
                               pkt->getPtr<uint8_t>(),
                               pkt->getSize(), pc, secondary_type,
                               RubyAccessMode_Supervisor, pkt,
@@ -601,7 +601,7 @@ RubyPort::ruby_eviction_callback(Addr address)
     // Allocate the invalidate request and packet on the stack, as it is
     // assumed they will not be modified or deleted by receivers.
     // TODO: should this really be using funcMasterId?
-    auto request = std::make_shared<Request>(
+    auto request = Request::create(
         address, RubySystem::getBlockSizeBytes(), 0,
         Request::funcMasterId);
 
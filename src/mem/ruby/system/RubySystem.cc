@@ -406,6 +406,8 @@ RubySystem::processRubyEvent()
 void
 RubySystem::resetStats()
 {
+    ClockedObject::resetStats();
+
     m_start_cycle = curCycle();
 }
 
@@ -212,10 +212,10 @@ VIPERCoalescer::invL1()
         Addr addr = m_dataCache_ptr->getAddressAtIdx(i);
         // Evict Read-only data
         RubyRequestType request_type = RubyRequestType_REPLACEMENT;
-        std::shared_ptr<RubyRequest> msg = std::make_shared<RubyRequest>(
+        RefCountingPtr<RubyRequest> msg(new RubyRequest(
             clockEdge(), addr, (uint8_t*) 0, 0, 0,
             request_type, RubyAccessMode_Supervisor,
-            nullptr);
+            nullptr));
         assert(m_mandatory_q_ptr != NULL);
         Tick latency = cyclesToTicks(
                             m_controller->mandatoryQueueLatency(request_type));
@@ -243,10 +243,10 @@ VIPERCoalescer::wbL1()
         Addr addr = m_dataCache_ptr->getAddressAtIdx(i);
         // Write dirty data back
         RubyRequestType request_type = RubyRequestType_FLUSH;
-        std::shared_ptr<RubyRequest> msg = std::make_shared<RubyRequest>(
+        RefCountingPtr<RubyRequest> msg(new RubyRequest(
             clockEdge(), addr, (uint8_t*) 0, 0, 0,
             request_type, RubyAccessMode_Supervisor,
-            nullptr);
+            nullptr));
         assert(m_mandatory_q_ptr != NULL);
         Tick latency = cyclesToTicks(
                             m_controller->mandatoryQueueLatency(request_type));
@@ -271,10 +271,10 @@ VIPERCoalescer::invwbL1()
         Addr addr = m_dataCache_ptr->getAddressAtIdx(i);
         // Evict Read-only data
         RubyRequestType request_type = RubyRequestType_REPLACEMENT;
-        std::shared_ptr<RubyRequest> msg = std::make_shared<RubyRequest>(
+        RefCountingPtr<RubyRequest> msg(new RubyRequest(
             clockEdge(), addr, (uint8_t*) 0, 0, 0,
             request_type, RubyAccessMode_Supervisor,
-            nullptr);
+            nullptr));
         assert(m_mandatory_q_ptr != NULL);
         Tick latency = cyclesToTicks(
                             m_controller->mandatoryQueueLatency(request_type));
@@ -287,10 +287,10 @@ VIPERCoalescer::invwbL1()
         Addr addr = m_dataCache_ptr->getAddressAtIdx(i);
         // Write dirty data back
         RubyRequestType request_type = RubyRequestType_FLUSH;
-        std::shared_ptr<RubyRequest> msg = std::make_shared<RubyRequest>(
+        RefCountingPtr<RubyRequest> msg(new RubyRequest(
             clockEdge(), addr, (uint8_t*) 0, 0, 0,
             request_type, RubyAccessMode_Supervisor,
-            nullptr);
+            nullptr));
         assert(m_mandatory_q_ptr != NULL);
         Tick latency = cyclesToTicks(
                 m_controller->mandatoryQueueLatency(request_type));
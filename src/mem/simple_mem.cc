@@ -81,8 +81,11 @@ SimpleMemory::recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &_backdoor)
 {
     Tick latency = recvAtomic(pkt);
 
-    if (backdoor.ptr())
-        _backdoor = &backdoor;
+    // reads get a read-only backdoor, so that e.g. fetching through
+    // it doesn't defeat the dirty page tracking
+    MemBackdoorPtr bd = getBackdoor(pkt->isWrite());
+    if (bd)
+        _backdoor = bd;
     return latency;
 }
 
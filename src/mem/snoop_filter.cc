@@ -50,17 +50,16 @@
 const int SnoopFilter::SNOOP_MASK_SIZE;
 
 void
-SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
+SnoopFilter::eraseIfNullEntry(size_t slot, const SnoopItem& sf_item)
 {
-    SnoopItem& sf_item = sf_it->second;
     if ((sf_item.requested | sf_item.holder).none()) {
-        cachedLocations.erase(sf_it);
+        cachedLocations.erase(slot);
         DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
                 __func__);
     }
 }
 
-std::pair<SnoopFilter::SnoopList, Cycles>
+std::pair<const SnoopFilter::SnoopList&, Cycles>
 SnoopFilter::lookupRequest(const Packet* cpkt, const SlavePort& slave_port)
 {
     DPRINTF(SnoopFilter, "%s: src %s packet %s\n", __func__,
@@ -74,21 +73,22 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const SlavePort& slave_port)
         line_addr |= LineSecure;
     }
     SnoopMask req_port = portToMask(slave_port);
-    reqLookupResult.it = cachedLocations.find(line_addr);
-    bool is_hit = (reqLookupResult.it != cachedLocations.end());
+    size_t sf_slot = cachedLocations.find(line_addr);
+    bool is_hit = (sf_slot != SnoopFilterCache::invalidSlot);
 
     // If the snoop filter has no entry, and we should not allocate,
     // do not create a new snoop filter entry, simply return a NULL
     // portlist.
-    if (!is_hit && !allocate)
+    reqLookupResult.valid = is_hit || allocate;
+    if (!reqLookupResult.valid)
         return snoopDown(lookupLatency);
 
-    // If no hit in snoop filter create a new element and update iterator
-    if (!is_hit) {
-        reqLookupResult.it =
-            cachedLocations.emplace(line_addr, SnoopItem()).first;
-    }
-    SnoopItem& sf_item = reqLookupResult.it->second;
+    // If no hit in snoop filter create a new element
+    if (!is_hit)
+        sf_slot = cachedLocations.insert(line_addr);
+    reqLookupResult.lineAddr = line_addr;
+
+    SnoopItem sf_item = cachedLocations.get(sf_slot);
     SnoopMask interested = sf_item.holder | sf_item.requested;
 
     // Store unmodified value of snoop filter item in temp storage in
@@ -109,7 +109,8 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const SlavePort& slave_port)
 
     // If we are not allocating, we are done
     if (!allocate)
-        return snoopSelected(maskToPortList(interested & ~req_port),
+        return snoopSelected(maskToPortList(interested & ~req_port,
+                                            reqSnoopPorts),
                              lookupLatency);
 
     if (cpkt->needsResponse()) {
@@ -148,37 +149,48 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const SlavePort& slave_port)
                     __func__,  sf_item.requested, sf_item.holder);
         }
     }
+    cachedLocations.set(sf_slot, sf_item);
 
-    return snoopSelected(maskToPortList(interested & ~req_port), lookupLatency);
+    return snoopSelected(maskToPortList(interested & ~req_port,
+                                        reqSnoopPorts),
+                         lookupLatency);
 }
 
 void
 SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
 {
-    if (reqLookupResult.it != cachedLocations.end()) {
+    if (reqLookupResult.valid) {
+        reqLookupResult.valid = false;
+
         // since we rely on the caller, do a basic check to ensure
         // that finishRequest is being called following lookupRequest
         Addr line_addr = (addr & ~(Addr(linesize - 1)));
         if (is_secure) {
             line_addr |= LineSecure;
         }
-        assert(reqLookupResult.it->first == line_addr);
+        assert(reqLookupResult.lineAddr == line_addr);
+
+        size_t sf_slot = cachedLocations.find(line_addr);
+        if (sf_slot == SnoopFilterCache::invalidSlot)
+            return;
+
+        SnoopItem sf_item = cachedLocations.get(sf_slot);
         if (will_retry) {
-            SnoopItem retry_item = reqLookupResult.retryItem;
             // Undo any changes made in lookupRequest to the snoop filter
             // entry if the request will come again. retryItem holds
             // the previous value of the snoopfilter entry.
-            reqLookupResult.it->second = retry_item;
+            sf_item = reqLookupResult.retryItem;
+            cachedLocations.set(sf_slot, sf_item);
 
             DPRINTF(SnoopFilter, "%s:   restored SF value %x.%x\n",
-                    __func__,  retry_item.requested, retry_item.holder);
+                    __func__,  sf_item.requested, sf_item.holder);
         }
 
-        eraseIfNullEntry(reqLookupResult.it);
+        eraseIfNullEntry(sf_slot, sf_item);
     }
 }
 
-std::pair<SnoopFilter::SnoopList, Cycles>
+std::pair<const SnoopFilter::SnoopList&, Cycles>
 SnoopFilter::lookupSnoop(const Packet* cpkt)
 {
     DPRINTF(SnoopFilter, "%s: packet %s\n", __func__, cpkt->print());
@@ -189,8 +201,8 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = (sf_it != cachedLocations.end());
+    size_t sf_slot = cachedLocations.find(line_addr);
+    bool is_hit = (sf_slot != SnoopFilterCache::invalidSlot);
 
     panic_if(!is_hit && (cachedLocations.size() >= maxEntryCount),
              "snoop filter exceeded capacity of %d cache blocks\n",
@@ -202,7 +214,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (!is_hit)
         return snoopDown(lookupLatency);
 
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem sf_item = cachedLocations.get(sf_slot);
 
     SnoopMask interested = (sf_item.holder | sf_item.requested);
 
@@ -229,13 +241,15 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
         // upward snoops
         DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
-        sf_item.holder = 0;
+        sf_item.holder.reset();
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
-        eraseIfNullEntry(sf_it);
+        cachedLocations.set(sf_slot, sf_item);
+        eraseIfNullEntry(sf_slot, sf_item);
     }
 
-    return snoopSelected(maskToPortList(interested), lookupLatency);
+    return snoopSelected(maskToPortList(interested, snoopSnoopPorts),
+                         lookupLatency);
 }
 
 void
@@ -262,7 +276,10 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
     }
     SnoopMask rsp_mask = portToMask(rsp_port);
     SnoopMask req_mask = portToMask(req_port);
-    SnoopItem& sf_item = cachedLocations[line_addr];
+    size_t sf_slot = cachedLocations.find(line_addr);
+    if (sf_slot == SnoopFilterCache::invalidSlot)
+        sf_slot = cachedLocations.insert(line_addr);
+    SnoopItem sf_item = cachedLocations.get(sf_slot);
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -284,13 +301,14 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
                 "%s: dropping %x because non-shared snoop "
                 "response SF val: %x.%x\n", __func__,  rsp_mask,
                 sf_item.requested, sf_item.holder);
-        sf_item.holder = 0;
+        sf_item.holder.reset();
     }
     assert(!cpkt->isWriteback());
     // @todo Deal with invalidating responses
     sf_item.holder |=  req_mask;
     sf_item.requested &= ~req_mask;
     assert((sf_item.requested | sf_item.holder).any());
+    cachedLocations.set(sf_slot, sf_item);
     DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
             __func__, sf_item.requested, sf_item.holder);
 }
@@ -309,8 +327,8 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = sf_it != cachedLocations.end();
+    size_t sf_slot = cachedLocations.find(line_addr);
+    bool is_hit = sf_slot != SnoopFilterCache::invalidSlot;
 
     // Nothing to do if it is not a hit
     if (!is_hit)
@@ -320,15 +338,16 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     // Modified state, and we know that there are no other copies, or
     // they will all be invalidated imminently
     if (!cpkt->hasSharers()) {
-        SnoopItem& sf_item = sf_it->second;
+        SnoopItem sf_item = cachedLocations.get(sf_slot);
 
         DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
-        sf_item.holder = 0;
+        sf_item.holder.reset();
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
 
-        eraseIfNullEntry(sf_it);
+        cachedLocations.set(sf_slot, sf_item);
+        eraseIfNullEntry(sf_slot, sf_item);
     }
 }
 
@@ -350,12 +369,12 @@ SnoopFilter::updateResponse(const Packet* cpkt, const SlavePort& slave_port)
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    if (sf_it == cachedLocations.end())
+    size_t sf_slot = cachedLocations.find(line_addr);
+    if (sf_slot == SnoopFilterCache::invalidSlot)
         return;
 
     SnoopMask slave_mask = portToMask(slave_port);
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem sf_item = cachedLocations.get(sf_slot);
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -374,7 +393,6 @@ SnoopFilter::updateResponse(const Packet* cpkt, const SlavePort& slave_port)
         if (cpkt->isInvalidate()) {
             sf_item.holder &= ~slave_mask;
         }
-        eraseIfNullEntry(sf_it);
     } else {
         // Any other response implies that a cache above will have the
         // block.
@@ -383,6 +401,9 @@ SnoopFilter::updateResponse(const Packet* cpkt, const SlavePort& slave_port)
     }
     DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
             __func__, sf_item.requested, sf_item.holder);
+
+    cachedLocations.set(sf_slot, sf_item);
+    eraseIfNullEntry(sf_slot, sf_item);
 }
 
 void
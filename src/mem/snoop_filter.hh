@@ -43,13 +43,18 @@
 #ifndef __MEM_SNOOP_FILTER_HH__
 #define __MEM_SNOOP_FILTER_HH__
 
-#include <bitset>
-#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
 #include <utility>
+#include <vector>
 
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
 #include "mem/packet.hh"
 #include "mem/port.hh"
 #include "mem/qport.hh"
+#include "mem/snoop_filter_cache.hh"
 #include "params/SnoopFilter.hh"
 #include "sim/sim_object.hh"
 #include "sim/system.hh"
@@ -82,18 +87,24 @@
  *     upper cache dropped a line, making the snoop filter pessimistic for now
  * (4) ordering: there is no single point of order in the system.  Instead,
  *     requesting MSHRs track order between local requests and remote snoops
+ *
+ * The lines are kept in an open addressing hash table which only
+ * stores as many words of each mask as are needed for the snooping
+ * ports of the crossbar, and the lookups return the ports to snoop in
+ * lists owned by the snoop filter, so that the common cases do not
+ * touch the heap.
  */
 class SnoopFilter : public SimObject {
   public:
 
-    // Change for systems with more than 256 ports tracked by this object
-    static const int SNOOP_MASK_SIZE = 256;
+    static const int SNOOP_MASK_SIZE =
+        SnoopMask::numWords * SnoopMask::wordBits;
 
     typedef std::vector<QueuedSlavePort*> SnoopList;
 
     SnoopFilter (const SnoopFilterParams *p) :
-        SimObject(p), reqLookupResult(cachedLocations.end()),
-        linesize(p->system->cacheLineSize()), lookupLatency(p->lookup_latency),
+        SimObject(p), linesize(p->system->cacheLineSize()),
+        lookupLatency(p->lookup_latency),
         maxEntryCount(p->max_capacity / p->system->cacheLineSize())
     {
     }
@@ -120,6 +131,9 @@ class SnoopFilter : public SimObject {
         fatal_if(id > SNOOP_MASK_SIZE,
                  "Snoop filter only supports %d snooping ports, got %d\n",
                  SNOOP_MASK_SIZE, id);
+
+        cachedLocations.init(
+            std::max(divCeil(int(id), SnoopMask::wordBits), 1));
     }
 
     /**
@@ -133,9 +147,11 @@ class SnoopFilter : public SimObject {
      * @param cpkt          Pointer to the request packet. Not changed.
      * @param slave_port    Slave port where the request came from.
      * @return Pair of a vector of snoop target ports and lookup latency.
+     *         The vector is owned by the snoop filter and is only valid
+     *         until the next call to lookupRequest.
      */
-    std::pair<SnoopList, Cycles> lookupRequest(const Packet* cpkt,
-                                               const SlavePort& slave_port);
+    std::pair<const SnoopList&, Cycles> lookupRequest(
+        const Packet* cpkt, const SlavePort& slave_port);
 
     /**
      * For an un-successful request, revert the change to the snoop
@@ -155,9 +171,10 @@ class SnoopFilter : public SimObject {
      *
      * @param cpkt Pointer to const Packet containing the snoop.
      * @return Pair with a vector of SlavePorts that need snooping and a lookup
-     *         latency.
+     *         latency. The vector is owned by the snoop filter and is only
+     *         valid until the next call to lookupSnoop.
      */
-    std::pair<SnoopList, Cycles> lookupSnoop(const Packet* cpkt);
+    std::pair<const SnoopList&, Cycles> lookupSnoop(const Packet* cpkt);
 
     /**
      * Let the snoop filter see any snoop responses that turn into
@@ -199,42 +216,17 @@ class SnoopFilter : public SimObject {
 
   protected:
 
-    /**
-     * The underlying type for the bitmask we use for tracking. This
-     * limits the number of snooping ports supported per crossbar.
-     */
-    typedef std::bitset<SNOOP_MASK_SIZE> SnoopMask;
-
-    /**
-    * Per cache line item tracking a bitmask of SlavePorts who have an
-    * outstanding request to this line (requested) or already share a
-    * cache line with this address (holder).
-    */
-    struct SnoopItem {
-        SnoopMask requested;
-        SnoopMask holder;
-    };
-    /**
-     * HashMap of SnoopItems indexed by line address
-     */
-    typedef std::unordered_map<Addr, SnoopItem> SnoopFilterCache;
-
     /**
      * Simple factory methods for standard return values.
      */
-    std::pair<SnoopList, Cycles> snoopAll(Cycles latency) const
-    {
-        return std::make_pair(slavePorts, latency);
-    }
-    std::pair<SnoopList, Cycles> snoopSelected(const SnoopList& slave_ports,
-                                               Cycles latency) const
+    std::pair<const SnoopList&, Cycles>
+    snoopSelected(const SnoopList& slave_ports, Cycles latency) const
     {
-        return std::make_pair(slave_ports, latency);
+        return std::pair<const SnoopList&, Cycles>(slave_ports, latency);
     }
-    std::pair<SnoopList, Cycles> snoopDown(Cycles latency) const
+    std::pair<const SnoopList&, Cycles> snoopDown(Cycles latency) const
     {
-        SnoopList empty;
-        return std::make_pair(empty , latency);
+        return snoopSelected(noPorts, latency);
     }
 
     /**
@@ -246,16 +238,18 @@ class SnoopFilter : public SimObject {
     /**
      * Converts a bitmask of ports into the corresponing list of ports
      * @param ports SnoopMask of the requested ports
-     * @return SnoopList containing all the requested SlavePorts
+     * @param res SnoopList that gets all the requested SlavePorts
+     * @return res
      */
-    SnoopList maskToPortList(SnoopMask ports) const;
+    const SnoopList &maskToPortList(const SnoopMask &ports,
+                                    SnoopList &res) const;
 
   private:
 
     /**
      * Removes snoop filter items which have no requesters and no holders.
      */
-    void eraseIfNullEntry(SnoopFilterCache::iterator& sf_it);
+    void eraseIfNullEntry(size_t slot, const SnoopItem& sf_item);
 
     /** Simple hash set of cached addresses. */
     SnoopFilterCache cachedLocations;
@@ -267,8 +261,13 @@ class SnoopFilter : public SimObject {
      * This structure keeps track of the state previous to such changes.
      */
     struct ReqLookupResult {
-        /** Iterator used to store the result from lookupRequest. */
-        SnoopFilterCache::iterator it;
+        /**
+         * Line of the lookupRequest result, the table slot may change
+         * before finishRequest, e.g., due to snoops from below.
+         */
+        Addr lineAddr;
+        /** Whether lookupRequest has an entry for finishRequest */
+        bool valid;
 
         /**
          * Variable to temporarily store value of snoopfilter entry
@@ -277,19 +276,19 @@ class SnoopFilter : public SimObject {
          */
         SnoopItem retryItem;
 
-        /**
-         * The constructor must be informed of the internal cache's end
-         * iterator, so do not allow the compiler to implictly define it.
-         *
-         * @param end_it Iterator to the end of the internal cache.
-         */
-        ReqLookupResult(SnoopFilterCache::iterator end_it)
-            : it(end_it), retryItem{0, 0}
-        {
-        }
-        ReqLookupResult() = delete;
+        ReqLookupResult() : lineAddr(0), valid(false) {}
     } reqLookupResult;
 
+    /**
+     * Ports to snoop returned by lookupRequest and lookupSnoop. The
+     * two are separate so that snoops arriving while the crossbar
+     * forwards a request don't change its list.
+     */
+    SnoopList reqSnoopPorts;
+    SnoopList snoopSnoopPorts;
+    /** Empty list for the requests that are not snooped */
+    const SnoopList noPorts;
+
     /** List of all attached snooping slave ports. */
     SnoopList slavePorts;
     /** Track the mapping from port ids to the local mask ids. */
@@ -319,22 +318,27 @@ class SnoopFilter : public SimObject {
     Stats::Scalar hitMultiSnoops;
 };
 
-inline SnoopFilter::SnoopMask
+inline SnoopMask
 SnoopFilter::portToMask(const SlavePort& port) const
 {
     assert(port.getId() != InvalidPortID);
     // if this is not a snooping port, return a zero mask
-    return !port.isSnooping() ? 0 :
-        ((SnoopMask)1) << localSlavePortIds[port.getId()];
+    return !port.isSnooping() ? SnoopMask() :
+        SnoopMask::bit(localSlavePortIds[port.getId()]);
 }
 
-inline SnoopFilter::SnoopList
-SnoopFilter::maskToPortList(SnoopMask port_mask) const
+inline const SnoopFilter::SnoopList &
+SnoopFilter::maskToPortList(const SnoopMask &port_mask, SnoopList &res) const
 {
-    SnoopList res;
-    for (const auto& p : slavePorts)
-        if ((port_mask & portToMask(*p)).any())
-            res.push_back(p);
+    // the local ids of the ports are their indices in slavePorts, so
+    // this keeps the order of slavePorts
+    res.clear();
+    for (int i = 0; i < SnoopMask::numWords; ++i) {
+        for (uint64_t word = port_mask.word(i); word; word &= word - 1) {
+            res.push_back(
+                slavePorts[i * SnoopMask::wordBits + findLsbSet(word)]);
+        }
+    }
     return res;
 }
 
@@ -0,0 +1,130 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/snoop_filter_cache.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+
+const int SnoopMask::wordBits;
+const int SnoopMask::numWords;
+const size_t SnoopFilterCache::invalidSlot;
+const Addr SnoopFilterCache::freeAddr;
+
+void
+SnoopMask::print(std::ostream &os) const
+{
+    int top = numWords - 1;
+    while (top > 0 && !words[top])
+        --top;
+
+    const auto flags = os.flags();
+    const auto fill = os.fill('0');
+    os << std::hex << std::noshowbase << words[top];
+    for (int i = top - 1; i >= 0; --i)
+        os << std::setw(16) << words[i];
+    os.fill(fill);
+    os.flags(flags);
+}
+
+SnoopFilterCache::SnoopFilterCache()
+{
+    init(1);
+}
+
+void
+SnoopFilterCache::init(int mask_words)
+{
+    assert(mask_words > 0 && mask_words <= SnoopMask::numWords);
+    maskWords = mask_words;
+    slots.clear();
+    lines.clear();
+    masks.clear();
+    freeSlots.clear();
+}
+
+size_t
+SnoopFilterCache::find(Addr line_addr) const
+{
+    const uint32_t *slot = slots.find(line_addr);
+    return slot ? *slot : invalidSlot;
+}
+
+size_t
+SnoopFilterCache::insert(Addr line_addr)
+{
+    assert(line_addr != freeAddr);
+    assert(find(line_addr) == invalidSlot);
+
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        lines[slot] = line_addr;
+        std::fill_n(masks.begin() + slot * 2 * maskWords, 2 * maskWords, 0);
+    } else {
+        assert(lines.size() < UINT32_MAX);
+        slot = lines.size();
+        lines.push_back(line_addr);
+        masks.resize(masks.size() + 2 * maskWords, 0);
+    }
+
+    slots[line_addr] = slot;
+    return slot;
+}
+
+void
+SnoopFilterCache::erase(size_t slot)
+{
+    assert(lines[slot] != freeAddr);
+    slots.erase(lines[slot]);
+    lines[slot] = freeAddr;
+    freeSlots.push_back(slot);
+}
+
+SnoopItem
+SnoopFilterCache::get(size_t slot) const
+{
+    assert(lines[slot] != freeAddr);
+    const uint64_t *words = &masks[slot * 2 * maskWords];
+    SnoopItem item;
+    for (int i = 0; i < maskWords; ++i) {
+        item.requested.word(i) = words[i];
+        item.holder.word(i) = words[maskWords + i];
+    }
+    return item;
+}
+
+void
+SnoopFilterCache::set(size_t slot, const SnoopItem &item)
+{
+    assert(lines[slot] != freeAddr);
+    uint64_t *words = &masks[slot * 2 * maskWords];
+    for (int i = 0; i < maskWords; ++i) {
+        words[i] = item.requested.word(i);
+        words[maskWords + i] = item.holder.word(i);
+    }
+}
@@ -0,0 +1,201 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Storage of the lines tracked by a snoop filter.
+ */
+
+#ifndef __MEM_SNOOP_FILTER_CACHE_HH__
+#define __MEM_SNOOP_FILTER_CACHE_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/flat_hash_map.hh"
+#include "base/types.hh"
+
+/**
+ * The underlying type for the bitmask a SnoopFilter uses for tracking.
+ * This limits the number of snooping ports supported per crossbar.
+ */
+class SnoopMask
+{
+  public:
+    static const int wordBits = 64;
+    // Change for systems with more than 256 ports tracked by a filter
+    static const int numWords = 256 / wordBits;
+
+    SnoopMask() : words{} {}
+
+    /** One-hot mask of a port */
+    static SnoopMask
+    bit(int index)
+    {
+        SnoopMask mask;
+        mask.words[index / wordBits] = uint64_t(1) << (index % wordBits);
+        return mask;
+    }
+
+    uint64_t word(int i) const { return words[i]; }
+    uint64_t &word(int i) { return words[i]; }
+
+    bool
+    any() const
+    {
+        uint64_t all = 0;
+        for (int i = 0; i < numWords; ++i)
+            all |= words[i];
+        return all != 0;
+    }
+
+    bool none() const { return !any(); }
+
+    int
+    count() const
+    {
+        int bits = 0;
+        for (int i = 0; i < numWords; ++i)
+            bits += popCount(words[i]);
+        return bits;
+    }
+
+    void
+    reset()
+    {
+        for (int i = 0; i < numWords; ++i)
+            words[i] = 0;
+    }
+
+    SnoopMask &
+    operator|=(const SnoopMask &other)
+    {
+        for (int i = 0; i < numWords; ++i)
+            words[i] |= other.words[i];
+        return *this;
+    }
+
+    SnoopMask &
+    operator&=(const SnoopMask &other)
+    {
+        for (int i = 0; i < numWords; ++i)
+            words[i] &= other.words[i];
+        return *this;
+    }
+
+    SnoopMask
+    operator~() const
+    {
+        SnoopMask mask;
+        for (int i = 0; i < numWords; ++i)
+            mask.words[i] = ~words[i];
+        return mask;
+    }
+
+    SnoopMask
+    operator|(const SnoopMask &other) const
+    {
+        SnoopMask mask(*this);
+        return mask |= other;
+    }
+
+    SnoopMask
+    operator&(const SnoopMask &other) const
+    {
+        SnoopMask mask(*this);
+        return mask &= other;
+    }
+
+    /** Print the mask in hex, for the debug output */
+    void print(std::ostream &os) const;
+
+    friend std::ostream &
+    operator<<(std::ostream &os, const SnoopMask &mask)
+    {
+        mask.print(os);
+        return os;
+    }
+
+  private:
+    uint64_t words[numWords];
+};
+
+/**
+* Per cache line item tracking a bitmask of SlavePorts who have an
+* outstanding request to this line (requested) or already share a
+* cache line with this address (holder).
+*/
+struct SnoopItem {
+    SnoopMask requested;
+    SnoopMask holder;
+};
+
+/**
+ * Table of SnoopItems indexed by line address. The masks of the items
+ * are kept in slots of one array, and only keep the words that can have
+ * ports in them. A hash map from the line addresses to their slots
+ * finds them. The items are copied in and out of the table, and the
+ * slot of a line stays the same until the line is erased.
+ */
+class SnoopFilterCache
+{
+  public:
+    /** Slot returned by find() if the line isn't in the table */
+    static const size_t invalidSlot = (size_t)-1;
+
+    SnoopFilterCache();
+
+    /** Set the number of words kept for each mask, and clear. */
+    void init(int mask_words);
+
+    size_t size() const { return slots.size(); }
+
+    size_t find(Addr line_addr) const;
+    /** Insert an empty item for a line that isn't in the table */
+    size_t insert(Addr line_addr);
+    void erase(size_t slot);
+
+    SnoopItem get(size_t slot) const;
+    void set(size_t slot, const SnoopItem &item);
+
+  private:
+    /** Line address marking a free slot, never a valid line */
+    static const Addr freeAddr = MaxAddr;
+
+    /** Slot of each line, 32 bits keep the entries of the map small */
+    FlatHashMap<Addr, uint32_t> slots;
+    /** Line of each slot */
+    std::vector<Addr> lines;
+    /** requested and holder words of each slot, in that order */
+    std::vector<uint64_t> masks;
+    /** Slots of erased lines, reused first */
+    std::vector<uint32_t> freeSlots;
+    int maskWords;
+};
+
+#endif // __MEM_SNOOP_FILTER_CACHE_HH__
@@ -0,0 +1,181 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "mem/snoop_filter_cache.hh"
+
+namespace
+{
+
+/** An item with the given port in both masks */
+SnoopItem
+item(int port)
+{
+    SnoopItem sf_item;
+    sf_item.requested = SnoopMask::bit(port);
+    sf_item.holder = SnoopMask::bit(port);
+    return sf_item;
+}
+
+bool
+operator==(const SnoopMask &a, const SnoopMask &b)
+{
+    for (int i = 0; i < SnoopMask::numWords; ++i) {
+        if (a.word(i) != b.word(i))
+            return false;
+    }
+    return true;
+}
+
+bool
+operator==(const SnoopItem &a, const SnoopItem &b)
+{
+    return a.requested == b.requested && a.holder == b.holder;
+}
+
+} // anonymous namespace
+
+TEST(SnoopFilterCacheTest, InsertFindErase)
+{
+    SnoopFilterCache cache;
+    EXPECT_EQ(0, cache.size());
+    EXPECT_EQ(SnoopFilterCache::invalidSlot, cache.find(0x40));
+
+    // New items are empty
+    size_t slot = cache.insert(0x40);
+    EXPECT_EQ(slot, cache.find(0x40));
+    EXPECT_EQ(1, cache.size());
+    EXPECT_TRUE(cache.get(slot).requested.none());
+    EXPECT_TRUE(cache.get(slot).holder.none());
+
+    cache.set(slot, item(3));
+    EXPECT_TRUE(cache.get(cache.find(0x40)) == item(3));
+
+    cache.erase(cache.find(0x40));
+    EXPECT_EQ(0, cache.size());
+    EXPECT_EQ(SnoopFilterCache::invalidSlot, cache.find(0x40));
+}
+
+TEST(SnoopFilterCacheTest, MaskWords)
+{
+    SnoopFilterCache cache;
+    cache.init(2);
+
+    // The two words kept for each mask are stored, the others are not
+    SnoopItem sf_item;
+    sf_item.requested = SnoopMask::bit(0) | SnoopMask::bit(127);
+    sf_item.holder = SnoopMask::bit(64) | SnoopMask::bit(200);
+    cache.set(cache.insert(0x40), sf_item);
+
+    SnoopItem stored = cache.get(cache.find(0x40));
+    EXPECT_TRUE(stored.requested == sf_item.requested);
+    EXPECT_TRUE(stored.holder == SnoopMask::bit(64));
+
+    // init() empties the table
+    cache.init(1);
+    EXPECT_EQ(0, cache.size());
+    EXPECT_EQ(SnoopFilterCache::invalidSlot, cache.find(0x40));
+}
+
+TEST(SnoopFilterCacheTest, SlotsStayUntilErased)
+{
+    SnoopFilterCache cache;
+    cache.init(4);
+
+    std::vector<Addr> lines;
+    std::vector<size_t> slots;
+    for (size_t i = 0; i < 1000; ++i) {
+        lines.push_back(i * 64);
+        slots.push_back(cache.insert(lines[i]));
+        cache.set(slots[i], item(i % 256));
+    }
+
+    // Erase every other line, the others keep their slots and items
+    std::set<size_t> erased;
+    for (size_t i = 0; i < lines.size(); i += 2) {
+        cache.erase(cache.find(lines[i]));
+        erased.insert(slots[i]);
+    }
+    EXPECT_EQ(lines.size() / 2, cache.size());
+    for (size_t i = 1; i < lines.size(); i += 2) {
+        EXPECT_EQ(slots[i], cache.find(lines[i]));
+        EXPECT_TRUE(cache.get(slots[i]) == item(i % 256));
+    }
+
+    // New lines reuse the slots of the erased ones, with empty items
+    const size_t slot = cache.insert(0x100000);
+    EXPECT_EQ(1, erased.count(slot));
+    EXPECT_TRUE(cache.get(slot).requested.none());
+    EXPECT_TRUE(cache.get(slot).holder.none());
+}
+
+TEST(SnoopFilterCacheTest, Random)
+{
+    SnoopFilterCache cache;
+    cache.init(SnoopMask::numWords);
+    std::map<Addr, int> expected;
+    std::mt19937 rng(1);
+
+    // Few lines, so that lines are erased and inserted again, and their
+    // slots reused
+    const Addr num_lines = 700;
+    for (int step = 0; step < 100000; ++step) {
+        const Addr line_addr = (rng() % num_lines) * 64;
+        const size_t slot = cache.find(line_addr);
+        auto it = expected.find(line_addr);
+        if (it == expected.end()) {
+            ASSERT_EQ(SnoopFilterCache::invalidSlot, slot);
+            const int port = rng() % 256;
+            cache.set(cache.insert(line_addr), item(port));
+            expected[line_addr] = port;
+        } else {
+            ASSERT_NE(SnoopFilterCache::invalidSlot, slot);
+            ASSERT_TRUE(cache.get(slot) == item(it->second));
+            cache.erase(slot);
+            expected.erase(it);
+        }
+        ASSERT_EQ(expected.size(), cache.size());
+    }
+
+    for (const auto &line : expected) {
+        const size_t slot = cache.find(line.first);
+        ASSERT_NE(SnoopFilterCache::invalidSlot, slot);
+        EXPECT_TRUE(cache.get(slot) == item(line.second));
+    }
+}
+
+TEST(SnoopFilterCacheTest, PrintMask)
+{
+    std::ostringstream os;
+    os << (SnoopMask::bit(0) | SnoopMask::bit(65));
+    EXPECT_EQ("20000000000000001", os.str());
+}
@@ -82,7 +82,7 @@ TranslatingPortProxy::tryReadBlob(Addr addr, void *p, int size) const
     for (ChunkGenerator gen(addr, size, pageBytes); !gen.done();
          gen.next())
     {
-        auto req = std::make_shared<Request>(
+        auto req = Request::create(
                 gen.addr(), gen.size(), flags, Request::funcMasterId, 0,
                 _tc->contextId());
 
@@ -104,7 +104,7 @@ TranslatingPortProxy::tryWriteBlob(
     for (ChunkGenerator gen(addr, size, pageBytes); !gen.done();
          gen.next())
     {
-        auto req = std::make_shared<Request>(
+        auto req = Request::create(
                 gen.addr(), gen.size(), flags, Request::funcMasterId, 0,
                 _tc->contextId());
 
@@ -124,7 +124,7 @@ TranslatingPortProxy::tryMemsetBlob(Addr address, uint8_t v, int size) const
     for (ChunkGenerator gen(address, size, pageBytes); !gen.done();
          gen.next())
     {
-        auto req = std::make_shared<Request>(
+        auto req = Request::create(
                 gen.addr(), gen.size(), flags, Request::funcMasterId, 0,
                 _tc->contextId());
 
@@ -79,6 +79,37 @@ BaseXBar::~BaseXBar()
         delete s;
 }
 
+void
+BaseXBar::init()
+{
+    ClockedObject::init();
+
+    // Packets are passed on with the crossbar latency folded into
+    // their header delay, so any neighbour on another event queue
+    // sees them at least this far in the future.
+    const Tick latency = clockPeriod() * minForwardLatency();
+    for (const auto& p: masterPorts) {
+        if (p->isConnected()) {
+            declareLinkLatency(p->name(), eventQueue(),
+                               p->getPeerOwner().eventQueue(), latency);
+        }
+    }
+    for (const auto& p: slavePorts) {
+        if (p->isConnected()) {
+            declareLinkLatency(p->name(), eventQueue(),
+                               p->getPeerOwner().eventQueue(), latency);
+        }
+    }
+}
+
+Cycles
+BaseXBar::minForwardLatency() const
+{
+    // Requests pay the front-end latency on top of the forward
+    // latency, snoops only pay the latter.
+    return std::min(forwardLatency, responseLatency);
+}
+
 Port &
 BaseXBar::getPort(const std::string &if_name, PortID idx)
 {
@@ -310,7 +310,7 @@ class BaseXBar : public ClockedObject
     /** the width of the xbar in bytes */
     const uint32_t width;
 
-    AddrRangeMap<PortID, 3> portMap;
+    AddrRangeMap<PortID> portMap;
 
     /**
      * Remember where request packets came from so that we can route
@@ -384,6 +384,12 @@ class BaseXBar : public ClockedObject
 
     BaseXBar(const BaseXBarParams *p);
 
+    /**
+     * Smallest latency, in cycles, that the crossbar adds to anything
+     * it forwards between its neighbours.
+     */
+    virtual Cycles minForwardLatency() const;
+
     /**
      * Stats for transaction distribution and data passing through the
      * crossbar. The transaction distribution is globally counting
@@ -401,6 +407,8 @@ class BaseXBar : public ClockedObject
 
     virtual ~BaseXBar();
 
+    void init() override;
+
     /** A function used to return the port associated with this object. */
     Port &getPort(const std::string &if_name,
                   PortID idx=InvalidPortID) override;
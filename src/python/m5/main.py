@@ -110,6 +110,10 @@ def parse_options():
         help="Reduce verbosity")
     option('-v', "--verbose", action="count", default=0,
         help="Increase verbosity")
+    option("--event-queue", metavar="{list,calendar}",
+        choices=("list", "calendar"), default="list",
+        help="Data structure used to store pending events " \
+        "[Default: %default]")
 
     # Statistics options
     group("Statistics Options")
@@ -146,6 +150,9 @@ def parse_options():
         help="End debug output at TICK")
     option("--debug-file", metavar="FILE", default="cout",
         help="Sets the output file for debug [Default: %default]")
+    option("--debug-binary", action='store_true', default=False,
+        help="Write debug output in a binary format that is faster to " \
+             "write, decode it with util/decode_trace.py")
     option("--debug-ignore", metavar="EXPR", action='append', split=':',
         help="Ignore EXPR sim objects")
     option("--remote-gdb-port", type='int', default=7000,
@@ -236,7 +243,9 @@ def main(*args):
 
     m5.options = options
 
-    # Set the main event queue for the main thread.
+    # Set the main event queue for the main thread. The event queue
+    # implementation needs to be selected before any queue is created.
+    event.setEventQueueImpl(options.event_queue)
     event.mainq = event.getEventQueue(0)
     event.setEventQueue(event.mainq)
 
@@ -419,7 +428,13 @@ def main(*args):
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    if options.debug_binary:
+        _check_tracing()
+        if options.debug_file in ("cout", "cerr"):
+            fatal("--debug-binary needs an output file (--debug-file)")
+        trace.outputBinary(options.debug_file)
+    else:
+        trace.output(options.debug_file)
 
     for ignore in options.debug_ignore:
         _check_tracing()
@@ -184,6 +184,30 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
 
     return _m5.stats.initHDF5(fn, chunking, desc, formulas)
 
+@_url_factory([ "col", ])
+def _columnarFactory(fn, desc=True):
+    """Output stats as binary columns.
+
+    Columnar stat files store the names of the stats once and every
+    dump as a row of doubles, which makes frequent dumps of large
+    systems much cheaper than with the text format. The files are
+    compressed if their name ends in .gz. Use util/stats_columnar.py
+    to read them, e.g., into a pandas DataFrame.
+
+    Known limitations:
+      * Sparse histograms are unsupported.
+      * Stats are always output, nozero and prerequisites are ignored.
+
+    Parameters:
+      * desc (bool): Output stat descriptions (default: True)
+
+    Example:
+      col://stats.col.gz?desc=False
+
+    """
+
+    return _m5.stats.initColumnar(fn, desc)
+
 def addStatVisitor(url):
     """Add a stat visitor specified using a URL string
 
@@ -383,6 +407,10 @@ def dump(root=None):
 def reset():
     '''Reset all statistics to the base state'''
 
+    # clear the storage of all the stats that reset to zero in one go,
+    # resetStats() only has to reset the rest
+    _m5.stats.beginReset()
+
     # call reset stats on all SimObjects
     root = Root.getInstance()
     if root:
@@ -392,6 +420,8 @@ def reset():
     for stat in stats_list:
         stat.reset()
 
+    _m5.stats.endReset()
+
     _m5.stats.processResetQueue()
 
 flags = attrdict({
@@ -45,9 +45,12 @@
 #include <map>
 #include <vector>
 
+#include "base/binary_logger.hh"
+#include "base/callback.hh"
 #include "base/debug.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
+#include "sim/core.hh"
 #include "sim/debug.hh"
 
 namespace py = pybind11;
@@ -67,6 +70,24 @@ output(const char *filename)
     Trace::setDebugLogger(new Trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+outputBinary(const char *filename)
+{
+    OutputStream *file_stream = simout.find(filename);
+
+    if (!file_stream)
+        file_stream = simout.create(filename, true);
+
+    auto *logger = new Trace::BinaryLogger(*file_stream->stream());
+
+    // Loggers are never deleted, make sure the records still in the
+    // buffer get written out.
+    registerExitCallback(new MakeCallback<Trace::BinaryLogger,
+                         &Trace::BinaryLogger::close>(logger, true));
+
+    Trace::setDebugLogger(logger);
+}
+
 static void
 ignore(const char *expr)
 {
@@ -109,6 +130,7 @@ pybind_init_debug(py::module &m_native)
     py::module m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("outputBinary", &outputBinary)
         .def("ignore", &ignore)
         .def("enable", &Trace::enable)
         .def("disable", &Trace::disable)
@@ -44,6 +44,7 @@
 #include "pybind11/stl.h"
 
 #include "base/statistics.hh"
+#include "base/stats/columnar.hh"
 #include "base/stats/text.hh"
 #if USE_HDF5
 #include "base/stats/hdf5.hh"
@@ -83,12 +84,15 @@ pybind_init_stats(py::module &m_native)
 #if USE_HDF5
         .def("initHDF5", &Stats::initHDF5)
 #endif
+        .def("initColumnar", &Stats::initColumnar)
         .def("registerPythonStatsHandlers",
              &Stats::registerPythonStatsHandlers)
         .def("schedStatEvent", &Stats::schedStatEvent)
         .def("periodicStatDump", &Stats::periodicStatDump)
         .def("updateEvents", &Stats::updateEvents)
         .def("processResetQueue", &Stats::processResetQueue)
+        .def("beginReset", &Stats::Arena::beginReset)
+        .def("endReset", &Stats::Arena::endReset)
         .def("processDumpQueue", &Stats::processDumpQueue)
         .def("enable", &Stats::enable)
         .def("enabled", &Stats::enabled)
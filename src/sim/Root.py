@@ -63,8 +63,12 @@ class Root(SimObject):
     eventq_index = 0
 
     # Simulation Quantum for multiple main event queue simulation.
-    # Needs to be set explicitly for a multi-eventq simulation.
-    sim_quantum = Param.Tick(0, "simulation quantum")
+    # If left at 0 for a multi-eventq simulation, the quantum is set to
+    # the smallest latency declared by a link crossing event queues.
+    sim_quantum = Param.Tick(0, "simulation quantum (0 derives it from "
+                             "the cross-queue link latencies)")
+    pin_event_queues = Param.Bool(False, "pin the thread of each main "
+                                  "event queue to its own host core")
 
     full_system = Param.Bool("if this is a full system simulation")
 
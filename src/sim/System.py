@@ -73,6 +73,23 @@ class System(SimObject):
     mmap_using_noreserve = Param.Bool(False, "mmap the backing store " \
                                           "without reserving swap")
 
+    # Uncompressed memory checkpoints are mapped copy-on-write in
+    # place of the backing store when restoring them, which makes
+    # restoring them nearly free and lets simulations started from the
+    # same checkpoint share it in the host page cache. They are always
+    # full checkpoints.
+    uncompressed_checkpoints = Param.Bool(False, "write memory " \
+                                          "checkpoints that can be mmapped")
+
+    # Checkpoints of the backing store can be restricted to the pages
+    # written since the previous checkpoint, which then has to be kept
+    # around as the base of the new one. After the given number of
+    # such incremental checkpoints a full checkpoint is written again.
+    checkpoint_chain_length = Param.Unsigned(0, "incremental memory " \
+                                             "checkpoints between full ones")
+    checkpoint_compression_threads = Param.Unsigned(0, "threads " \
+        "compressing memory checkpoints (0 uses all host cores)")
+
     # The memory ranges are to be populated when creating the system
     # such that these can be passed from the I/O subsystem through an
     # I/O bridge or cache
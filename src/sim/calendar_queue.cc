@@ -0,0 +1,244 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/calendar_queue.hh"
+
+#include <algorithm>
+
+#include "base/cprintf.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "sim/eventq.hh"
+
+namespace
+{
+
+/** Number of early bins used to estimate the bucket width. */
+const size_t WidthSamples = 25;
+
+bool
+binLess(const Event *l, const Event *r)
+{
+    return *l < *r;
+}
+
+} // anonymous namespace
+
+CalendarQueue::CalendarQueue()
+    : buckets(MinBuckets, nullptr), bucketMask(MinBuckets - 1),
+      widthShift(10), numBins(0), curSlot(0)
+{
+}
+
+Tick
+CalendarQueue::slot(const Event *bin) const
+{
+    return bin->when() >> widthShift;
+}
+
+void
+CalendarQueue::link(Event *bin)
+{
+    Tick bin_slot = slot(bin);
+    if (bin_slot < curSlot)
+        curSlot = bin_slot;
+
+    Event **pos = &buckets[bin_slot & bucketMask];
+    while (*pos && **pos < *bin)
+        pos = &(*pos)->nextBin;
+
+    bin->nextBin = *pos;
+    *pos = bin;
+}
+
+void
+CalendarQueue::resize(size_t num_buckets)
+{
+    assert(isPowerOf2(num_buckets));
+
+    std::vector<Event *> bins;
+    bins.reserve(numBins);
+    getBins(bins);
+
+    // Estimate the bucket width from the average separation of the
+    // earliest bins, ignoring separations more than twice the average
+    // as Brown suggests. Each bucket then covers a few of them.
+    const size_t samples = std::min(bins.size(), WidthSamples);
+    if (samples > 1) {
+        std::partial_sort(bins.begin(), bins.begin() + samples, bins.end(),
+                          binLess);
+
+        const Tick avg = (bins[samples - 1]->when() - bins[0]->when()) /
+            (samples - 1);
+        Tick total = 0;
+        Tick count = 0;
+        for (size_t i = 1; i < samples; ++i) {
+            const Tick sep = bins[i]->when() - bins[i - 1]->when();
+            if (sep <= 2 * avg) {
+                total += sep;
+                ++count;
+            }
+        }
+
+        const Tick width = count ? total / count : avg;
+        widthShift = std::min(ceilLog2(std::max<Tick>(width, 1)) + 2, 63);
+    }
+
+    buckets.assign(num_buckets, nullptr);
+    bucketMask = num_buckets - 1;
+
+    if (!bins.empty()) {
+        curSlot = MaxTick;
+        for (auto bin : bins)
+            link(bin);
+    }
+}
+
+void
+CalendarQueue::insert(Event *event)
+{
+    Tick event_slot = slot(event);
+    if (event_slot < curSlot)
+        curSlot = event_slot;
+
+    Event **pos = &buckets[event_slot & bucketMask];
+    while (*pos && **pos < *event)
+        pos = &(*pos)->nextBin;
+
+    const bool new_bin = !*pos || *event < **pos;
+    *pos = Event::insertBefore(event, *pos);
+
+    if (new_bin && ++numBins > 2 * buckets.size())
+        resize(2 * buckets.size());
+}
+
+void
+CalendarQueue::insertBin(Event *bin)
+{
+    link(bin);
+
+    if (++numBins > 2 * buckets.size())
+        resize(2 * buckets.size());
+}
+
+void
+CalendarQueue::remove(Event *event)
+{
+    Event **pos = &buckets[slot(event) & bucketMask];
+    while (*pos && **pos < *event)
+        pos = &(*pos)->nextBin;
+
+    if (!*pos || **pos != *event)
+        panic("event not found!");
+
+    const bool last_in_bin = *pos == event && !event->nextInBin;
+    *pos = Event::removeItem(event, *pos);
+
+    if (last_in_bin && --numBins < buckets.size() / 2 &&
+        buckets.size() > MinBuckets) {
+        resize(buckets.size() / 2);
+    }
+}
+
+Event *
+CalendarQueue::removeFirst()
+{
+    if (!numBins)
+        return nullptr;
+
+    // Walk one year of buckets looking for a bin that falls in the
+    // slot of the bucket being visited.
+    Event *bin = nullptr;
+    for (size_t i = 0; i < buckets.size(); ++i, ++curSlot) {
+        Event *top = buckets[curSlot & bucketMask];
+        if (top && slot(top) == curSlot) {
+            bin = top;
+            break;
+        }
+    }
+
+    // The pending bins are sparse compared to the bucket width, fall
+    // back to a direct search for the earliest bucket head.
+    if (!bin) {
+        for (auto top : buckets) {
+            if (top && (!bin || *top < *bin))
+                bin = top;
+        }
+        curSlot = slot(bin);
+    }
+
+    buckets[curSlot & bucketMask] = bin->nextBin;
+    bin->nextBin = nullptr;
+
+    if (--numBins < buckets.size() / 2 && buckets.size() > MinBuckets)
+        resize(buckets.size() / 2);
+
+    return bin;
+}
+
+void
+CalendarQueue::getBins(std::vector<Event *> &bins) const
+{
+    for (auto top : buckets) {
+        for (Event *bin = top; bin; bin = bin->nextBin)
+            bins.push_back(bin);
+    }
+}
+
+bool
+CalendarQueue::debugVerify() const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        for (Event *bin = buckets[i]; bin; bin = bin->nextBin) {
+            if ((slot(bin) & bucketMask) != i) {
+                cprintf("bin in wrong bucket!");
+                bin->dump();
+                return false;
+            }
+
+            if (slot(bin) < curSlot) {
+                cprintf("bin before calendar position!");
+                bin->dump();
+                return false;
+            }
+
+            if (bin->nextBin && !(*bin < *bin->nextBin)) {
+                cprintf("bucket out of order!");
+                bin->dump();
+                return false;
+            }
+
+            ++count;
+        }
+    }
+
+    if (count != numBins) {
+        cprintf("calendar holds %d bins, expected %d!", count, numBins);
+        return false;
+    }
+
+    return true;
+}
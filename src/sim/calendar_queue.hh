@@ -0,0 +1,123 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Calendar queue storage for EventQueue
+ */
+
+#ifndef __SIM_CALENDAR_QUEUE_HH__
+#define __SIM_CALENDAR_QUEUE_HH__
+
+#include <vector>
+
+#include "base/types.hh"
+
+class Event;
+
+/**
+ * A calendar queue (R. Brown, CACM 1988) of event bins.
+ *
+ * The queue stores the same bins as the linked list used by
+ * EventQueue, i.e., a stack of events sharing the same when() and
+ * priority() linked through Event::nextInBin, with the top of the
+ * stack representing the whole bin. Instead of keeping one sorted list
+ * of bins, bins are hashed into buckets by time. Each bucket covers
+ * 'width' ticks of a 'year' and holds a short sorted list of bins
+ * linked through Event::nextBin. Finding the earliest bin walks the
+ * buckets in time order starting from the bucket of the last bin
+ * removed, which makes insertion and removal O(1) amortized as long as
+ * the bucket width matches the distribution of pending events. The
+ * number of buckets and their width are re-tuned whenever the number
+ * of bins crosses a power of two.
+ *
+ * Event ordering, including the LIFO order within a bin, is identical
+ * to the list-based queue, so switching between the two does not
+ * change simulation results.
+ */
+class CalendarQueue
+{
+  private:
+    /** Bucket array, always a power of two in size. */
+    std::vector<Event *> buckets;
+    /** buckets.size() - 1 */
+    uint64_t bucketMask;
+    /** log2 of the number of ticks covered by one bucket. */
+    unsigned widthShift;
+    /** Number of bins currently stored. */
+    size_t numBins;
+    /**
+     * Time slot (when() >> widthShift) of the bucket the next search
+     * starts from. No stored bin has a smaller slot.
+     */
+    Tick curSlot;
+
+    static const size_t MinBuckets = 16;
+
+    Tick slot(const Event *bin) const;
+
+    /** Link a bin into its bucket without touching the queue size. */
+    void link(Event *bin);
+
+    /** Rebuild the calendar with a new number of buckets. */
+    void resize(size_t num_buckets);
+
+  public:
+    CalendarQueue();
+
+    /** Returns true if no bins are stored. */
+    bool empty() const { return numBins == 0; }
+
+    /** Number of bins stored. */
+    size_t size() const { return numBins; }
+
+    /**
+     * Insert an event, either as a new bin or on top of the stack of
+     * an existing bin with the same time and priority.
+     */
+    void insert(Event *event);
+
+    /**
+     * Insert a complete bin. The bin must not be equal to any bin
+     * already stored.
+     */
+    void insertBin(Event *bin);
+
+    /** Remove an event stored in one of the bins. */
+    void remove(Event *event);
+
+    /**
+     * Remove the earliest bin and return its top event, or nullptr if
+     * the queue is empty.
+     */
+    Event *removeFirst();
+
+    /** Append the top event of every stored bin to 'bins'. */
+    void getBins(std::vector<Event *> &bins) const;
+
+    /** Check the calendar invariants, printing any violation found. */
+    bool debugVerify() const;
+};
+
+#endif // __SIM_CALENDAR_QUEUE_HH__
@@ -28,6 +28,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <string>
@@ -45,6 +46,37 @@ using namespace std;
 
 Tick simQuantum = 0;
 
+static Tick _linkLookahead = MaxTick;
+static std::string _linkLookaheadLimiter;
+
+void
+declareLinkLatency(const std::string &name, const EventQueue *src,
+                   const EventQueue *dst, Tick latency)
+{
+    if (src && dst && src == dst)
+        return;
+
+    DPRINTFR(Event, "Link %s crosses event queues with latency %d\n",
+             name, latency);
+
+    if (latency < _linkLookahead) {
+        _linkLookahead = latency;
+        _linkLookaheadLimiter = name;
+    }
+}
+
+Tick
+linkLookahead()
+{
+    return _linkLookahead;
+}
+
+const std::string &
+linkLookaheadLimiter()
+{
+    return _linkLookaheadLimiter;
+}
+
 //
 // Main Event Queues
 //
@@ -55,6 +87,18 @@ uint32_t numMainEventQueues = 0;
 vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
+EventQueueImpl eventQueueImpl = EventQueueImpl::List;
+
+void
+setEventQueueImpl(const std::string &name)
+{
+    if (name == "list")
+        eventQueueImpl = EventQueueImpl::List;
+    else if (name == "calendar")
+        eventQueueImpl = EventQueueImpl::Calendar;
+    else
+        fatal("Unknown event queue implementation '%s'.\n", name);
+}
 
 EventQueue *
 getEventQueue(uint32_t index)
@@ -109,6 +153,23 @@ Event::insertBefore(Event *event, Event *curr)
 void
 EventQueue::insert(Event *event)
 {
+    // With a calendar, the head bin is kept out of the calendar so that
+    // the common operations on the earliest bin stay cheap.
+    if (calendar) {
+        if (!head || *event < *head) {
+            if (head)
+                calendar->insertBin(head);
+            event->nextBin = NULL;
+            event->nextInBin = NULL;
+            head = event;
+        } else if (*event == *head) {
+            head = Event::insertBefore(event, head);
+        } else {
+            calendar->insert(event);
+        }
+        return;
+    }
+
     // Deal with the head case
     if (!head || *event <= *head) {
         head = Event::insertBefore(event, head);
@@ -172,6 +233,13 @@ EventQueue::remove(Event *event)
     // time as the head)
     if (*head == *event) {
         head = Event::removeItem(event, head);
+        if (!head && calendar)
+            head = calendar->removeFirst();
+        return;
+    }
+
+    if (calendar) {
+        calendar->remove(event);
         return;
     }
 
@@ -210,6 +278,8 @@ EventQueue::serviceOne()
         // this was the only element on the 'in bin' list, so get rid of
         // the 'in bin' list and point to the next bin list
         head = head->nextBin;
+        if (!head && calendar)
+            head = calendar->removeFirst();
     }
 
     // handle action
@@ -293,15 +363,12 @@ EventQueue::dump() const
     if (empty())
         cprintf("<No Events>\n");
     else {
-        Event *nextBin = head;
-        while (nextBin) {
+        for (Event *nextBin : bins()) {
             Event *nextInBin = nextBin;
             while (nextInBin) {
                 nextInBin->dump();
                 nextInBin = nextInBin->nextInBin;
             }
-
-            nextBin = nextBin->nextBin;
         }
     }
 
@@ -316,8 +383,10 @@ EventQueue::debugVerify() const
     Tick time = 0;
     short priority = 0;
 
-    Event *nextBin = head;
-    while (nextBin) {
+    if (calendar && !calendar->debugVerify())
+        return false;
+
+    for (Event *nextBin : bins()) {
         Event *nextInBin = nextBin;
         while (nextInBin) {
             if (nextInBin->when() < time) {
@@ -343,18 +412,57 @@ EventQueue::debugVerify() const
 
             nextInBin = nextInBin->nextInBin;
         }
-
-        nextBin = nextBin->nextBin;
     }
 
     return true;
 }
 
+std::vector<Event *>
+EventQueue::bins() const
+{
+    std::vector<Event *> bins;
+    if (!head)
+        return bins;
+
+    bins.push_back(head);
+    if (calendar) {
+        calendar->getBins(bins);
+        std::sort(bins.begin() + 1, bins.end(),
+                  [](const Event *l, const Event *r) { return *l < *r; });
+    } else {
+        for (Event *bin = head->nextBin; bin; bin = bin->nextBin)
+            bins.push_back(bin);
+    }
+
+    return bins;
+}
+
 Event*
 EventQueue::replaceHead(Event* s)
 {
     Event* t = head;
     head = s;
+
+    if (calendar) {
+        // Hand out the current bins as a list linked from the old
+        // head, the same as the list implementation does, and move the
+        // bins following the new head into the calendar.
+        Event *tail = t;
+        while (Event *bin = calendar->removeFirst()) {
+            tail->nextBin = bin;
+            tail = bin;
+        }
+
+        Event *bin = head ? head->nextBin : NULL;
+        if (head)
+            head->nextBin = NULL;
+        while (bin) {
+            Event *next = bin->nextBin;
+            calendar->insertBin(bin);
+            bin = next;
+        }
+    }
+
     return t;
 }
 
@@ -420,6 +528,8 @@ Event::dump() const
 EventQueue::EventQueue(const string &n)
     : objName(n), head(NULL), _curTick(0)
 {
+    if (eventQueueImpl == EventQueueImpl::Calendar)
+        calendar.reset(new CalendarQueue());
 }
 
 void
@@ -47,6 +47,7 @@
 #include "base/flags.hh"
 #include "base/types.hh"
 #include "debug/Event.hh"
+#include "sim/calendar_queue.hh"
 #include "sim/serialize.hh"
 
 class EventQueue;       // forward declaration
@@ -59,6 +60,29 @@ class BaseGlobalEvent;
 //! Queue B should be at least simQuantum ticks away in future.
 extern Tick simQuantum;
 
+/**
+ * Declare the minimum latency of a link that may deliver events from
+ * one event queue to another. A simulation quantum that does not
+ * exceed the smallest declared latency is a safe lookahead: anything
+ * sent across a link during one quantum cannot take effect before the
+ * next synchronisation point. Links that know both endpoints pass
+ * their queues so that links within a single queue are ignored; links
+ * that cannot tell pass nullptr and are always taken into account.
+ *
+ * @param name Name of the link, used when reporting the lookahead.
+ * @param src Event queue of the sending side, or nullptr if unknown.
+ * @param dst Event queue of the receiving side, or nullptr if unknown.
+ * @param latency Smallest delay with which the link delivers anything.
+ */
+void declareLinkLatency(const std::string &name, const EventQueue *src,
+                        const EventQueue *dst, Tick latency);
+
+//! Smallest latency declared by a cross-queue link, MaxTick if none.
+Tick linkLookahead();
+
+//! Name of the link that limits the lookahead.
+const std::string &linkLookaheadLimiter();
+
 //! Current number of allocated main event queues.
 extern uint32_t numMainEventQueues;
 
@@ -73,6 +97,19 @@ extern __thread EventQueue *_curEventQueue;
 //! Current mode of execution: parallel / serial
 extern bool inParallelMode;
 
+//! Data structures an event queue can keep its pending events in.
+enum class EventQueueImpl
+{
+    List,       //!< Sorted linked list of bins
+    Calendar,   //!< Calendar queue of bins, see CalendarQueue
+};
+
+//! Implementation used by event queues constructed from now on.
+extern EventQueueImpl eventQueueImpl;
+
+//! Select eventQueueImpl by name ("list" or "calendar").
+void setEventQueueImpl(const std::string &name);
+
 //! Function for returning eventq queue for the provided
 //! index. The function allocates a new queue in case one
 //! does not exist for the index, provided that the index
@@ -244,6 +281,7 @@ class EventBase
  */
 class Event : public EventBase, public Serializable
 {
+    friend class CalendarQueue;
     friend class EventQueue;
 
   private:
@@ -255,7 +293,9 @@ class Event : public EventBase, public Serializable
     // result is that the insert/removal in 'nextBin' is
     // linear/constant, and the lookup/removal in 'nextInBin' is
     // constant/constant.  Hopefully this is a significant improvement
-    // over the current fully linear insertion.
+    // over the current fully linear insertion. When the queue is
+    // backed by a CalendarQueue, 'nextBin' links the bins of a bucket
+    // instead.
     Event *nextBin;
     Event *nextInBin;
 
@@ -617,6 +657,12 @@ class EventQueue
     Event *head;
     Tick _curTick;
 
+    /**
+     * Bins after the head bin when using EventQueueImpl::Calendar,
+     * nullptr when the bins are kept in a list linked from the head.
+     */
+    std::unique_ptr<CalendarQueue> calendar;
+
     //! Mutex to protect async queue.
     std::mutex async_queue_mutex;
 
@@ -832,6 +878,12 @@ class EventQueue
 
     bool debugVerify() const;
 
+    /**
+     * Top events of all pending bins in the order they will be
+     * serviced, starting with the head. Only meant for debugging.
+     */
+    std::vector<Event *> bins() const;
+
     /**
      * Function for moving events from the async_queue to the main queue.
      */
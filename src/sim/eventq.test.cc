@@ -0,0 +1,232 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "sim/eventq_impl.hh"
+
+/*
+ * The calendar queue is expected to service events in exactly the same
+ * order as the list, so every scenario below is run with both
+ * implementations and the orders compared.
+ */
+
+namespace
+{
+
+typedef std::vector<std::pair<Tick, int>> ServiceOrder;
+
+class RecordEvent : public Event
+{
+  public:
+    const int id;
+    ServiceOrder &order;
+    /** Reschedule this event this far ahead when processed, if set */
+    Tick hold;
+
+    RecordEvent(int _id, ServiceOrder &_order, Priority pri = Default_Pri)
+        : Event(pri), id(_id), order(_order), hold(0)
+    {}
+
+    void
+    process() override
+    {
+        order.emplace_back(curTick(), id);
+        if (hold)
+            curEventQueue()->schedule(this, curTick() + hold);
+    }
+};
+
+/** Event queue of a given implementation with a set of events */
+class Queue
+{
+  public:
+    std::unique_ptr<EventQueue> eq;
+    ServiceOrder order;
+    std::vector<std::unique_ptr<RecordEvent>> events;
+
+    Queue(EventQueueImpl impl)
+    {
+        eventQueueImpl = impl;
+        eq.reset(new EventQueue("test"));
+        eventQueueImpl = EventQueueImpl::List;
+        curEventQueue(eq.get());
+    }
+
+    ~Queue()
+    {
+        for (auto &event : events) {
+            if (event->scheduled())
+                eq->deschedule(event.get());
+        }
+    }
+
+    RecordEvent *
+    add(Event::Priority pri = Event::Default_Pri)
+    {
+        events.emplace_back(new RecordEvent(events.size(), order, pri));
+        return events.back().get();
+    }
+
+    void
+    serviceAll()
+    {
+        while (!eq->empty()) {
+            curEventQueue(eq.get());
+            eq->serviceOne();
+        }
+    }
+};
+
+/** Run a scenario with both implementations, return both orders */
+template <class Scenario>
+std::pair<ServiceOrder, ServiceOrder>
+runBoth(Scenario scenario)
+{
+    Queue list(EventQueueImpl::List);
+    scenario(list);
+    EXPECT_TRUE(list.eq->debugVerify());
+    list.serviceAll();
+
+    Queue calendar(EventQueueImpl::Calendar);
+    scenario(calendar);
+    EXPECT_TRUE(calendar.eq->debugVerify());
+    calendar.serviceAll();
+
+    return std::make_pair(list.order, calendar.order);
+}
+
+} // anonymous namespace
+
+TEST(EventQueueTest, SameTickPriorityAndInsertionOrder)
+{
+    auto result = runBoth([](Queue &q) {
+        const Event::Priority pris[] = { Event::Default_Pri,
+            Event::Minimum_Pri, Event::Maximum_Pri, Event::CPU_Tick_Pri };
+        std::mt19937 rng(1);
+        for (int i = 0; i < 64; ++i) {
+            RecordEvent *event = q.add(pris[rng() % 4]);
+            q.eq->schedule(event, 100 + 10 * (rng() % 3));
+        }
+    });
+
+    ASSERT_EQ(64u, result.first.size());
+    EXPECT_EQ(result.first, result.second);
+
+    // Lower priorities first within a tick
+    Queue q(EventQueueImpl::Calendar);
+    RecordEvent *low = q.add(Event::Minimum_Pri);
+    RecordEvent *mid = q.add(Event::Default_Pri);
+    RecordEvent *high = q.add(Event::Maximum_Pri);
+    q.eq->schedule(high, 10);
+    q.eq->schedule(mid, 10);
+    q.eq->schedule(low, 10);
+    q.serviceAll();
+    EXPECT_EQ(ServiceOrder({ {10, 0}, {10, 1}, {10, 2} }), q.order);
+}
+
+TEST(EventQueueTest, DescheduleReschedule)
+{
+    auto result = runBoth([](Queue &q) {
+        std::mt19937 rng(2);
+        for (int i = 0; i < 256; ++i)
+            q.eq->schedule(q.add(int(rng() % 3) - 1), rng() % 1000);
+
+        for (int i = 0; i < 256; i += 3)
+            q.eq->deschedule(q.events[i].get());
+
+        // Reschedule both scheduled and descheduled events, some of
+        // them into bins that already exist
+        for (int i = 0; i < 256; i += 5)
+            q.eq->reschedule(q.events[i].get(), rng() % 2000, true);
+        for (int i = 1; i < 256; i += 7) {
+            RecordEvent *event = q.events[i].get();
+            if (event->scheduled())
+                q.eq->reschedule(event, q.events[i + 1]->when());
+        }
+    });
+
+    EXPECT_FALSE(result.first.empty());
+    EXPECT_EQ(result.first, result.second);
+}
+
+TEST(EventQueueTest, Squash)
+{
+    auto result = runBoth([](Queue &q) {
+        for (int i = 0; i < 100; ++i)
+            q.eq->schedule(q.add(), 10 * (i % 10));
+
+        // Squash whole bins as well as parts of them
+        for (int i = 0; i < 100; ++i) {
+            if (i % 10 == 3 || i % 7 == 0)
+                q.events[i]->squash();
+        }
+    });
+
+    EXPECT_EQ(result.first, result.second);
+    for (const auto &entry : result.second) {
+        EXPECT_NE(3, entry.second % 10);
+        EXPECT_NE(0, entry.second % 7);
+    }
+}
+
+TEST(EventQueueTest, BucketResize)
+{
+    // Grow the calendar through several sizes with both dense and
+    // sparse events, shrink it again and keep it busy in between with
+    // events rescheduling themselves.
+    auto result = runBoth([](Queue &q) {
+        std::mt19937_64 rng(3);
+        for (int i = 0; i < 4096; ++i)
+            q.eq->schedule(q.add(int(rng() % 3) - 1),
+                           rng() % (i < 2048 ? 64 : 1 << 30));
+
+        for (int i = 0; i < 3072; ++i)
+            q.eq->serviceOne();
+
+        for (int i = 0; i < 16; ++i) {
+            RecordEvent *event = q.add();
+            event->hold = 1 + rng() % 100000;
+            q.eq->schedule(event, q.eq->getCurTick() + rng() % 1000);
+        }
+        for (int i = 0; i < 20000; ++i)
+            q.eq->serviceOne();
+
+        for (auto &event : q.events) {
+            event->hold = 0;
+            if (!event->scheduled())
+                q.eq->schedule(event.get(),
+                              q.eq->getCurTick() + rng() % (1 << 20));
+        }
+    });
+
+    EXPECT_LT(4096u + 20000, result.first.size());
+    EXPECT_EQ(result.first, result.second);
+}
@@ -44,6 +44,7 @@
 #include "sim/mathexpr.hh"
 #include "sim/power/thermal_model.hh"
 #include "sim/sim_object.hh"
+#include "sim/stat_control.hh"
 
 MathExprPowerModel::MathExprPowerModel(const Params *p)
     : PowerModelState(p), dyn_expr(p->dyn), st_expr(p->st)
@@ -34,6 +34,7 @@
 #include "sim/eventq_impl.hh"
 #include "sim/full_system.hh"
 #include "sim/root.hh"
+#include "sim/simulate.hh"
 
 Root *Root::_root = NULL;
 
@@ -112,6 +113,7 @@ Root::Root(RootParams *p)
     lastTime.setTimer();
 
     simQuantum = p->sim_quantum;
+    pinEventQueueThreads = p->pin_event_queues;
 }
 
 void
@@ -30,6 +30,8 @@
 
 #include "sim/simulate.hh"
 
+#include <pthread.h>
+
 #include <mutex>
 #include <thread>
 
@@ -49,9 +51,73 @@ std::mutex asyncEventMutex;
 //! simulation loop.
 Barrier *threadBarrier;
 
+bool pinEventQueueThreads = false;
+
 //! forward declaration
 Event *doSimLoop(EventQueue *);
 
+/**
+ * Bind a simulation thread to a single host core. Keeping every event
+ * queue on the same core for the whole run avoids migrations between
+ * quanta, which otherwise dominate the cost of the barrier once the
+ * quantum gets small.
+ */
+static void
+pinThread(std::thread::native_handle_type thread, uint32_t queue)
+{
+#if defined(__linux__)
+    unsigned cores = std::thread::hardware_concurrency();
+    if (cores == 0)
+        cores = 1;
+    if (queue >= cores)
+        warn_once("More event queues than host cores, sharing cores.\n");
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(queue % cores, &set);
+    if (pthread_setaffinity_np(thread, sizeof(set), &set) != 0)
+        warn("Failed to pin event queue %d to host core %d.\n",
+             queue, queue % cores);
+#else
+    warn_once("Pinning event queues to host cores is not supported.\n");
+#endif
+}
+
+/**
+ * Pick the quantum for a multi-queue simulation. An explicit quantum
+ * is used as given, but one larger than the lookahead declared by the
+ * cross-queue links cannot guarantee that events crossing queues are
+ * delivered on time, so warn about it. If no quantum is given, the
+ * lookahead itself is used.
+ */
+static void
+resolveSimQuantum()
+{
+    const Tick lookahead = linkLookahead();
+
+    if (simQuantum != 0) {
+        if (simQuantum > lookahead) {
+            warn("Quantum %d exceeds the %d tick latency of link %s, "
+                 "cross-queue events may be delivered late.\n",
+                 simQuantum, lookahead, linkLookaheadLimiter());
+        }
+        return;
+    }
+
+    if (lookahead == MaxTick) {
+        fatal("Quantum for multi-eventq simulation not specified and no "
+              "link crossing event queues declared its latency");
+    }
+    if (lookahead == 0) {
+        fatal("Link %s crosses event queues with zero latency, "
+              "cannot derive a quantum", linkLookaheadLimiter());
+    }
+
+    simQuantum = lookahead;
+    inform("Using a quantum of %d ticks, limited by link %s.\n",
+           simQuantum, linkLookaheadLimiter());
+}
+
 /**
  * The main function for all subordinate threads (i.e., all threads
  * other than the main thread).  These threads start by waiting on
@@ -95,6 +161,16 @@ simulate(Tick num_cycles)
             threads.push_back(new std::thread(thread_loop, mainEventQueue[i]));
         }
 
+        if (numMainEventQueues > 1) {
+            resolveSimQuantum();
+
+            if (pinEventQueueThreads) {
+                pinThread(pthread_self(), 0);
+                for (uint32_t i = 1; i < numMainEventQueues; i++)
+                    pinThread(threads[i - 1]->native_handle(), i);
+            }
+        }
+
         threads_initialized = true;
         simulate_limit_event =
             new GlobalSimLoopExitEvent(mainEventQueue[0]->getCurTick(),
@@ -112,10 +188,6 @@ simulate(Tick num_cycles)
 
     GlobalSyncEvent *quantum_event = NULL;
     if (numMainEventQueues > 1) {
-        if (simQuantum == 0) {
-            fatal("Quantum for multi-eventq simulation not specified");
-        }
-
         quantum_event = new GlobalSyncEvent(curTick() + simQuantum, simQuantum,
                             EventBase::Progress_Event_Pri, 0);
 
@@ -32,3 +32,6 @@ class GlobalSimLoopExitEvent;
 
 GlobalSimLoopExitEvent *simulate(Tick num_cycles = MaxTick);
 extern GlobalSimLoopExitEvent *simulate_limit_event;
+
+//! Pin the thread servicing each main event queue to its own host core.
+extern bool pinEventQueueThreads;
@@ -48,13 +48,17 @@
 #include <fstream>
 #include <iostream>
 #include <list>
+#include <memory>
+#include <vector>
 
 #include "base/callback.hh"
+#include "base/free_list_pool.hh"
 #include "base/hostinfo.hh"
 #include "base/statistics.hh"
 #include "base/time.hh"
 #include "cpu/base.hh"
 #include "sim/global_event.hh"
+#include "sim/root.hh"
 
 using namespace std;
 
@@ -101,6 +105,17 @@ statFinalTick()
     return curTick();
 }
 
+const Info *
+resolve(const std::string &name)
+{
+    const auto &it = nameMap().find(name);
+    if (it != nameMap().cend()) {
+        return it->second;
+    } else {
+        return Root::root()->resolveStat(name);
+    }
+}
+
 SimTicksReset simTicksReset;
 
 struct Global
@@ -114,6 +129,8 @@ struct Global
     Stats::Value simInsts;
     Stats::Value simOps;
 
+    std::vector<std::unique_ptr<Stats::Value>> hostPoolHitRate;
+
     Global();
 };
 
@@ -193,6 +210,16 @@ Global::Global()
         .precision(0)
         ;
 
+    for (auto pool : FreeListPool::pools()) {
+        hostPoolHitRate.emplace_back(new Stats::Value());
+        hostPoolHitRate.back()->method(pool, &FreeListPool::hitRate)
+            .name(csprintf("host_%s_pool_hit_rate", pool->name()))
+            .desc(csprintf("Fraction of %s allocations served by a "
+                           "recycled block", pool->name()))
+            .precision(4)
+            ;
+    }
+
     simSeconds = simTicks / simFreq;
     hostInstRate = simInsts / hostSeconds;
     hostOpRate = simOps / hostSeconds;
@@ -41,11 +41,15 @@
 #ifndef __SIM_STAT_CONTROL_HH__
 #define __SIM_STAT_CONTROL_HH__
 
+#include <string>
+
 #include "base/types.hh"
 #include "sim/core.hh"
 
 namespace Stats {
 
+class Info;
+
 double statElapsedTime();
 
 Tick statElapsedTicks();
@@ -54,6 +58,12 @@ Tick statFinalTick();
 
 void initSimStats();
 
+/**
+ * Find a stat by name, first among the stats named globally and then in
+ * the stat groups of the SimObjects.
+ */
+const Info *resolve(const std::string &name);
+
 /**
  * Update the events after resuming from a checkpoint. When resuming from a
  * checkpoint, curTick will be updated, and any already scheduled events can
@@ -0,0 +1,167 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "sim/eventq_impl.hh"
+
+using namespace std;
+
+/*
+ * Event queue throughput benchmark using the classic "hold" model:
+ * a fixed population of events each reschedules itself a random
+ * distance into the future when serviced, which exercises insertion
+ * and removal of the head in equal measure. A second phase inserts
+ * the population in random order before draining the queue.
+ */
+
+class HoldEvent : public Event
+{
+  private:
+    EventQueue &eq;
+    mt19937_64 &rng;
+    uniform_int_distribution<Tick> &delay;
+
+  public:
+    HoldEvent(EventQueue &_eq, mt19937_64 &_rng,
+              uniform_int_distribution<Tick> &_delay)
+        : eq(_eq), rng(_rng), delay(_delay)
+    {}
+
+    void
+    process() override
+    {
+        eq.schedule(this, eq.getCurTick() + delay(rng));
+    }
+};
+
+class CountEvent : public Event
+{
+  public:
+    static uint64_t serviced;
+
+    CountEvent(Priority p) : Event(p) {}
+    void process() override { ++serviced; }
+};
+
+uint64_t CountEvent::serviced = 0;
+
+static double
+elapsed(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - start)
+        .count();
+}
+
+static void
+hold(EventQueueImpl impl, const char *impl_name, size_t population)
+{
+    eventQueueImpl = impl;
+    EventQueue eq("hold");
+    curEventQueue(&eq);
+
+    mt19937_64 rng(population);
+    // Spread the events so that most of them end up in their own bin,
+    // which is the worst case for the list implementation.
+    uniform_int_distribution<Tick> delay(1, population * 500);
+
+    vector<HoldEvent *> events;
+    for (size_t i = 0; i < population; ++i) {
+        events.push_back(new HoldEvent(eq, rng, delay));
+        eq.schedule(events.back(), delay(rng));
+    }
+
+    const uint64_t count = max<uint64_t>(20000, 16000000 / population);
+    auto start = chrono::steady_clock::now();
+    for (uint64_t i = 0; i < count; ++i)
+        eq.serviceOne();
+    double secs = elapsed(start);
+
+    cprintf("hold    %-8s %6d events: %12d events/s\n",
+            impl_name, population, uint64_t(count / secs));
+
+    for (auto event : events) {
+        eq.deschedule(event);
+        delete event;
+    }
+}
+
+static void
+fill(EventQueueImpl impl, const char *impl_name, size_t population)
+{
+    eventQueueImpl = impl;
+    EventQueue eq("fill");
+    curEventQueue(&eq);
+
+    mt19937_64 rng(population);
+    uniform_int_distribution<Tick> when(0, population * 500);
+    uniform_int_distribution<int> pri(-1, 1);
+
+    vector<CountEvent> events;
+    events.reserve(population);
+    for (size_t i = 0; i < population; ++i)
+        events.emplace_back(pri(rng));
+
+    const int rounds = max<int>(1, 131072 / population);
+    double insert_secs = 0, service_secs = 0;
+    for (int r = 0; r < rounds; ++r) {
+        const Tick base = eq.getCurTick();
+        auto start = chrono::steady_clock::now();
+        for (auto &event : events)
+            eq.schedule(&event, base + when(rng));
+        insert_secs += elapsed(start);
+
+        start = chrono::steady_clock::now();
+        while (!eq.empty())
+            eq.serviceOne();
+        service_secs += elapsed(start);
+    }
+
+    const double total = double(rounds) * population;
+    cprintf("fill    %-8s %6d events: %12d inserts/s %12d services/s\n",
+            impl_name, population, uint64_t(total / insert_secs),
+            uint64_t(total / service_secs));
+}
+
+int
+main()
+{
+    const size_t populations[] = { 16, 256, 4096, 32768 };
+
+    for (auto population : populations) {
+        hold(EventQueueImpl::List, "list", population);
+        hold(EventQueueImpl::Calendar, "calendar", population);
+    }
+
+    for (auto population : populations) {
+        fill(EventQueueImpl::List, "list", population);
+        fill(EventQueueImpl::Calendar, "calendar", population);
+    }
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "base/cprintf.hh"
+#include "base/debug.hh"
+#include "base/trace.hh"
+
+using namespace std;
+
+/*
+ * Cost of disabled trace statements in a binary with tracing. A toy
+ * CPU executes instructions with a few DPRINTFs each, like the fetch,
+ * decode and execute stages of the real CPU models do, using a flag
+ * that is compiled in and one that is left out of TRACE_FLAGS. Neither
+ * is enabled, so the difference between the two is the cost of the
+ * runtime flag checks that TRACE_FLAGS removes. A run without trace
+ * statements gives the upper bound.
+ */
+
+// Defined the way the generated debug/<Flag>.hh headers do, but with
+// both a compiled in and a compiled out flag whatever TRACE_FLAGS is.
+namespace Debug {
+
+SimpleFlag BenchTraced("BenchTraced", "Flag compiled into the binary");
+SimpleFlag BenchUntraced("BenchUntraced", "Flag left out of the binary");
+
+namespace Traced {
+constexpr bool BenchTraced = true;
+constexpr bool BenchUntraced = false;
+}
+
+} // namespace Debug
+
+enum TraceMode { NoTrace, CompiledIn, CompiledOut };
+
+#define BENCH_DPRINTF(mode, ...) do {                   \
+    if (mode == CompiledIn)                             \
+        DPRINTF(BenchTraced, __VA_ARGS__);              \
+    else if (mode == CompiledOut)                       \
+        DPRINTF(BenchUntraced, __VA_ARGS__);            \
+} while (0)
+
+static uint64_t add(uint64_t a, uint64_t b) { return a + b; }
+static uint64_t xorShift(uint64_t a, uint64_t b) { return a ^ (b << 1); }
+
+// Instructions are executed through function pointers the compiler
+// cannot see through, like the virtual execute() of real instructions,
+// so the flag checks cannot be hoisted out of the loop.
+static uint64_t (*volatile ops[2])(uint64_t, uint64_t) = { add, xorShift };
+
+class ToyCPU
+{
+  private:
+    const string _name;
+    uint64_t regs[16];
+    uint64_t pc;
+
+  public:
+    ToyCPU() : _name("cpu"), pc(0)
+    {
+        for (int i = 0; i < 16; ++i)
+            regs[i] = i * 0x9e3779b97f4a7c15ULL;
+    }
+
+    const string &name() const { return _name; }
+
+    uint64_t result() const { return regs[0] ^ pc; }
+
+    template <TraceMode mode>
+    void
+    run(uint64_t count)
+    {
+        for (uint64_t i = 0; i < count; ++i) {
+            const uint32_t inst = uint32_t(regs[pc & 15] >> 7) ^ pc;
+            BENCH_DPRINTF(mode, "Fetched %#x from pc %#x\n", inst, pc);
+
+            const unsigned dest = inst & 15;
+            const unsigned src1 = (inst >> 4) & 15;
+            const unsigned src2 = (inst >> 8) & 15;
+            BENCH_DPRINTF(mode, "Decoded r%d = r%d op r%d\n",
+                          dest, src1, src2);
+
+            const uint64_t value = ops[(inst >> 12) & 1](regs[src1],
+                                                         regs[src2]);
+            BENCH_DPRINTF(mode, "Executed %s: r%d <- %#x\n",
+                          (inst & 0x1000) ? "add" : "xor", dest, value);
+
+            regs[dest] = value;
+            pc += 4;
+        }
+    }
+};
+
+/** Best of a few runs, in millions of instructions per second */
+template <TraceMode mode>
+static void
+measure(const char *mode_name, uint64_t count)
+{
+    double best = 0;
+    uint64_t result = 0;
+    for (int i = 0; i < 5; ++i) {
+        ToyCPU cpu;
+        auto start = chrono::steady_clock::now();
+        cpu.run<mode>(count);
+        const double secs =
+            chrono::duration<double>(chrono::steady_clock::now() - start)
+            .count();
+        best = max(best, count / secs / 1e6);
+        result = cpu.result();
+    }
+
+    cprintf("%-12s %8.2f MIPS (result %#x)\n", mode_name, best, result);
+}
+
+int
+main()
+{
+    const uint64_t count = 50000000;
+
+    measure<NoTrace>("no trace", count);
+    measure<CompiledIn>("compiled in", count);
+    measure<CompiledOut>("compiled out", count);
+
+    return 0;
+}
@@ -27,6 +27,8 @@
 
 import os
 import argparse
+import sys
+from multiprocessing import Process
 
 import m5
 from m5.objects import *
@@ -114,6 +116,14 @@ parser.add_argument('--cpu', choices = valid_cpu.keys(),
                     default = 'TimingSimpleCPU')
 parser.add_argument('--mem', choices = valid_mem.keys(),
                     default = 'SimpleMemory')
+parser.add_argument('--skip-idle-stage-ticks', action = 'store_true',
+                    help = "Don't tick the idle stages of DerivO3CPU")
+parser.add_argument('--bb-cache', action = 'store_true',
+                    help = "Execute pre-decoded basic blocks on "
+                           "AtomicSimpleCPU")
+parser.add_argument('--incremental-checkpoint', action = 'store_true',
+                    help = "Restore from an incremental checkpoint "
+                           "written by a child process")
 
 args = parser.parse_args()
 
@@ -129,6 +139,10 @@ if args.cpu != "AtomicSimpleCPU":
 system.mem_ranges = [AddrRange('512MB')]
 
 system.cpu = valid_cpu[args.cpu]()
+if args.skip_idle_stage_ticks:
+    system.cpu.skipIdleStageTicks = True
+if args.bb_cache:
+    system.cpu.bb_cache = True
 
 if args.cpu == "AtomicSimpleCPU":
     system.membus = SystemXBar()
@@ -164,7 +178,42 @@ system.cpu.workload = process
 system.cpu.createThreads()
 
 root = Root(full_system = False, system = system)
-m5.instantiate()
+
+# Ticks between the checkpoints written by writeCheckpoints()
+checkpoint_interval = 100000000
+
+def writeCheckpoints(base_dir, incremental_dir):
+    """
+    Write a full checkpoint and an incremental one based on it. This
+    runs in a child process, and only the output of the parent, which
+    restores the incremental checkpoint, is checked.
+    """
+    sys.stdout.flush()
+    os.dup2(os.open(os.devnull, os.O_WRONLY), sys.stdout.fileno())
+
+    system.checkpoint_chain_length = 1
+    m5.instantiate()
+    for cpt_dir in (base_dir, incremental_dir):
+        exit_event = m5.simulate(checkpoint_interval)
+        if exit_event.getCause() != 'simulate() limit reached':
+            sys.exit(1)
+        m5.checkpoint(cpt_dir)
+    sys.exit(0)
+
+if args.incremental_checkpoint:
+    base_dir = os.path.join(m5.options.outdir, 'base.cpt')
+    incremental_dir = os.path.join(m5.options.outdir, 'incremental.cpt')
+    p = Process(target = writeCheckpoints,
+                args = (base_dir, incremental_dir))
+    p.start()
+    p.join()
+    if p.exitcode != 0:
+        exit(1)
+    # The chain length only limits the checkpoints written, restoring
+    # must work with the default
+    m5.instantiate(incremental_dir)
+else:
+    m5.instantiate()
 
 exit_event = m5.simulate()
 
@@ -78,3 +78,41 @@ for isa in valid_isas:
                   valid_isas=(isa.upper(),),
                   fixtures=[workload_binary]
             )
+
+        # The O3 CPU deschedules itself on the cold instruction cache
+        # misses, so this checks that it still wakes up when it skips
+        # the ticks of its idle stages.
+        gem5_verify_config(
+              name='cpu_test_DerivO3CPU_skip_idle_stage_ticks_{}'.format(
+                  workload),
+              verifiers=verifiers,
+              config=joinpath(getcwd(), 'run.py'),
+              config_args=['--cpu=DerivO3CPU', '--skip-idle-stage-ticks',
+                           '--mem=DDR3_1600_8x8', binary],
+              valid_isas=(isa.upper(),),
+              fixtures=[workload_binary]
+        )
+
+        # Executing out of the pre-decoded basic blocks has to give the
+        # same output as fetching and decoding each instruction.
+        gem5_verify_config(
+              name='cpu_test_AtomicSimpleCPU_bb_cache_{}'.format(workload),
+              verifiers=verifiers,
+              config=joinpath(getcwd(), 'run.py'),
+              config_args=['--cpu=AtomicSimpleCPU', '--bb-cache', binary],
+              valid_isas=(isa.upper(),),
+              fixtures=[workload_binary]
+        )
+
+        # Restoring a checkpoint written on top of another one has to
+        # give the same output as running from the start.
+        gem5_verify_config(
+              name='cpu_test_AtomicSimpleCPU_incremental_checkpoint_{}'
+                  .format(workload),
+              verifiers=verifiers,
+              config=joinpath(getcwd(), 'run.py'),
+              config_args=['--cpu=AtomicSimpleCPU',
+                           '--incremental-checkpoint', binary],
+              valid_isas=(isa.upper(),),
+              fixtures=[workload_binary]
+        )
@@ -86,3 +86,21 @@ for basename_noext, args in null_tests:
         valid_isas=('NULL',),
         valid_hosts=constants.supported_hosts,
     )
+
+# The routers of a partitioned garnet network run on their own event
+# queues, the simulated network must behave as if they all ran on one.
+garnet_args = ['--network=garnet2.0', '--topology=Mesh_XY', '--mesh-rows=2',
+               '--num-cpus=4', '--num-dirs=4', '--routing-algorithm=1',
+               '--sim-cycles', '100000', '--injectionrate', '0.1']
+garnet_config = joinpath(config.base_dir, 'configs', 'example',
+                         'garnet_synth_traffic.py')
+
+gem5_verify_config(
+    name='garnet_synth_traffic_partitions',
+    fixtures=(),
+    verifiers=(verifier.MatchStatsOfRun(garnet_config, garnet_args),),
+    config=garnet_config,
+    config_args=garnet_args + ['--garnet-partitions', '2'],
+    valid_isas=('NULL',),
+    valid_hosts=constants.supported_hosts,
+)
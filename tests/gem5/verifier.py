@@ -31,7 +31,7 @@ import re
 
 from testlib import test_util as test
 from testlib.configuration import constants
-from testlib.helper import joinpath, diff_out_file
+from testlib.helper import joinpath, diff_out_file, log_call
 
 class Verifier(object):
     def __init__(self, fixtures=tuple()):
@@ -144,6 +144,51 @@ class MatchStats(DerivedGoldStandard):
     _file = constants.gem5_simulation_stats
     _default_ignore_regex = []
 
+class MatchStatsOfRun(Verifier):
+    '''
+    Runs gem5 a second time, with another config or config arguments, and
+    passes if both runs produce the same stats. The host stats, which
+    measure the simulator rather than the simulated system, are ignored.
+    '''
+    _default_ignore_regex = [
+            re.compile('^host_'),
+        ]
+
+    def __init__(self, config, config_args, ignore_regex=None):
+        '''
+        :param config: The config to give the reference run of gem5.
+        :param config_args: A list of arguments to pass to that config.
+
+        :param ignore_regex: A string, compiled regex, or iterable containing
+        either which will be ignored in both stats files, in addition to
+        the host stats.
+        '''
+        super(MatchStatsOfRun, self).__init__()
+        self.config = config
+        self.config_args = config_args
+        self.ignore_regex = list(self._default_ignore_regex)
+        if ignore_regex is not None:
+            self.ignore_regex.extend(_iterable_regex(ignore_regex))
+
+    def test(self, params):
+        fixtures = params.fixtures
+        tempdir = fixtures[constants.tempdir_fixture_name].path
+        gem5 = fixtures[constants.gem5_binary_fixture_name].path
+
+        refdir = joinpath(tempdir, 'reference')
+        command = [gem5, '-d', refdir, '-re', self.config]
+        command.extend(self.config_args)
+        log_call(params.log, command)
+
+        diff = diff_out_file(joinpath(refdir, constants.gem5_simulation_stats),
+                             joinpath(tempdir,
+                                      constants.gem5_simulation_stats),
+                             ignore_regexes=self.ignore_regex,
+                             logger=params.log)
+        if diff is not None:
+            test.fail('Stats did not match the reference run:\n%s\n'
+                      'See %s for full results' % (diff, tempdir))
+
 class MatchConfigINI(DerivedGoldStandard):
     _file = constants.gem5_simulation_config_ini
     _default_ignore_regex = (
@@ -0,0 +1,470 @@
+#!/usr/bin/env python
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script turns the binary debug output of gem5 (--debug-binary)
+# into the text it would have printed without that option. The format
+# strings are interpreted the way ccprintf does in src/base/cprintf.cc
+# and src/base/cprintf_formats.hh, quirks included, so the two outputs
+# can be diffed.
+
+from __future__ import print_function
+
+import argparse
+import gzip
+import struct
+import sys
+
+MAGIC = b'gem5trc\0'
+VERSION = 1
+
+class Format(object):
+    def __init__(self):
+        self.alternate_form = False
+        self.flush_left = False
+        self.print_sign = False
+        self.blank_space = False
+        self.fill_zero = False
+        self.uppercase = False
+        self.base = 'dec'
+        self.format = None
+        self.float_format = 'best'
+        self.precision = -1
+        self.width = 0
+        self.get_precision = False
+        self.get_width = False
+
+def pad(text, width, fill, left):
+    if width > len(text):
+        padding = fill * (width - len(text))
+        return text + padding if left else padding + text
+    return text
+
+def float_str(value, precision, field='best', uppercase=False):
+    conv = { 'best' : 'g', 'fixed' : 'f', 'scientific' : 'e' }[field]
+    if uppercase:
+        conv = conv.upper()
+    return '%.*{}'.format(conv) % (precision, value)
+
+class Printer(object):
+    """Port of cp::Print, writing to a list of strings"""
+
+    def __init__(self, fmt):
+        self.out = []
+        self.format = fmt
+        self.ptr = 0
+        self.cont = False
+        self.precision = 6
+        self.fmt = Format()
+
+    def char(self, i):
+        return self.format[i] if i < len(self.format) else '\0'
+
+    def text(self):
+        """Copy plain text up to the next format specification"""
+        fmt = self.format
+        while self.ptr < len(fmt):
+            c = fmt[self.ptr]
+            if c == '%':
+                return True
+            elif c == '\n':
+                self.out.append('\n')
+                self.ptr += 1
+            elif c == '\r':
+                self.ptr += 1
+                if self.char(self.ptr) != '\n':
+                    self.out.append('\n')
+            else:
+                end = self.ptr
+                while end < len(fmt) and fmt[end] not in '%\n\r':
+                    end += 1
+                self.out.append(fmt[self.ptr:end])
+                self.ptr = end
+        return False
+
+    def process(self):
+        self.fmt = Format()
+        while self.text():
+            if self.char(self.ptr + 1) != '%':
+                self.process_flag()
+                return
+            self.out.append('%')
+            self.ptr += 2
+
+    def process_flag(self):
+        fmt = self.fmt
+        done = False
+        end_number = False
+        have_precision = False
+        number = 0
+
+        while not done:
+            self.ptr += 1
+            c = self.char(self.ptr)
+            if '0' <= c <= '9':
+                if end_number:
+                    continue
+            elif number > 0:
+                end_number = True
+
+            if c == 's':
+                fmt.format = 'string'
+                done = True
+            elif c == 'c':
+                fmt.format = 'character'
+                done = True
+            elif c == 'l':
+                continue
+            elif c == 'p':
+                fmt.format = 'integer'
+                fmt.base = 'hex'
+                fmt.alternate_form = True
+                done = True
+            elif c in 'xX':
+                fmt.uppercase = fmt.uppercase or c == 'X'
+                fmt.base = 'hex'
+                fmt.format = 'integer'
+                done = True
+            elif c == 'o':
+                fmt.base = 'oct'
+                fmt.format = 'integer'
+                done = True
+            elif c in 'diu':
+                fmt.format = 'integer'
+                done = True
+            elif c in 'gG':
+                fmt.uppercase = fmt.uppercase or c == 'G'
+                fmt.format = 'floating'
+                fmt.float_format = 'best'
+                done = True
+            elif c in 'eE':
+                fmt.uppercase = fmt.uppercase or c == 'E'
+                fmt.format = 'floating'
+                fmt.float_format = 'scientific'
+                done = True
+            elif c == 'f':
+                fmt.format = 'floating'
+                fmt.float_format = 'fixed'
+                done = True
+            elif c == 'n':
+                self.out.append("we don't do %n!!!\n")
+                done = True
+            elif c == '#':
+                fmt.alternate_form = True
+            elif c == '-':
+                fmt.flush_left = True
+            elif c == '+':
+                fmt.print_sign = True
+            elif c == ' ':
+                fmt.blank_space = True
+            elif c == '.':
+                fmt.width = number
+                fmt.precision = 0
+                have_precision = True
+                number = 0
+                end_number = False
+            elif c == '0' and number == 0:
+                fmt.fill_zero = True
+            elif '0' <= c <= '9':
+                number = number * 10 + int(c)
+            elif c == '*':
+                if have_precision:
+                    fmt.get_precision = True
+                else:
+                    fmt.get_width = True
+            else:
+                done = True
+
+            if end_number:
+                if have_precision:
+                    fmt.precision = number
+                else:
+                    fmt.width = number
+                end_number = False
+                number = 0
+
+            if done:
+                if fmt.format == 'integer' and have_precision:
+                    fmt.width = fmt.precision
+                    fmt.fill_zero = True
+                elif fmt.format == 'floating' and not have_precision and \
+                        fmt.fill_zero:
+                    fmt.precision = fmt.width
+
+        self.ptr += 1
+
+    def plain(self, arg, precision):
+        """What operator<< prints for an argument with default flags"""
+        tag, value, size = arg
+        if tag == 'c':
+            return chr(value & 0xff)
+        elif tag == 'f':
+            return float_str(value, precision)
+        elif tag == 's':
+            return value
+        return str(value)
+
+    def format_integer(self, arg):
+        fmt = self.fmt
+        tag, value, size = arg
+        if tag == 'c':
+            tag, size = 'i', 4
+        elif tag == 'b':
+            tag, size = 'u', 1
+
+        prefix = ''
+        width = fmt.width
+        if fmt.alternate_form and fmt.fill_zero:
+            prefix = { 'hex' : '0x', 'oct' : '0', 'dec' : '' }[fmt.base]
+            width -= len(prefix)
+
+        if tag in 'iu':
+            if fmt.base == 'dec':
+                text = str(value)
+                if fmt.print_sign and tag == 'i' and value >= 0:
+                    text = '+' + text
+            else:
+                value &= (1 << (8 * size)) - 1
+                text = '%x' % value if fmt.base == 'hex' else '%o' % value
+                if fmt.alternate_form and not fmt.fill_zero and value:
+                    text = ('0x' if fmt.base == 'hex' else '0') + text
+                if fmt.uppercase:
+                    text = text.upper()
+        elif tag == 'f':
+            text = float_str(value, self.precision, 'best', fmt.uppercase)
+            if fmt.print_sign and not text.startswith('-'):
+                text = '+' + text
+        else:
+            text = value
+
+        fill = '0' if fmt.fill_zero else ' '
+        left = fmt.flush_left and not fmt.fill_zero
+        self.out.append(prefix + pad(text, width, fill, left))
+
+    def format_float(self, arg):
+        fmt = self.fmt
+        tag, value, size = arg
+        if tag != 'f':
+            self.out.append('<bad arg type for float format>')
+            return
+
+        field = 'best'
+        uppercase = False
+        if fmt.float_format == 'scientific':
+            if fmt.precision != -1:
+                if fmt.precision == 0:
+                    fmt.precision = 1
+                else:
+                    field = 'scientific'
+                self.precision = fmt.precision
+            uppercase = fmt.uppercase
+        elif fmt.float_format == 'fixed':
+            if fmt.precision != -1:
+                field = 'fixed'
+                self.precision = fmt.precision
+        elif fmt.precision != -1:
+            self.precision = fmt.precision
+
+        text = float_str(value, self.precision, field, uppercase)
+        fill = '0' if fmt.fill_zero else ' '
+        self.out.append(pad(text, fmt.width, fill, False))
+
+    def format_char(self, arg):
+        tag, value, size = arg
+        if tag == 'c' or (tag in 'iu' and size > 1):
+            self.out.append(chr(value & 0xff))
+        else:
+            self.out.append('<bad arg type for char format>')
+
+    def format_string(self, arg):
+        fmt = self.fmt
+        text = self.plain(arg, 6)
+        if fmt.width > len(text):
+            self.out.append(pad(text, fmt.width, ' ', fmt.flush_left))
+        else:
+            self.out.append(self.plain(arg, self.precision))
+
+    def add_arg(self, arg):
+        if not self.cont:
+            self.process()
+
+        fmt = self.fmt
+        tag, value, size = arg
+        is_int = tag == 'i' and size == 4
+        if fmt.get_width:
+            fmt.get_width = False
+            self.cont = True
+            fmt.width = value if is_int else 0
+            return
+        if fmt.get_precision:
+            fmt.get_precision = False
+            self.cont = True
+            fmt.precision = value if is_int else 0
+            return
+
+        if fmt.format == 'character':
+            self.format_char(arg)
+        elif fmt.format == 'integer':
+            self.format_integer(arg)
+        elif fmt.format == 'floating':
+            self.format_float(arg)
+        elif fmt.format == 'string':
+            self.format_string(arg)
+        else:
+            self.out.append('<bad format>')
+
+    def end_args(self):
+        while self.text():
+            if self.char(self.ptr + 1) != '%':
+                self.out.append('<extra arg>')
+            self.out.append('%')
+            self.ptr += 2
+        return ''.join(self.out)
+
+class Reader(object):
+    def __init__(self, stream):
+        self.stream = stream
+        magic = self.read(len(MAGIC))
+        if magic != MAGIC:
+            raise ValueError('not a gem5 binary trace')
+        for self.order in '<>':
+            if self.unpack('I', self.read(4)) == VERSION:
+                break
+            self.stream.seek(len(MAGIC))
+        else:
+            raise ValueError('unsupported binary trace version')
+
+    def read(self, size):
+        data = self.stream.read(size)
+        if len(data) != size:
+            raise EOFError()
+        return data
+
+    def unpack(self, fmt, data):
+        return struct.unpack(self.order + fmt, data)[0]
+
+    def get(self, fmt):
+        return self.unpack(fmt, self.read(struct.calcsize('=' + fmt)))
+
+    def string(self):
+        return self.read(self.get('I')).decode('latin-1')
+
+    def args(self, data):
+        args = []
+        pos = 0
+        while pos < len(data):
+            tag = data[pos:pos + 1].decode('latin-1')
+            pos += 1
+            if tag in 'iu':
+                size = ord(data[pos:pos + 1])
+                value = self.unpack('q' if tag == 'i' else 'Q',
+                                    data[pos + 1:pos + 9])
+                args.append((tag, value, size))
+                pos += 9
+            elif tag == 'c':
+                args.append((tag, self.unpack('q', data[pos:pos + 8]), 1))
+                pos += 8
+            elif tag == 'b':
+                args.append(('b', int(ord(data[pos:pos + 1]) != 0), 1))
+                pos += 1
+            elif tag == 'f':
+                args.append((tag, self.unpack('d', data[pos:pos + 8]), 8))
+                pos += 8
+            elif tag == 's':
+                size = self.unpack('I', data[pos:pos + 4])
+                value = data[pos + 4:pos + 4 + size].decode('latin-1')
+                args.append((tag, value, size))
+                pos += 4 + size
+            else:
+                raise ValueError('bad argument type %r' % tag)
+        return args
+
+def decode(reader, out):
+    strings = []
+    while True:
+        try:
+            kind = reader.read(1)
+        except EOFError:
+            return
+
+        try:
+            if kind == b'S':
+                ident = reader.get('I')
+                assert ident == len(strings)
+                strings.append(reader.string())
+                continue
+
+            opts = reader.get('B')
+            when = reader.get('Q')
+            name = strings[reader.get('I')]
+            flag = strings[reader.get('I')]
+            if kind == b'M':
+                printer = Printer(strings[reader.get('I')])
+                for arg in reader.args(reader.read(reader.get('I'))):
+                    printer.add_arg(arg)
+                message = printer.end_args()
+            elif kind == b'T':
+                message = reader.string()
+            else:
+                raise ValueError('bad record type %r' % kind)
+        except EOFError:
+            print('warning: trace ends with a partial record',
+                  file=sys.stderr)
+            return
+
+        line = ''
+        if opts & 0x1:
+            line += '%7d: ' % when
+        if opts & 0x2:
+            line += flag + ': '
+        if name:
+            line += name + ': '
+        out.write((line + message).encode('latin-1'))
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Decode the binary debug output of gem5')
+    parser.add_argument('input', help='binary trace, may be gzipped')
+    parser.add_argument('output', nargs='?', default='-',
+                        help='text output [Default: stdout]')
+    args = parser.parse_args()
+
+    if args.input.endswith('.gz'):
+        stream = gzip.open(args.input, 'rb')
+    else:
+        stream = open(args.input, 'rb')
+
+    # The simulator writes out bytes, write them back unchanged
+    if args.output == '-':
+        out = getattr(sys.stdout, 'buffer', sys.stdout)
+    else:
+        out = open(args.output, 'wb')
+
+    try:
+        decode(Reader(stream), out)
+    except ValueError as e:
+        sys.exit('%s: %s' % (args.input, e))
+
+if __name__ == '__main__':
+    main()
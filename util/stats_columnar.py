@@ -0,0 +1,174 @@
+#!/usr/bin/env python
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Reader for the columnar stat files written with a col:// stat visitor
+# (see src/base/stats/columnar.hh). It can be used as a module:
+#
+#   import stats_columnar
+#   frame = stats_columnar.read_frame('m5out/stats.col.gz')
+#   frame['system.cpu.numCycles']
+#
+# or run to convert a file to CSV, one row per dump.
+
+from __future__ import print_function
+
+import argparse
+import gzip
+import struct
+import sys
+
+MAGIC = b'gem5col\0'
+VERSION = 1
+
+class Schema(object):
+    def __init__(self, ident, names, descs):
+        self.id = ident
+        self.names = names
+        self.descs = descs
+
+def _open(path):
+    if path.endswith('.gz'):
+        return gzip.open(path, 'rb')
+    return open(path, 'rb')
+
+def _read(stream, size):
+    data = stream.read(size)
+    if len(data) != size:
+        raise EOFError()
+    return data
+
+def dumps(path):
+    """Yield a (schema, tick, values) tuple for each dump in a file
+
+    values is the raw bytes of the dump's doubles, in the file's byte
+    order, which is available as the order attribute of the schema.
+    """
+
+    stream = _open(path)
+    if _read(stream, len(MAGIC)) != MAGIC:
+        raise ValueError('%s is not a columnar stat file' % path)
+
+    version = _read(stream, 4)
+    for order in '<>':
+        if struct.unpack(order + 'I', version)[0] == VERSION:
+            break
+    else:
+        raise ValueError('%s has an unsupported version' % path)
+
+    def get(fmt):
+        fmt = order + fmt
+        return struct.unpack(fmt, _read(stream, struct.calcsize(fmt)))
+
+    def string():
+        size, = get('I')
+        return _read(stream, size).decode('utf-8', 'replace')
+
+    schemas = {}
+    while True:
+        kind = stream.read(1)
+        if not kind:
+            return
+
+        try:
+            if kind == b'S':
+                ident, columns = get('II')
+                names = []
+                descs = []
+                for i in range(columns):
+                    names.append(string())
+                    descs.append(string())
+                schema = Schema(ident, names, descs)
+                schema.order = order
+                schemas[ident] = schema
+            elif kind == b'D':
+                ident, tick = get('IQ')
+                schema = schemas[ident]
+                values = _read(stream, 8 * len(schema.names))
+                yield schema, tick, values
+            else:
+                raise ValueError('%s: bad record type %r' % (path, kind))
+        except EOFError:
+            print('warning: %s ends with a partial dump' % path,
+                  file=sys.stderr)
+            return
+
+def read_frames(path):
+    """Read a file into one pandas DataFrame per schema
+
+    The frames are indexed by tick and have a column per stat, most
+    files only have a single schema.
+    """
+
+    import numpy
+    import pandas
+
+    rows = {}
+    for schema, tick, values in dumps(path):
+        rows.setdefault(schema.id, (schema, [], []))
+        rows[schema.id][1].append(tick)
+        rows[schema.id][2].append(values)
+
+    frames = []
+    for ident in sorted(rows):
+        schema, ticks, values = rows[ident]
+        data = numpy.frombuffer(b''.join(values),
+                                dtype=numpy.dtype(schema.order + 'f8'))
+        data = data.reshape(len(ticks), len(schema.names))
+        frames.append(pandas.DataFrame(
+            data, index=pandas.Index(ticks, name='tick'),
+            columns=schema.names))
+    return frames
+
+def read_frame(path):
+    """Read a file into a single pandas DataFrame indexed by tick
+
+    Stats missing from a dump, e.g. in dumps of parts of the system,
+    are NaN.
+    """
+
+    import pandas
+
+    frames = read_frames(path)
+    if len(frames) == 1:
+        return frames[0]
+    return pandas.concat(frames, sort=False).sort_index(kind='mergesort')
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Convert a columnar stat file to CSV')
+    parser.add_argument('input', help='columnar stat file, may be gzipped')
+    parser.add_argument('output', nargs='?', default='-',
+                        help='CSV output [Default: stdout]')
+    args = parser.parse_args()
+
+    try:
+        frame = read_frame(args.input)
+    except ValueError as e:
+        sys.exit(str(e))
+
+    frame.to_csv(sys.stdout if args.output == '-' else args.output)
+
+if __name__ == '__main__':
+    main()